@@ -26,6 +26,7 @@
 #include <TH3.h>
 #include <TLorentzVector.h>
 #include <TNtuple.h>
+#include <TROOT.h>
 #include <TStyle.h>
 #include <TSystem.h>
 #include <TTree.h>
@@ -37,6 +38,7 @@
 #include <iostream>
 #include <map>      // for _Rb_tree_const_iterator
 #include <string>   // for string
+#include <thread>
 #include <utility>  // for pair
 #include <vector>   // for vector
 
@@ -413,68 +415,74 @@ int CaloCalibEmc_Pi0::End(PHCompositeNode *topNode)
 }
 
 //______________________________________________________________________________..
-void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intree, const std::string &incorrFile)
+void CaloCalibEmc_Pi0::load_corrections(const std::string &incorrFile, CorrArray &myaggcorr, bool printMiddle)
 {
-  // KINEMATIC CUTS ON PI0's ARE LISTED BELOW IN ONE SECTION OF COMMENTS
-  //
-  //  search for  "CUTS FOLLOW HERE"
-  //
-  //  they are centrality dependent (centrality = nclusters > minpt)  so they can only
-  //  defined after loading up this values from the ntuples
-  //  so they can't be moved here
-  //
-
-  //  std::arrays have their indices backward, this is the old float myaggcorr[96][260];
-  std::array<std::array<float, 260>, 96> myaggcorr{};
   std::for_each(myaggcorr.begin(), myaggcorr.end(), [](auto &row)
                 { row.fill(1.); });
 
   std::cout << "running w/ corr file? : " << incorrFile << std::endl;
 
-  if (!incorrFile.empty())
+  if (incorrFile.empty())
   {
-    TFile *infileNt = new TFile(incorrFile.c_str());
-    std::cout << "loaded incorrFile " << infileNt << std::endl;
+    return;
+  }
 
-    float myieta;
-    float myiphi;
-    float mycorr;
-    float myaggcv;
+  TFile *infileNt = new TFile(incorrFile.c_str());
+  std::cout << "loaded incorrFile " << infileNt << std::endl;
 
-    TNtuple *innt_corrVals = (TNtuple *) infileNt->Get("nt_corrVals");
+  float myieta;
+  float myiphi;
+  float mycorr;
+  float myaggcv;
 
-    innt_corrVals->SetBranchAddress("tower_eta", &myieta);
-    innt_corrVals->SetBranchAddress("tower_phi", &myiphi);
-    innt_corrVals->SetBranchAddress("corr_val", &mycorr);
-    innt_corrVals->SetBranchAddress("agg_cv", &myaggcv);
+  TNtuple *innt_corrVals = (TNtuple *) infileNt->Get("nt_corrVals");
 
-    int ntCorrs = innt_corrVals->GetEntries();
+  innt_corrVals->SetBranchAddress("tower_eta", &myieta);
+  innt_corrVals->SetBranchAddress("tower_phi", &myiphi);
+  innt_corrVals->SetBranchAddress("corr_val", &mycorr);
+  innt_corrVals->SetBranchAddress("agg_cv", &myaggcv);
 
-    for (int ij = 0; ij < ntCorrs; ij++)
+  int ntCorrs = innt_corrVals->GetEntries();
+
+  for (int ij = 0; ij < ntCorrs; ij++)
+  {
+    innt_corrVals->GetEntry(ij);
+    int ci = (int) myieta;
+    int cj = (int) myiphi;
+    myaggcorr.at(ci).at(cj) = myaggcv;
+    if (ij > ntCorrs - 2 || (printMiddle && ij == ntCorrs / 2))
     {
-      innt_corrVals->GetEntry(ij);
-      int ci = (int) myieta;
-      int cj = (int) myiphi;
-      myaggcorr.at(ci).at(cj) = myaggcv;
-      if (ij > ntCorrs - 2 || ij == ntCorrs / 2)
-      {
-        std::cout << "loaded corrs eta,phi,aggcv " << myieta
-                  << " " << myiphi << " " << myaggcv << std::endl;
-      }
+      std::cout << "loaded corrs eta,phi,aggcv " << myieta
+                << " " << myiphi << " " << myaggcv << std::endl;
     }
-
-    infileNt->Close();
-    delete infileNt;
   }
 
-  std::cout << "in loop" << std::endl;
+  infileNt->Close();
+  delete infileNt;
+}
 
+//______________________________________________________________________________..
+TTree *CaloCalibEmc_Pi0::get_tree(const std::string &filename, TTree *intree)
+{
   TTree *t1 = intree;
   if (!intree)
   {
     TFile *f = new TFile(filename.c_str());
     t1 = (TTree *) f->Get("_eventTree");
   }
+  return t1;
+}
+
+//______________________________________________________________________________..
+void CaloCalibEmc_Pi0::load_cluster_cache(int nevts, const std::string &filename, TTree *intree)
+{
+  // the clusters are read once, later passes over the same input reuse them
+  if (!m_cache.first.empty() && m_cache.nevts == nevts && m_cache.tree == intree && m_cache.filename == filename)
+  {
+    return;
+  }
+
+  TTree *t1 = get_tree(filename, intree);
 
   // Set Branches
   //  t1->SetBranchAddress("_eventNumber", &_eventNumber);
@@ -487,10 +495,6 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
   t1->SetBranchAddress("_maxTowerEtas", _maxTowerEtas);
   t1->SetBranchAddress("_maxTowerPhis", _maxTowerPhis);
 
-  // pre-loop to save all the clusters LorentzVector
-
-  TLorentzVector *savClusLV[10000];
-
   //  int nEntries = (int) t1->GetEntriesFast();
   int nEntries = (int) t1->GetEntries();
   int nevts2 = nevts;
@@ -500,361 +504,402 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
     nevts2 = nEntries;
   }
 
-  // keeping track of discarded clusters for v7
-  int discarded_clusters = 0;
+  m_cache = ClusterCache();
+  m_cache.filename = filename;
+  m_cache.tree = intree;
+  m_cache.nevts = nevts;
+  m_cache.first.reserve(nevts2 + 1);
+  m_cache.first.push_back(0);
 
   for (int i = 0; i < nevts2; i++)
   {
     // load the ith instance of the TTree
     t1->GetEntry(i);
-
-    if ((i % 10 == 0 && i < 200) || (i % 100 == 0 && i < 1000) || (i % 1000 == 0 && i < 37003) || i % 10000 == 0)
+    for (int j = 0; j < _nClusters; j++)
     {
-      std::cout << "evt no " << i << std::endl;
+      m_cache.pt.push_back(_clusterPts[j]);
+      m_cache.eta.push_back(_clusterEtas[j]);
+      m_cache.phi.push_back(_clusterPhis[j]);
+      m_cache.e.push_back(_clusterEnergies[j]);
+      m_cache.maxTowerEta.push_back(_maxTowerEtas[j]);
+      m_cache.maxTowerPhi.push_back(_maxTowerPhis[j]);
     }
-    // calibration correction will be applied here
+    m_cache.first.push_back(m_cache.pt.size());
+  }
 
-    int nClusters = _nClusters;
+  std::cout << "cached " << m_cache.pt.size() << " clusters from " << nevts2 << " events" << std::endl;
+}
 
-    // see below this is like centrality cut, but currently need central events
-    // as well as peripheral to maximize statistical power
-    if (nClusters > 1000)
-    {
-      discarded_clusters += 1;
-      continue;
-    }
+//______________________________________________________________________________..
+bool CaloCalibEmc_Pi0::select_pairs(unsigned int ievt, const CorrArray &myaggcorr, PairMode mode, std::vector<PairRecord> &pairs) const
+{
+  // KINEMATIC CUTS ON PI0's ARE LISTED BELOW IN ONE SECTION OF COMMENTS
+  //
+  //  search for  "CUTS FOLLOW HERE"
+  //
+  //  they are centrality dependent (centrality = nclusters > minpt)  so they can only
+  //  defined after loading up this values from the ntuples
+  //  so they can't be moved here
+  //
 
-    float pt1cut = 0, pt2cut = 0;
+  const unsigned int first = m_cache.first[ievt];
+  int nClusters = m_cache.first[ievt + 1] - first;
 
-    for (int j = 0; j < nClusters; j++)
-    {
-      // float px, py, pz;
-      float pt, eta, phi, E, aggcv;
-      pt = _clusterPts[j];
-      eta = _clusterEtas[j];
-      phi = _clusterPhis[j];
-      E = _clusterEnergies[j];
-      // px  =  pt * cos(phi);
-      // py  =  pt * sin(phi);
-      // pz  =  pt * sinh(eta);
-      // pt *= myaggcorr[
-      aggcv = myaggcorr.at(_maxTowerEtas[j]).at(_maxTowerPhis[j]);
-
-      // std::cout << "aggcv applied: " << aggcv << std::endl;
-
-      // eta slice shifts test
-      //   int ket = _maxTowerEtas[j]/4;
-      //   int jket = ket %4;
-      //  if ((ket/4)%2==1)
-      //	jket = 4-ket%4;
-      //   int pjj = _maxTowerEtas[j]%4 - 1;
-      //       aggcv *= 0.86+jket*0.11 + 0.02*pjj;
-
-      pt *= aggcv;
-      E *= aggcv;
-
-      savClusLV[j] = new TLorentzVector();
-      savClusLV[j]->SetPtEtaPhiE(pt, eta, phi, E);
-    }
+  // see below this is like centrality cut, but currently need central events
+  // as well as peripheral to maximize statistical power
+  if ((mode == PairsLoop && nClusters > 1000) || (mode == PairsEtaSlices && nClusters > 60))
+  {
+    return false;
+  }
 
-    TLorentzVector *pho1, *pho2;
-    int iCs = nClusters;
-    for (int jCs = 0; jCs < iCs; jCs++)
-    {
-      pho1 = savClusLV[jCs];
-      /////////////////////////////////////////////////////////////////
-      //////////////////////////////////////////////////////
-      // *********************************
-      //
-      //  CUTS FOLLOW HERE (e.g. pt cuts)
-      //
-      //*************************************
-      ///////////////////////////////////
-
-      // centrality dependent pt cuts designed to keep
-      // statistical cluster count   contribution (& sig/bkg)
-      // constant with all centrality
-      // in order to maximize statistical power i.e. using all events
-      // in the calibration not just peripheral events.
-      // this is neccessary for the summer 23 data because
-      // the event rate was small and the total statistics per
-      // stable calibration period (typically a daq run-length) is small
-
-      float modCutFactor = 1.0;
-
-      if (iCs < 30)
-      {
-        // pt1cut =  1.65*modCutFactor;
-        // pt2cut  = 0.8*modCutFactor;
+  // calibration correction will be applied here
+  std::vector<TLorentzVector> savClusLV(nClusters);
+  for (int j = 0; j < nClusters; j++)
+  {
+    float pt = m_cache.pt[first + j];
+    float E = m_cache.e[first + j];
+    float aggcv = myaggcorr.at(m_cache.maxTowerEta[first + j]).at(m_cache.maxTowerPhi[first + j]);
 
-        pt1cut = 1.3 * modCutFactor;
-        pt2cut = 0.7 * modCutFactor;
-      }
-      else
-      {
-        // pt1cut = 1.65*modCutFactor +  1.4*(iCs-29)/200.0*modCutFactor;
-        // pt2cut = 0.8*modCutFactor +  1.4*(iCs-29)/200.0*modCutFactor;
+    pt *= aggcv;
+    E *= aggcv;
 
-        pt1cut = 1.3 * modCutFactor + 1.4 * (iCs - 29) / 200.0 * modCutFactor;
-        pt2cut = 0.7 * modCutFactor + 1.4 * (iCs - 29) / 200.0 * modCutFactor;
-      }
+    savClusLV[j].SetPtEtaPhiE(pt, m_cache.eta[first + j], m_cache.phi[first + j], E);
+  }
 
-      float pi0ptcut = 1.22 * (pt1cut + pt2cut);
+  int iCs = nClusters;
 
-      // energy asymmetry alpha cut
-      float alphacutval = 0.6;
+  /////////////////////////////////////////////////////////////////
+  //////////////////////////////////////////////////////
+  // *********************************
+  //
+  //  CUTS FOLLOW HERE (e.g. pt cuts)
+  //
+  //*************************************
+  ///////////////////////////////////
+
+  // centrality dependent pt cuts designed to keep
+  // statistical cluster count   contribution (& sig/bkg)
+  // constant with all centrality
+  // in order to maximize statistical power i.e. using all events
+  // in the calibration not just peripheral events.
+  // this is neccessary for the summer 23 data because
+  // the event rate was small and the total statistics per
+  // stable calibration period (typically a daq run-length) is small
+
+  float modCutFactor = 1.0;
+  float pt1cut = 0, pt2cut = 0;
+
+  if (iCs < 30)
+  {
+    pt1cut = 1.3 * modCutFactor;
+    pt2cut = 0.7 * modCutFactor;
+  }
+  else
+  {
+    pt1cut = 1.3 * modCutFactor + 1.4 * (iCs - 29) / 200.0 * modCutFactor;
+    pt2cut = 0.7 * modCutFactor + 1.4 * (iCs - 29) / 200.0 * modCutFactor;
+  }
 
-      float deltaRconecut = 1.1;  // 2-gamma opening angle(dR) cut
-      // value relevant for background extent in mass
-      //  not in peak area.
+  float pi0ptcut = 1.22 * (pt1cut + pt2cut);
 
-      ////////////////////////////////////////////////////////
-      //////////////////////////////////
-      //   END CUTS
-      ///////////////////////////////////////
-      /////////////////////////////////////
+  // energy asymmetry alpha cut
+  float alphacutval = 0.6;
 
-      if (fabs(pho1->Pt()) < pt1cut)
-      {
-        continue;
-      }
+  float deltaRconecut = 1.1;  // 2-gamma opening angle(dR) cut
+  // value relevant for background extent in mass
+  //  not in peak area.
 
-      // another loop to go into the saved cluster
-      for (int kCs = 0; kCs < iCs; kCs++)
-      {
-        if (jCs == kCs)
-        {
-          continue;
-        }
+  // the eta slice pass has fixed cuts
+  if (mode == PairsEtaSlices)
+  {
+    pt1cut = 1.0;
+    pt2cut = 0.6;
+    pi0ptcut = 1.0;
+    alphacutval = 0.50;  // 0.50 to begin with
+    deltaRconecut = 0.45;
+  }
 
-        pho2 = savClusLV[kCs];
+  ////////////////////////////////////////////////////////
+  //////////////////////////////////
+  //   END CUTS
+  ///////////////////////////////////////
+  /////////////////////////////////////
 
-        if (fabs(pho2->Pt()) < pt2cut)
-        {
-          continue;
-        }
+  for (int jCs = 0; jCs < iCs; jCs++)
+  {
+    const TLorentzVector &pho1 = savClusLV[jCs];
 
-        alphaCut = fabs((pho1->E() - pho2->E()) / (pho1->E() + pho2->E()));
+    if (fabs(pho1.Pt()) < pt1cut)
+    {
+      continue;
+    }
 
-        if (alphaCut > alphacutval)
-        {
-          continue;
-        }
+    // another loop to go into the saved cluster
+    for (int kCs = 0; kCs < iCs; kCs++)
+    {
+      if (jCs == kCs)
+      {
+        continue;
+      }
 
-        TLorentzVector pi0lv;
+      const TLorentzVector &pho2 = savClusLV[kCs];
 
-        if (pho1->DeltaR(*pho2) > deltaRconecut)
-        {
-          continue;
-        }
+      if (fabs(pho2.Pt()) < pt2cut)
+      {
+        continue;
+      }
 
-        pi0lv = *pho1 + *pho2;
-        if (fabs(pi0lv.Pt()) > pi0ptcut)
-        {
-          float pairInvMass = pi0lv.M();
+      float alpha = fabs((pho1.E() - pho2.E()) / (pho1.E() + pho2.E()));
 
-          // fill the tower by tower histograms with invariant mass
-          // cemc_hist_eta_phi[_maxTowerEtas[jCs]][_maxTowerPhis[jCs]]->Fill(pairInvMass);
-          // not useful in summer 23 data
-          eta_hist.at(_maxTowerEtas[jCs])->Fill(pairInvMass);
-          pt1_ptpi0_alpha->Fill(pho1->Pt(), pi0lv.Pt(), alphaCut);
-          pairInvMassTotal->Fill(pairInvMass);
-          mass_eta->Fill(pairInvMass, _clusterEtas[jCs]);
-          mass_eta_phi->Fill(pairInvMass, _clusterEtas[jCs], _clusterPhis[jCs]);
-        }
+      if (mode == PairsLoop && alpha > alphacutval)
+      {
+        continue;
+      }
+
+      if (pho1.DeltaR(pho2) > deltaRconecut)
+      {
+        continue;
+      }
+
+      TLorentzVector pi0lv = pho1 + pho2;
+      if (mode == PairsLoop && !(fabs(pi0lv.Pt()) > pi0ptcut))
+      {
+        continue;
+      }
+      if (mode == PairsEtaSlices && (pi0lv.Pt() < pi0ptcut || alpha > alphacutval))
+      {
+        continue;
       }
+
+      PairRecord pair;
+      pair.ieta = m_cache.maxTowerEta[first + jCs];
+      pair.iphi = m_cache.maxTowerPhi[first + jCs];
+      pair.mass = pi0lv.M();
+      pair.pt1 = pho1.Pt();
+      pair.pi0pt = pi0lv.Pt();
+      pair.alpha = alpha;
+      pair.eta = m_cache.eta[first + jCs];
+      pair.phi = m_cache.phi[first + jCs];
+      pairs.push_back(pair);
     }
   }
-  std::cout << "total number of events: " << nEntries << std::endl;
-  std::cout << "total number of events discarded: " << discarded_clusters << std::endl;
+  return true;
 }
 
-//__________oo00oo__________oo00oo_________________
-// This one is for etaslices
-void CaloCalibEmc_Pi0::Loop_for_eta_slices(int nevts, const std::string &filename, TTree *intree, const std::string &incorrFile)
+//______________________________________________________________________________..
+int CaloCalibEmc_Pi0::run_pairs(const CorrArray &myaggcorr, PairMode mode)
 {
-  //  std::arrays have their indices backward, this is the old float myaggcorr[96][260];
-  std::array<std::array<float, 260>, 96> myaggcorr{};
-  std::for_each(myaggcorr.begin(), myaggcorr.end(), [](auto &row)
-                { row.fill(1.); });
-
-  std::cout << "running w/ corr file? : " << incorrFile << std::endl;
-
-  if (!incorrFile.empty())
+  unsigned int nthreads = m_nthreads;
+  if (nthreads == 0)
   {
-    TFile *infileNt = new TFile(incorrFile.c_str());
-    std::cout << "loaded incorrFile " << infileNt << std::endl;
+    nthreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  if (nthreads > 1)
+  {
+    ROOT::EnableThreadSafety();
+  }
 
-    float myieta;
-    float myiphi;
-    float mycorr;
-    float myaggcv;
+  // events are processed in blocks, each thread collects the pairs of a contiguous
+  // part of the block. The pairs are then filled in event order, so the histograms
+  // do not depend on the number of threads
+  const unsigned int nevents = m_cache.first.size() - 1;
+  const unsigned int blocksize = 10000 * nthreads;
 
-    TNtuple *innt_corrVals = (TNtuple *) infileNt->Get("nt_corrVals");
+  std::vector<std::vector<PairRecord>> pairs(nthreads);
+  std::vector<int> discarded(nthreads, 0);
 
-    innt_corrVals->SetBranchAddress("tower_eta", &myieta);
-    innt_corrVals->SetBranchAddress("tower_phi", &myiphi);
-    innt_corrVals->SetBranchAddress("corr_val", &mycorr);
-    innt_corrVals->SetBranchAddress("agg_cv", &myaggcv);
-
-    int ntCorrs = innt_corrVals->GetEntries();
+  for (unsigned int blockstart = 0; blockstart < nevents; blockstart += blocksize)
+  {
+    const unsigned int blockend = std::min(nevents, blockstart + blocksize);
+    const unsigned int chunk = (blockend - blockstart + nthreads - 1) / nthreads;
 
-    for (int ij = 0; ij < ntCorrs; ij++)
+    for (unsigned int i = blockstart; i < blockend; i++)
     {
-      innt_corrVals->GetEntry(ij);
-      int ci = (int) myieta;
-      int cj = (int) myiphi;
-      myaggcorr.at(ci).at(cj) = myaggcv;
-      if (ij > ntCorrs - 2)
+      if ((i % 10 == 0 && i < 200) || (i % 100 == 0 && i < 1000) || (i % 1000 == 0 && i < 37003) || i % 10000 == 0)
       {
-        std::cout << "loaded corrs eta,phi,aggcv " << myieta
-                  << " " << myiphi << " " << myaggcv << std::endl;
+        std::cout << "evt no " << i << std::endl;
       }
     }
 
-    infileNt->Close();
-    delete infileNt;
-  }
+    std::vector<std::thread> threads;
+    for (unsigned int ithread = 0; ithread < nthreads; ithread++)
+    {
+      pairs[ithread].clear();
+      const unsigned int first = std::min(blockend, blockstart + ithread * chunk);
+      const unsigned int last = std::min(blockend, first + chunk);
+      threads.emplace_back([this, first, last, &myaggcorr, mode, &pairs, &discarded, ithread]()
+                           {
+                             for (unsigned int i = first; i < last; i++)
+                             {
+                               if (!select_pairs(i, myaggcorr, mode, pairs[ithread]))
+                               {
+                                 discarded[ithread]++;
+                               }
+                             } });
+    }
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
 
-  std::cout << "in loop" << std::endl;
+    for (const auto &threadpairs : pairs)
+    {
+      for (const auto &pair : threadpairs)
+      {
+        if (mode == PairsLoop)
+        {
+          // fill the tower by tower histograms with invariant mass
+          // cemc_hist_eta_phi[_maxTowerEtas[jCs]][_maxTowerPhis[jCs]]->Fill(pairInvMass);
+          // not useful in summer 23 data
+          eta_hist.at(pair.ieta)->Fill(pair.mass);
+          pt1_ptpi0_alpha->Fill(pair.pt1, pair.pi0pt, pair.alpha);
+          pairInvMassTotal->Fill(pair.mass);
+          mass_eta->Fill(pair.mass, pair.eta);
+          mass_eta_phi->Fill(pair.mass, pair.eta, pair.phi);
+        }
+        else
+        {
+          // fill the tower by tower histograms with invariant mass
+          // we don't need to fill tower-by-tower level when we do for eta slices
+          // although filling here just so we don't have to change codes in other places
+          cemc_hist_eta_phi.at(pair.ieta).at(pair.iphi)->Fill(pair.mass);
+          eta_hist.at(pair.ieta)->Fill(pair.mass);
+        }
+      }
+    }
+  }
 
-  TTree *t1 = intree;
-  if (!intree)
+  int ndiscarded = 0;
+  for (int n : discarded)
   {
-    TFile *f = new TFile(filename.c_str());
-    t1 = (TTree *) f->Get("_eventTree");
+    ndiscarded += n;
   }
+  return ndiscarded;
+}
 
-  // Set Branches
-  //  t1->SetBranchAddress("_eventNumber", &_eventNumber);
-  t1->SetBranchAddress("_nClusters", &_nClusters);
-  //  t1->SetBranchAddress("_clusterIDs", _clusterIDs);
-  t1->SetBranchAddress("_clusterEnergies", _clusterEnergies);
-  t1->SetBranchAddress("_clusterPts", _clusterPts);
-  t1->SetBranchAddress("_clusterEtas", _clusterEtas);
-  t1->SetBranchAddress("_clusterPhis", _clusterPhis);
-  t1->SetBranchAddress("_maxTowerEtas", _maxTowerEtas);
-  t1->SetBranchAddress("_maxTowerPhis", _maxTowerPhis);
+//______________________________________________________________________________..
+void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intree, const std::string &incorrFile)
+{
+  CorrArray myaggcorr{};
+  load_corrections(incorrFile, myaggcorr, true);
 
-  // pre-loop to save all the clusters LorentzVector
+  std::cout << "in loop" << std::endl;
 
-  std::array<TLorentzVector *, 10000> savClusLV{};
+  load_cluster_cache(nevts, filename, intree);
 
-  //  int nEntries = (int) t1->GetEntriesFast();
-  int nEntries = (int) t1->GetEntries();
-  int nevts2 = nevts;
+  // keeping track of discarded clusters for v7
+  int discarded_clusters = run_pairs(myaggcorr, PairsLoop);
 
-  if (nevts < 0 || nEntries < nevts)
-  {
-    nevts2 = nEntries;
-  }
+  std::cout << "total number of events: " << m_cache.first.size() - 1 << std::endl;
+  std::cout << "total number of events discarded: " << discarded_clusters << std::endl;
+}
 
-  for (int i = 0; i < nevts2; i++)
-  {
-    // load the ith instance of the TTree
-    t1->GetEntry(i);
+//______________________________________________________________________________..
+void CaloCalibEmc_Pi0::Loop_Iterations(int niter, int nevts, const std::string &filename, TTree *intree, const std::string &incorrFile, float tolerance)
+{
+  CorrArray myaggcorr{};
+  load_corrections(incorrFile, myaggcorr, true);
 
-    if ((i % 10 == 0 && i < 200) || (i % 100 == 0 && i < 1000) || (i % 1000 == 0 && i < 37003) || i % 10000 == 0)
-    {
-      std::cout << "evt no " << i << std::endl;
-    }
-    // calibration correction will be applied here
+  load_cluster_cache(nevts, filename, intree);
 
-    int nClusters = _nClusters;
+  std::array<float, 96> lastcorr{};
+  lastcorr.fill(1.);
 
-    if (nClusters > 60)
+  for (int iter = 0; iter < niter; iter++)
+  {
+    for (auto *hist : eta_hist)
     {
-      continue;
+      hist->Reset();
     }
+    pt1_ptpi0_alpha->Reset();
+    pairInvMassTotal->Reset();
+    mass_eta->Reset();
+    mass_eta_phi->Reset();
 
-    for (int j = 0; j < nClusters; j++)
-    {
-      // float px, py, pz;
-      float pt, eta, phi, E, aggcv;
-      pt = _clusterPts[j];
-      eta = _clusterEtas[j];
-      phi = _clusterPhis[j];
-      E = _clusterEnergies[j];
-      aggcv = myaggcorr.at(_maxTowerEtas[j]).at(_maxTowerPhis[j]);
-
-      pt *= aggcv;
-      E *= aggcv;
-
-      savClusLV.at(j) = new TLorentzVector();
-      savClusLV.at(j)->SetPtEtaPhiE(pt, eta, phi, E);
-    }
+    run_pairs(myaggcorr, PairsLoop);
 
-    TLorentzVector *pho1, *pho2;
-    int iCs = nClusters;
-    for (int jCs = 0; jCs < iCs; jCs++)
+    // peak position of each eta slice: gaussian around the maximum, as in the Fit_Histos methods
+    float maxdev = 0;
+    int nfit = 0;
+    for (int ieta = 0; ieta < 96; ieta++)
     {
-      pho1 = savClusLV.at(jCs);
-
-      if (fabs(pho1->Pt()) < 1.0)
+      TH1 *hist = eta_hist.at(ieta);
+      lastcorr.at(ieta) = 1.;
+      if (hist->GetEntries() == 0)
       {
         continue;
       }
 
-      // another loop to go into the saved cluster
-      for (int kCs = 0; kCs < iCs; kCs++)
+      float pkloc = 0.0;
+      float bsavloc = 0.0;
+      for (int kfi = 1; kfi < 20; kfi++)
       {
-        if (jCs == kCs)
+        float locbv = hist->GetBinContent(kfi);
+        if (locbv > bsavloc)
         {
-          continue;
+          pkloc = hist->GetBinCenter(kfi);
+          bsavloc = locbv;
         }
+      }
 
-        pho2 = savClusLV.at(kCs);
+      TF1 fgaus("fgaus", "gaus", pkloc - 0.04, pkloc + 0.04);
+      if (hist->Fit(&fgaus, "QRN0") != 0)
+      {
+        continue;
+      }
+      float mean = fgaus.GetParameter(1);
+      if (!(mean > 0.05 && mean < 0.3))
+      {
+        continue;
+      }
 
-        if (fabs(pho2->Pt()) < 0.6)
-        {
-          continue;
-        }
+      lastcorr.at(ieta) = _setMassVal / mean;
+      maxdev = std::max(maxdev, std::abs(mean / _setMassVal - 1));
+      nfit++;
 
-        TLorentzVector pi0lv;
-        if (pho1->DeltaR(*pho2) > 0.45)
-        {
-          continue;
-        }
-        pi0lv = *pho1 + *pho2;
-        float pairInvMass = pi0lv.M();
-        if (pi0lv.Pt() < 1.0)
-        {
-          continue;
-        }
+      for (auto &corr : myaggcorr.at(ieta))
+      {
+        corr *= lastcorr.at(ieta);
+      }
+    }
 
-        /*
-        if (_maxTowerEtas[jCs]==50 && ((pi0lv.M()>=0.015 && pi0lv.M()<=0.095) || (pi0lv.M()>=0.175 && pi0lv.M()<=0.255)))
-        {
-                e1_hist_wo_alpha->Fill(pho1->E());
-                e2_hist_wo_alpha->Fill(pho2->E());
-        }
-        */
+    std::cout << "CaloCalibEmc_Pi0::Loop_Iterations - iteration " << iter
+              << " fitted eta slices: " << nfit
+              << " max relative peak deviation: " << maxdev << std::endl;
 
-        alphaCut = fabs((pho1->E() - pho2->E()) / (pho1->E() + pho2->E()));
-        if (alphaCut > 0.50)
-        {
-          continue;  // 0.50 to begin with
-        }
+    if (nfit > 0 && maxdev < tolerance)
+    {
+      std::cout << "CaloCalibEmc_Pi0::Loop_Iterations - converged after " << iter + 1 << " iterations" << std::endl;
+      break;
+    }
+  }
 
-        /*
-        if  (_maxTowerEtas[jCs]==50 && ((pi0lv.M()>=0.015 && pi0lv.M()<=0.095) || (pi0lv.M()>=0.175 && pi0lv.M()<=0.255)))
-        {
-                e1_hist_w_alpha->Fill(pho1->E());
-                e2_hist_w_alpha->Fill(pho2->E());
-        }
-        */
-
-        // fill the tower by tower histograms with invariant mass
-        // we don't need to fill tower-by-tower level when we do for eta slices
-        // although filling here just so we don't have to change codes in other places
-        cemc_hist_eta_phi.at(_maxTowerEtas[jCs]).at(_maxTowerPhis[jCs])->Fill(pairInvMass);
-        eta_hist.at(_maxTowerEtas[jCs])->Fill(pairInvMass);
-        // pt1_ptpi0_alpha->Fill(pho1->Pt(), pi0lv.Pt(), alphaCut);
-      }
+  // corrections in the nt_corrVals format, to be used as input for the next Loop
+  cal_output->cd();
+  TNtuple *nt_corrVals = new TNtuple("nt_corrVals", "Ntuple of the corrections", "tower_eta:tower_phi:corr_val:agg_cv");
+  for (int ieta = 0; ieta < 96; ieta++)
+  {
+    for (int iphi = 0; iphi < 256; iphi++)
+    {
+      nt_corrVals->Fill(ieta, iphi, lastcorr.at(ieta), myaggcorr.at(ieta).at(iphi));
     }
   }
 }
 
+//__________oo00oo__________oo00oo_________________
+// This one is for etaslices
+void CaloCalibEmc_Pi0::Loop_for_eta_slices(int nevts, const std::string &filename, TTree *intree, const std::string &incorrFile)
+{
+  CorrArray myaggcorr{};
+  load_corrections(incorrFile, myaggcorr, false);
+
+  std::cout << "in loop" << std::endl;
+
+  load_cluster_cache(nevts, filename, intree);
+
+  run_pairs(myaggcorr, PairsEtaSlices);
+}
+
 // _______________________________________________________________..
 void CaloCalibEmc_Pi0::Fit_Histos(const std::string &incorrFile)
 {
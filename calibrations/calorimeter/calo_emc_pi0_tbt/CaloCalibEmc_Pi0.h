@@ -7,6 +7,7 @@
 
 #include <array>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 class TFile;
@@ -41,6 +42,11 @@ class CaloCalibEmc_Pi0 : public SubsysReco
   void Loop(int nevts, const std::string &filename, TTree *intree = nullptr, const std::string &ifileCorr = "");
   void Loop_for_eta_slices(int nevts, const std::string &filename, TTree *intree = nullptr, const std::string &ifileCorr = "");
 
+  // repeats the Loop() pass niter times on clusters kept in memory, the eta slice corrections
+  // are updated after each pass from the eta_hist peaks until all peaks are within
+  // tolerance of the target mass. The final corrections are written as nt_corrVals
+  void Loop_Iterations(int niter, int nevts, const std::string &filename, TTree *intree = nullptr, const std::string &ifileCorr = "", float tolerance = 0.002);
+
   void Fit_Histos_Etas96(const std::string &infilent);
   void Fit_Histos(const std::string &infilent);
   void Fit_Histos_Eta_Phi_Add96(const std::string &infilent);
@@ -73,7 +79,56 @@ class CaloCalibEmc_Pi0 : public SubsysReco
     _setMassVal = insetval;
   }
 
+  // number of threads for the pair loops, 0 uses all cores
+  void set_nthreads(unsigned int n)
+  {
+    m_nthreads = n;
+  }
+
  private:
+  //  std::arrays have their indices backward, this is the old float myaggcorr[96][260];
+  using CorrArray = std::array<std::array<float, 260>, 96>;
+
+  enum PairMode
+  {
+    PairsLoop,
+    PairsEtaSlices
+  };
+
+  // accepted cluster pair, filled into the histograms after the (threaded) pair loop
+  struct PairRecord
+  {
+    int ieta{0};
+    int iphi{0};
+    float mass{0};
+    float pt1{0};
+    float pi0pt{0};
+    float alpha{0};
+    float eta{0};
+    float phi{0};
+  };
+
+  // the clusters of _eventTree stored column wise, so the tree is read only once
+  struct ClusterCache
+  {
+    std::string filename;
+    TTree *tree{nullptr};
+    int nevts{-1};
+    std::vector<unsigned int> first;  // index of first cluster of each event, nevents+1 entries
+    std::vector<float> pt;
+    std::vector<float> eta;
+    std::vector<float> phi;
+    std::vector<float> e;
+    std::vector<short> maxTowerEta;
+    std::vector<short> maxTowerPhi;
+  };
+
+  void load_corrections(const std::string &incorrFile, CorrArray &myaggcorr, bool printMiddle);
+  TTree *get_tree(const std::string &filename, TTree *intree);
+  void load_cluster_cache(int nevts, const std::string &filename, TTree *intree);
+  bool select_pairs(unsigned int ievt, const CorrArray &myaggcorr, PairMode mode, std::vector<PairRecord> &pairs) const;
+  int run_pairs(const CorrArray &myaggcorr, PairMode mode);
+
   //  float setMassVal = 0.135;
   float _setMassVal{0.152};
   // currently defaulting to 0.152 to match sim
@@ -126,6 +181,9 @@ class CaloCalibEmc_Pi0 : public SubsysReco
   TFile *f_temp{nullptr};
 
   int m_UseTowerInfo{0};  // 0 only old tower, 1 only new (TowerInfo based),
+
+  unsigned int m_nthreads{0};
+  ClusterCache m_cache;
 };
 
 #endif  //   CALOEMCPI0TBT_CALOCALIBEMC_PI0_H
@@ -0,0 +1,236 @@
+#include "ChannelHistogram.h"
+
+#include <phool/phool.h>  // for PHWHERE
+
+#include <TDirectory.h>
+#include <TH1.h>
+#include <TTree.h>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <iostream>
+#include <numeric>
+
+namespace
+{
+  //! values are binned in chunks of this size, the bin computation vectorizes
+  constexpr unsigned int chunk_size = 256;
+}  // namespace
+
+ChannelHistogram::ChannelHistogram(const unsigned int nchannels, const unsigned int nbins, const double xmin, const double xmax)
+{
+  configure(nchannels, nbins, xmin, xmax);
+}
+
+const std::string& ChannelHistogram::TreeTitle()
+{
+  static const std::string title = "ChannelHistogram";
+  return title;
+}
+
+void ChannelHistogram::configure(const unsigned int nchannels, const unsigned int nbins, const double xmin, const double xmax)
+{
+  m_nchannels = nchannels;
+  m_nbins = nbins;
+  m_xmin = xmin;
+  m_xmax = xmax;
+  m_scale = (xmax > xmin) ? nbins / (xmax - xmin) : 0;
+  m_counts.assign(size_t(nchannels) * (nbins + 2), 0);
+}
+
+void ChannelHistogram::reset()
+{
+  std::fill(m_counts.begin(), m_counts.end(), 0);
+}
+
+bool ChannelHistogram::same_binning(const ChannelHistogram& other) const
+{
+  return m_nchannels == other.m_nchannels && m_nbins == other.m_nbins && m_xmin == other.m_xmin && m_xmax == other.m_xmax;
+}
+
+unsigned int ChannelHistogram::find_bin(const double value) const
+{
+  if (!(value >= m_xmin))
+  {
+    return 0;
+  }
+  if (value >= m_xmax)
+  {
+    return m_nbins + 1;
+  }
+  return std::min<unsigned int>(1 + static_cast<unsigned int>((value - m_xmin) * m_scale), m_nbins);
+}
+
+void ChannelHistogram::fill(const unsigned int channel, const unsigned short* values, const unsigned int n)
+{
+  uint64_t* row = &m_counts[size_t(channel) * (m_nbins + 2)];
+  std::array<unsigned int, chunk_size> bins{};
+  for (unsigned int offset = 0; offset < n; offset += chunk_size)
+  {
+    const unsigned int nvalues = std::min(chunk_size, n - offset);
+    for (unsigned int i = 0; i < nvalues; ++i)
+    {
+      bins[i] = find_bin(values[offset + i]);
+    }
+    for (unsigned int i = 0; i < nvalues; ++i)
+    {
+      ++row[bins[i]];
+    }
+  }
+}
+
+void ChannelHistogram::fill(const unsigned int channel, const float* values, const unsigned int n)
+{
+  uint64_t* row = &m_counts[size_t(channel) * (m_nbins + 2)];
+  std::array<unsigned int, chunk_size> bins{};
+  for (unsigned int offset = 0; offset < n; offset += chunk_size)
+  {
+    const unsigned int nvalues = std::min(chunk_size, n - offset);
+    for (unsigned int i = 0; i < nvalues; ++i)
+    {
+      bins[i] = find_bin(values[offset + i]);
+    }
+    for (unsigned int i = 0; i < nvalues; ++i)
+    {
+      ++row[bins[i]];
+    }
+  }
+}
+
+bool ChannelHistogram::merge(const ChannelHistogram& other)
+{
+  if (!same_binning(other))
+  {
+    std::cout << PHWHERE << " binning differs, cannot merge" << std::endl;
+    return false;
+  }
+  std::transform(m_counts.begin(), m_counts.end(), other.m_counts.begin(), m_counts.begin(), std::plus<>());
+  return true;
+}
+
+uint64_t ChannelHistogram::entries(const unsigned int channel) const
+{
+  const uint64_t* row = counts(channel);
+  return std::accumulate(row, row + m_nbins + 2, uint64_t(0));
+}
+
+void ChannelHistogram::copy_to(const unsigned int channel, TH1* histogram) const
+{
+  if (!histogram || histogram->GetNbinsX() != int(m_nbins))
+  {
+    std::cout << PHWHERE << " histogram missing or with wrong number of bins" << std::endl;
+    return;
+  }
+  histogram->Reset();
+  const uint64_t* row = counts(channel);
+  for (unsigned int bin = 0; bin < m_nbins + 2; ++bin)
+  {
+    histogram->SetBinContent(bin, row[bin]);
+  }
+  histogram->SetEntries(entries(channel));
+  histogram->ResetStats();
+}
+
+bool ChannelHistogram::Write(TDirectory* dir, const std::string& name) const
+{
+  if (!dir)
+  {
+    std::cout << PHWHERE << " no output directory for " << name << std::endl;
+    return false;
+  }
+
+  TDirectory::TContext context(dir);
+  TTree* tree = new TTree(name.c_str(), TreeTitle().c_str());
+
+  // one entry per non empty channel, the binning is repeated in each entry,
+  // which costs nothing after compression
+  unsigned int nchannels = m_nchannels;
+  unsigned int nbins = m_nbins;
+  double xmin = m_xmin;
+  double xmax = m_xmax;
+  unsigned int channel = 0;
+  int ncounts = m_nbins + 2;
+  std::vector<ULong64_t> buffer(ncounts, 0);
+  tree->Branch("nchannels", &nchannels, "nchannels/i");
+  tree->Branch("nbins", &nbins, "nbins/i");
+  tree->Branch("xmin", &xmin, "xmin/D");
+  tree->Branch("xmax", &xmax, "xmax/D");
+  tree->Branch("channel", &channel, "channel/i");
+  tree->Branch("ncounts", &ncounts, "ncounts/I");
+  tree->Branch("counts", buffer.data(), "counts[ncounts]/l");
+
+  for (channel = 0; channel < nchannels; ++channel)
+  {
+    if (entries(channel) == 0)
+    {
+      continue;
+    }
+    std::copy_n(counts(channel), ncounts, buffer.begin());
+    tree->Fill();
+  }
+
+  // an empty histogram still records its binning
+  if (tree->GetEntries() == 0)
+  {
+    channel = 0;
+    std::fill(buffer.begin(), buffer.end(), 0);
+    tree->Fill();
+  }
+
+  const bool status = tree->Write("", TObject::kOverwrite) > 0;
+  delete tree;
+  return status;
+}
+
+bool ChannelHistogram::Read(TDirectory* dir, const std::string& name)
+{
+  TTree* tree = dir ? dynamic_cast<TTree*>(dir->Get(name.c_str())) : nullptr;
+  if (!tree || TreeTitle() != tree->GetTitle() || tree->GetEntries() == 0)
+  {
+    std::cout << PHWHERE << " no " << TreeTitle() << " tree " << name << " found" << std::endl;
+    return false;
+  }
+
+  // binning from the first entry
+  unsigned int nchannels = 0;
+  unsigned int nbins = 0;
+  double xmin = 0;
+  double xmax = 0;
+  unsigned int channel = 0;
+  int ncounts = 0;
+  tree->SetBranchAddress("nchannels", &nchannels);
+  tree->SetBranchAddress("nbins", &nbins);
+  tree->SetBranchAddress("xmin", &xmin);
+  tree->SetBranchAddress("xmax", &xmax);
+  tree->SetBranchAddress("channel", &channel);
+  tree->SetBranchAddress("ncounts", &ncounts);
+  tree->SetBranchStatus("counts", false);
+  tree->GetEntry(0);
+  configure(nchannels, nbins, xmin, xmax);
+  if (m_nchannels == 0)
+  {
+    delete tree;
+    return true;
+  }
+
+  std::vector<ULong64_t> buffer(nbins + 2, 0);
+  tree->SetBranchStatus("counts", true);
+  tree->SetBranchAddress("counts", buffer.data());
+
+  bool status = true;
+  for (Long64_t entry = 0; entry < tree->GetEntries(); ++entry)
+  {
+    tree->GetEntry(entry);
+    if (channel >= m_nchannels || ncounts != int(m_nbins + 2))
+    {
+      std::cout << PHWHERE << " inconsistent entry " << entry << " in " << name << std::endl;
+      status = false;
+      break;
+    }
+    std::copy(buffer.begin(), buffer.end(), m_counts.begin() + size_t(channel) * (m_nbins + 2));
+  }
+
+  delete tree;
+  return status;
+}
@@ -0,0 +1,102 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef CHANSTATS_CHANNELHISTOGRAM_H
+#define CHANSTATS_CHANNELHISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class TDirectory;
+class TH1;
+
+/*! \class ChannelHistogram
+    \brief dense per-channel fixed bin counters
+
+    One contiguous array of nbins+2 counters per channel (underflow, bins, overflow,
+    same numbering as TH1), all channels share the same binning. This replaces one TH1 per
+    channel, merging is a plain sum of the counters and therefore associative and exact.
+
+    Write() stores the non empty channels in a TTree with one entry per channel,
+    the tree title tags the type for chanstats_merge.
+*/
+class ChannelHistogram
+{
+ public:
+  ChannelHistogram() = default;
+  ChannelHistogram(const unsigned int nchannels, const unsigned int nbins, const double xmin, const double xmax);
+  virtual ~ChannelHistogram() = default;
+
+  //! set the number of channels and the binning, all counters are cleared
+  void configure(const unsigned int nchannels, const unsigned int nbins, const double xmin, const double xmax);
+
+  //! clear all counters
+  void reset();
+
+  //!@name binning
+  //@{
+  unsigned int size() const { return m_nchannels; }
+  unsigned int nbins() const { return m_nbins; }
+  double xmin() const { return m_xmin; }
+  double xmax() const { return m_xmax; }
+
+  //! true if the binning of other is the same as this one
+  bool same_binning(const ChannelHistogram& other) const;
+
+  //! bin containing value, 0 is underflow and nbins+1 overflow
+  unsigned int find_bin(const double value) const;
+  //@}
+
+  //! add one value to a channel
+  void fill(const unsigned int channel, const double value, const uint64_t weight = 1)
+  {
+    m_counts[size_t(channel) * (m_nbins + 2) + find_bin(value)] += weight;
+  }
+
+  //!@name add n values to a channel
+  //@{
+  void fill(const unsigned int channel, const unsigned short* values, const unsigned int n);
+  void fill(const unsigned int channel, const float* values, const unsigned int n);
+  //@}
+
+  //! add the content of another histogram. Returns false if the binning differs
+  bool merge(const ChannelHistogram& other);
+
+  //!@name per channel results
+  //@{
+  uint64_t count(const unsigned int channel, const unsigned int bin) const { return m_counts[size_t(channel) * (m_nbins + 2) + bin]; }
+
+  //! counters of a channel, nbins+2 values
+  const uint64_t* counts(const unsigned int channel) const { return &m_counts[size_t(channel) * (m_nbins + 2)]; }
+
+  //! entries in a channel, including under and overflow
+  uint64_t entries(const unsigned int channel) const;
+
+  //! copy a channel into a TH1, which must have nbins bins. Statistics are recomputed from the bin content
+  void copy_to(const unsigned int channel, TH1* histogram) const;
+  //@}
+
+  //! write to a TTree called name in dir. Returns false on failure
+  bool Write(TDirectory* dir, const std::string& name) const;
+
+  //! replace the content with the TTree called name from dir. Returns false on failure
+  bool Read(TDirectory* dir, const std::string& name);
+
+  //! title of the TTree written by Write(), identifies the type when reading
+  static const std::string& TreeTitle();
+
+ private:
+  unsigned int m_nchannels = 0;
+  unsigned int m_nbins = 0;
+  double m_xmin = 0;
+  double m_xmax = 0;
+
+  //! bins per unit of x
+  double m_scale = 0;
+
+  //! nchannels * (nbins+2) counters
+  std::vector<uint64_t> m_counts;
+};
+
+#endif  // CHANSTATS_CHANNELHISTOGRAM_H
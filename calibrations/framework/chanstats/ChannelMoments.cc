@@ -0,0 +1,260 @@
+#include "ChannelMoments.h"
+
+#include <phool/phool.h>  // for PHWHERE
+
+#include <TDirectory.h>
+#include <TTree.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+  //! mean and second central moment of a block of floating point values, two passes
+  template <class T>
+  std::pair<double, double> block_moments(const T* values, const unsigned int n)
+  {
+    double sum = 0;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+      sum += values[i];
+    }
+    const double mean = sum / n;
+    double m2 = 0;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+      const double delta = values[i] - mean;
+      m2 += delta * delta;
+    }
+    return std::make_pair(mean, m2);
+  }
+}  // namespace
+
+ChannelMoments::ChannelMoments(const unsigned int nchannels)
+  : m_count(nchannels, 0)
+  , m_mean(nchannels, 0)
+  , m_m2(nchannels, 0)
+{
+}
+
+const std::string& ChannelMoments::TreeTitle()
+{
+  static const std::string title = "ChannelMoments";
+  return title;
+}
+
+void ChannelMoments::resize(const unsigned int nchannels)
+{
+  m_count.resize(nchannels, 0);
+  m_mean.resize(nchannels, 0);
+  m_m2.resize(nchannels, 0);
+}
+
+void ChannelMoments::reset()
+{
+  std::fill(m_count.begin(), m_count.end(), 0);
+  std::fill(m_mean.begin(), m_mean.end(), 0);
+  std::fill(m_m2.begin(), m_m2.end(), 0);
+}
+
+void ChannelMoments::fill(const unsigned int channel, const double value)
+{
+  // Welford
+  const uint64_t n = ++m_count[channel];
+  const double delta = value - m_mean[channel];
+  m_mean[channel] += delta / n;
+  m_m2[channel] += delta * (value - m_mean[channel]);
+}
+
+void ChannelMoments::fill(const unsigned int channel, const unsigned short* values, const unsigned int n)
+{
+  if (n == 0)
+  {
+    return;
+  }
+
+  // exact integer sums, 65535^2 * 2^32 still fits in 64 bits. The loop vectorizes
+  uint64_t sum = 0;
+  uint64_t sumsq = 0;
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    const uint64_t value = values[i];
+    sum += value;
+    sumsq += value * value;
+  }
+  const double mean = double(sum) / n;
+  const double m2 = double(sumsq) - double(sum) * mean;
+  add(channel, n, mean, std::max(m2, 0.));
+}
+
+void ChannelMoments::fill(const unsigned int channel, const float* values, const unsigned int n)
+{
+  if (n == 0)
+  {
+    return;
+  }
+  const auto [mean, m2] = block_moments(values, n);
+  add(channel, n, mean, m2);
+}
+
+void ChannelMoments::fill(const unsigned int channel, const double* values, const unsigned int n)
+{
+  if (n == 0)
+  {
+    return;
+  }
+  const auto [mean, m2] = block_moments(values, n);
+  add(channel, n, mean, m2);
+}
+
+void ChannelMoments::add(const unsigned int channel, const uint64_t n, const double mean, const double m2)
+{
+  if (n == 0)
+  {
+    return;
+  }
+
+  const uint64_t n_a = m_count[channel];
+  if (n_a == 0)
+  {
+    m_count[channel] = n;
+    m_mean[channel] = mean;
+    m_m2[channel] = m2;
+    return;
+  }
+
+  // Chan et al. pairwise update
+  const uint64_t n_ab = n_a + n;
+  const double delta = mean - m_mean[channel];
+  m_mean[channel] += delta * n / n_ab;
+  m_m2[channel] += m2 + delta * delta * n_a * n / n_ab;
+  m_count[channel] = n_ab;
+}
+
+bool ChannelMoments::merge(const ChannelMoments& other)
+{
+  if (other.size() != size())
+  {
+    std::cout << PHWHERE << " number of channels differ: " << size() << " vs " << other.size() << std::endl;
+    return false;
+  }
+  for (unsigned int channel = 0; channel < size(); ++channel)
+  {
+    add(channel, other.m_count[channel], other.m_mean[channel], other.m_m2[channel]);
+  }
+  return true;
+}
+
+double ChannelMoments::variance(const unsigned int channel) const
+{
+  return m_count[channel] ? m_m2[channel] / m_count[channel] : 0;
+}
+
+double ChannelMoments::sample_variance(const unsigned int channel) const
+{
+  return m_count[channel] > 1 ? m_m2[channel] / (m_count[channel] - 1) : 0;
+}
+
+double ChannelMoments::rms(const unsigned int channel) const
+{
+  return std::sqrt(variance(channel));
+}
+
+bool ChannelMoments::Write(TDirectory* dir, const std::string& name) const
+{
+  if (!dir)
+  {
+    std::cout << PHWHERE << " no output directory for " << name << std::endl;
+    return false;
+  }
+
+  TDirectory::TContext context(dir);
+  TTree* tree = new TTree(name.c_str(), TreeTitle().c_str());
+
+  // one entry per non empty channel, the number of channels is repeated in each entry,
+  // which costs nothing after compression
+  unsigned int nchannels = size();
+  unsigned int channel = 0;
+  ULong64_t count = 0;
+  double mean = 0;
+  double m2 = 0;
+  tree->Branch("nchannels", &nchannels, "nchannels/i");
+  tree->Branch("channel", &channel, "channel/i");
+  tree->Branch("count", &count, "count/l");
+  tree->Branch("mean", &mean, "mean/D");
+  tree->Branch("m2", &m2, "m2/D");
+
+  for (channel = 0; channel < nchannels; ++channel)
+  {
+    if (m_count[channel] == 0)
+    {
+      continue;
+    }
+    count = m_count[channel];
+    mean = m_mean[channel];
+    m2 = m_m2[channel];
+    tree->Fill();
+  }
+
+  // an empty accumulator still records its size
+  if (tree->GetEntries() == 0 && nchannels > 0)
+  {
+    channel = 0;
+    count = 0;
+    mean = 0;
+    m2 = 0;
+    tree->Fill();
+  }
+
+  const bool status = tree->Write("", TObject::kOverwrite) > 0;
+  delete tree;
+  return status;
+}
+
+bool ChannelMoments::Read(TDirectory* dir, const std::string& name)
+{
+  TTree* tree = dir ? dynamic_cast<TTree*>(dir->Get(name.c_str())) : nullptr;
+  if (!tree || TreeTitle() != tree->GetTitle())
+  {
+    std::cout << PHWHERE << " no " << TreeTitle() << " tree " << name << " found" << std::endl;
+    return false;
+  }
+
+  unsigned int nchannels = 0;
+  unsigned int channel = 0;
+  ULong64_t count = 0;
+  double mean = 0;
+  double m2 = 0;
+  tree->SetBranchAddress("nchannels", &nchannels);
+  tree->SetBranchAddress("channel", &channel);
+  tree->SetBranchAddress("count", &count);
+  tree->SetBranchAddress("mean", &mean);
+  tree->SetBranchAddress("m2", &m2);
+
+  m_count.clear();
+  m_mean.clear();
+  m_m2.clear();
+
+  bool status = true;
+  for (Long64_t entry = 0; entry < tree->GetEntries(); ++entry)
+  {
+    tree->GetEntry(entry);
+    if (entry == 0)
+    {
+      resize(nchannels);
+    }
+    if (channel >= size())
+    {
+      std::cout << PHWHERE << " channel " << channel << " out of range in " << name << std::endl;
+      status = false;
+      break;
+    }
+    m_count[channel] = count;
+    m_mean[channel] = mean;
+    m_m2[channel] = m2;
+  }
+
+  delete tree;
+  return status;
+}
@@ -0,0 +1,89 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef CHANSTATS_CHANNELMOMENTS_H
+#define CHANSTATS_CHANNELMOMENTS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class TDirectory;
+
+/*! \class ChannelMoments
+    \brief dense per-channel count, mean and second central moment
+
+    Replaces the one-histogram-per-channel (or sum and sum of squares) bookkeeping
+    of calibration modules. The moments are updated with Welford's algorithm,
+    a block of samples from one channel is reduced first and then added with the
+    pairwise update of Chan et al., which is also used by merge(). The merge is
+    associative, so partial results from any number of jobs can be combined in any order.
+
+    The block fill of unsigned short samples (ADC) sums in 64 bit integers, which
+    is exact and lets the compiler vectorize the loop.
+
+    Write() stores the non empty channels in a TTree with one entry per channel,
+    the tree title tags the type for chanstats_merge.
+*/
+class ChannelMoments
+{
+ public:
+  explicit ChannelMoments(const unsigned int nchannels = 0);
+  virtual ~ChannelMoments() = default;
+
+  //! number of channels
+  unsigned int size() const { return m_count.size(); }
+
+  //! change the number of channels, existing channels are kept
+  void resize(const unsigned int nchannels);
+
+  //! clear all channels
+  void reset();
+
+  //! add one value to a channel
+  void fill(const unsigned int channel, const double value);
+
+  //!@name add n values to a channel
+  //@{
+  void fill(const unsigned int channel, const unsigned short* values, const unsigned int n);
+  void fill(const unsigned int channel, const float* values, const unsigned int n);
+  void fill(const unsigned int channel, const double* values, const unsigned int n);
+  //@}
+
+  //! add the content of another accumulator. Returns false if the number of channels differ
+  bool merge(const ChannelMoments& other);
+
+  //!@name per channel results
+  //@{
+  uint64_t count(const unsigned int channel) const { return m_count[channel]; }
+  double mean(const unsigned int channel) const { return m_mean[channel]; }
+  double m2(const unsigned int channel) const { return m_m2[channel]; }
+
+  //! population variance, m2/n
+  double variance(const unsigned int channel) const;
+
+  //! sample variance, m2/(n-1)
+  double sample_variance(const unsigned int channel) const;
+
+  //! population standard deviation
+  double rms(const unsigned int channel) const;
+  //@}
+
+  //! write to a TTree called name in dir. Returns false on failure
+  bool Write(TDirectory* dir, const std::string& name) const;
+
+  //! replace the content with the TTree called name from dir. Returns false on failure
+  bool Read(TDirectory* dir, const std::string& name);
+
+  //! title of the TTree written by Write(), identifies the type when reading
+  static const std::string& TreeTitle();
+
+ private:
+  //! add a block of n values with mean and second central moment m2 to a channel
+  void add(const unsigned int channel, const uint64_t n, const double mean, const double m2);
+
+  std::vector<uint64_t> m_count;
+  std::vector<double> m_mean;
+  std::vector<double> m_m2;
+};
+
+#endif  // CHANSTATS_CHANNELMOMENTS_H
@@ -0,0 +1,196 @@
+#include "CrossingScalers.h"
+
+#include <phool/phool.h>  // for PHWHERE
+
+#include <TDirectory.h>
+#include <TTree.h>
+
+#include <iostream>
+
+CrossingScalers::CrossingScalers(const unsigned int ntriggers)
+{
+  allocate(ntriggers);
+}
+
+CrossingScalers::CrossingScalers(const CrossingScalers& other)
+{
+  *this = other;
+}
+
+CrossingScalers& CrossingScalers::operator=(const CrossingScalers& other)
+{
+  if (this == &other)
+  {
+    return *this;
+  }
+  allocate(other.m_ntrig);
+  for (unsigned int i = 0; i < m_ntrig * NBUNCHES; ++i)
+  {
+    m_counts[i].store(other.m_counts[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_scalers[i].store(other.m_scalers[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  return *this;
+}
+
+const std::string& CrossingScalers::TreeTitle()
+{
+  static const std::string title = "CrossingScalers";
+  return title;
+}
+
+void CrossingScalers::allocate(const unsigned int ntriggers)
+{
+  m_ntrig = ntriggers;
+  m_counts.reset(new std::atomic<uint64_t>[m_ntrig * NBUNCHES]);
+  m_scalers.reset(new std::atomic<uint64_t>[m_ntrig * NBUNCHES]);
+  reset();
+}
+
+void CrossingScalers::reset()
+{
+  for (unsigned int i = 0; i < m_ntrig * NBUNCHES; ++i)
+  {
+    m_counts[i].store(0, std::memory_order_relaxed);
+    m_scalers[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void CrossingScalers::update_scaler(const unsigned int trig, const unsigned int bunch, const uint64_t value)
+{
+  std::atomic<uint64_t>& stored = m_scalers[index(trig, bunch)];
+  uint64_t current = stored.load(std::memory_order_relaxed);
+  while (current < value && !stored.compare_exchange_weak(current, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+CrossingScalers::SpinState CrossingScalers::spin_state(const int bluespin, const int yellspin)
+{
+  if ((bluespin != 1 && bluespin != -1) || (yellspin != 1 && yellspin != -1))
+  {
+    return Other;
+  }
+  if (bluespin == 1)
+  {
+    return (yellspin == 1) ? PlusPlus : PlusMinus;
+  }
+  return (yellspin == 1) ? MinusPlus : MinusMinus;
+}
+
+void CrossingScalers::spin_sums(const unsigned int trig, const int bluespin[NBUNCHES], const int yellspin[NBUNCHES], const int xingshift,
+                                uint64_t sums[NSPINSTATES], const bool use_scalers) const
+{
+  for (int state = 0; state < NSPINSTATES; ++state)
+  {
+    sums[state] = 0;
+  }
+  if (trig >= m_ntrig)
+  {
+    return;
+  }
+
+  const int shift = ((xingshift % NBUNCHES) + NBUNCHES) % NBUNCHES;
+  for (int xing = 0; xing < NBUNCHES; ++xing)
+  {
+    const int bunch = (xing + shift) % NBUNCHES;
+    sums[spin_state(bluespin[bunch], yellspin[bunch])] += use_scalers ? scaler(trig, xing) : count(trig, xing);
+  }
+}
+
+bool CrossingScalers::merge(const CrossingScalers& other)
+{
+  if (other.m_ntrig != m_ntrig)
+  {
+    std::cout << PHWHERE << " number of triggers differ: " << m_ntrig << " vs " << other.m_ntrig << std::endl;
+    return false;
+  }
+  for (unsigned int trig = 0; trig < m_ntrig; ++trig)
+  {
+    for (unsigned int bunch = 0; bunch < NBUNCHES; ++bunch)
+    {
+      add(trig, bunch, other.count(trig, bunch));
+      update_scaler(trig, bunch, other.scaler(trig, bunch));
+    }
+  }
+  return true;
+}
+
+bool CrossingScalers::Write(TDirectory* dir, const std::string& name) const
+{
+  if (!dir)
+  {
+    std::cout << PHWHERE << " no output directory for " << name << std::endl;
+    return false;
+  }
+
+  TDirectory::TContext context(dir);
+  TTree* tree = new TTree(name.c_str(), TreeTitle().c_str());
+
+  // one entry per trigger
+  unsigned int ntriggers = m_ntrig;
+  unsigned int trig = 0;
+  ULong64_t counts[NBUNCHES] = {0};
+  ULong64_t scalers[NBUNCHES] = {0};
+  tree->Branch("ntrig", &ntriggers, "ntrig/i");
+  tree->Branch("trig", &trig, "trig/i");
+  tree->Branch("counts", counts, "counts[120]/l");
+  tree->Branch("scalers", scalers, "scalers[120]/l");
+
+  for (trig = 0; trig < m_ntrig; ++trig)
+  {
+    for (unsigned int bunch = 0; bunch < NBUNCHES; ++bunch)
+    {
+      counts[bunch] = count(trig, bunch);
+      scalers[bunch] = scaler(trig, bunch);
+    }
+    tree->Fill();
+  }
+
+  const bool status = tree->Write("", TObject::kOverwrite) > 0;
+  delete tree;
+  return status;
+}
+
+bool CrossingScalers::Read(TDirectory* dir, const std::string& name)
+{
+  TTree* tree = dir ? dynamic_cast<TTree*>(dir->Get(name.c_str())) : nullptr;
+  if (!tree || TreeTitle() != tree->GetTitle())
+  {
+    std::cout << PHWHERE << " no " << TreeTitle() << " tree " << name << " found" << std::endl;
+    return false;
+  }
+
+  unsigned int ntriggers = 0;
+  unsigned int trig = 0;
+  ULong64_t counts[NBUNCHES] = {0};
+  ULong64_t scalers[NBUNCHES] = {0};
+  tree->SetBranchAddress("ntrig", &ntriggers);
+  tree->SetBranchAddress("trig", &trig);
+  tree->SetBranchAddress("counts", counts);
+  tree->SetBranchAddress("scalers", scalers);
+
+  allocate(0);
+  bool status = true;
+  for (Long64_t entry = 0; entry < tree->GetEntries(); ++entry)
+  {
+    tree->GetEntry(entry);
+    if (entry == 0)
+    {
+      allocate(ntriggers);
+    }
+    if (trig >= m_ntrig)
+    {
+      std::cout << PHWHERE << " trigger " << trig << " out of range in " << name << std::endl;
+      status = false;
+      break;
+    }
+    for (unsigned int bunch = 0; bunch < NBUNCHES; ++bunch)
+    {
+      m_counts[index(trig, bunch)].store(counts[bunch], std::memory_order_relaxed);
+      m_scalers[index(trig, bunch)].store(scalers[bunch], std::memory_order_relaxed);
+    }
+  }
+
+  delete tree;
+  return status;
+}
@@ -0,0 +1,100 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef CHANSTATS_CROSSINGSCALERS_H
+#define CHANSTATS_CROSSINGSCALERS_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class TDirectory;
+
+/*! \class CrossingScalers
+    \brief per trigger, per bunch crossing counters for the spin calibrations
+
+    Two fixed size tables of ntrig x 120 bunches:
+    - counts, incremented with add(), e.g. number of events with a ZDC/SMD hit per crossing
+    - scalers, the latest value of a cumulative scaler (GL1P) with update_scaler()
+    Both are updated with relaxed atomic operations, so several input streams (threads)
+    can fill the same object. merge() sums the counts and keeps the largest scaler value,
+    the scalers being monotonic this is independent of the order in which events or jobs
+    are combined.
+
+    spin_sums() folds the crossings into the beam spin states for given spin patterns
+    and crossing shift.
+
+    Write() stores one TTree entry per trigger, the tree title tags the type for chanstats_merge.
+*/
+class CrossingScalers
+{
+ public:
+  static const int NBUNCHES = 120;
+
+  //! blue/yellow spin combinations, anything else (unfilled, unpolarized) goes to Other
+  enum SpinState
+  {
+    PlusPlus = 0,
+    PlusMinus,
+    MinusPlus,
+    MinusMinus,
+    Other,
+    NSPINSTATES
+  };
+
+  explicit CrossingScalers(const unsigned int ntriggers = 0);
+  CrossingScalers(const CrossingScalers& other);
+  CrossingScalers& operator=(const CrossingScalers& other);
+  virtual ~CrossingScalers() = default;
+
+  //! number of triggers
+  unsigned int ntrig() const { return m_ntrig; }
+
+  //! clear all counters
+  void reset();
+
+  //! increment the count of a trigger in a crossing
+  void add(const unsigned int trig, const unsigned int bunch, const uint64_t n = 1)
+  {
+    m_counts[index(trig, bunch)].fetch_add(n, std::memory_order_relaxed);
+  }
+
+  //! store the value of a cumulative scaler, the largest value is kept
+  void update_scaler(const unsigned int trig, const unsigned int bunch, const uint64_t value);
+
+  uint64_t count(const unsigned int trig, const unsigned int bunch) const { return m_counts[index(trig, bunch)].load(std::memory_order_relaxed); }
+  uint64_t scaler(const unsigned int trig, const unsigned int bunch) const { return m_scalers[index(trig, bunch)].load(std::memory_order_relaxed); }
+
+  //! spin state of a crossing from the blue and yellow spin (+1, -1, anything else for unpolarized)
+  static SpinState spin_state(const int bluespin, const int yellspin);
+
+  /*! sum the counts (or the scalers if use_scalers is true) of trigger trig per spin state.
+      The spin patterns are indexed by bunch, crossing number xing from GL1 is in bunch (xing + xingshift) % 120
+  */
+  void spin_sums(const unsigned int trig, const int bluespin[NBUNCHES], const int yellspin[NBUNCHES], const int xingshift,
+                 uint64_t sums[NSPINSTATES], const bool use_scalers = false) const;
+
+  //! add the content of another object. Returns false if the number of triggers differ
+  bool merge(const CrossingScalers& other);
+
+  //! write to a TTree called name in dir. Returns false on failure
+  bool Write(TDirectory* dir, const std::string& name) const;
+
+  //! replace the content with the TTree called name from dir. Returns false on failure
+  bool Read(TDirectory* dir, const std::string& name);
+
+  //! title of the TTree written by Write(), identifies the type when reading
+  static const std::string& TreeTitle();
+
+ private:
+  unsigned int index(const unsigned int trig, const unsigned int bunch) const { return trig * NBUNCHES + bunch; }
+
+  //! allocate and clear the tables for ntriggers triggers
+  void allocate(const unsigned int ntriggers);
+
+  unsigned int m_ntrig = 0;
+  std::unique_ptr<std::atomic<uint64_t>[]> m_counts;
+  std::unique_ptr<std::atomic<uint64_t>[]> m_scalers;
+};
+
+#endif  // CHANSTATS_CROSSINGSCALERS_H
@@ -0,0 +1,129 @@
+// merge ChannelMoments, ChannelHistogram and CrossingScalers trees from several files
+//
+// usage: chanstats_merge <output.root> <input.root> [<input.root> ...]
+//
+// All ChannelMoments, ChannelHistogram and CrossingScalers trees found in the top directory of the
+// input files are merged by name and written to the output file. The merge is associative,
+// the output of chanstats_merge can be merged again.
+
+#include "ChannelHistogram.h"
+#include "ChannelMoments.h"
+#include "CrossingScalers.h"
+
+#include <TFile.h>
+#include <TKey.h>
+#include <TList.h>
+#include <TTree.h>
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace
+{
+  //! read object of type T called name from file and merge it into the accumulator of the same name
+  template <class T>
+  bool merge_into(std::map<std::string, T>& accumulators, TFile* file, const std::string& name)
+  {
+    T input;
+    if (!input.Read(file, name))
+    {
+      return false;
+    }
+    auto iter = accumulators.find(name);
+    if (iter == accumulators.end())
+    {
+      accumulators.emplace(name, std::move(input));
+      return true;
+    }
+    return iter->second.merge(input);
+  }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    std::cout << "usage: " << argv[0] << " <output.root> <input.root> [<input.root> ...]" << std::endl;
+    return 1;
+  }
+
+  std::map<std::string, ChannelMoments> moments;
+  std::map<std::string, ChannelHistogram> histograms;
+  std::map<std::string, CrossingScalers> scalers;
+
+  for (int i = 2; i < argc; ++i)
+  {
+    std::unique_ptr<TFile> file(TFile::Open(argv[i], "READ"));
+    if (!file || file->IsZombie())
+    {
+      std::cout << argv[0] << " - cannot open " << argv[i] << std::endl;
+      return 1;
+    }
+
+    // only the highest cycle of each key
+    std::map<std::string, std::string> trees;
+    for (TObject* object : *file->GetListOfKeys())
+    {
+      TKey* key = static_cast<TKey*>(object);
+      if (std::string(key->GetClassName()) == "TTree")
+      {
+        trees[key->GetName()] = key->GetTitle();
+      }
+    }
+
+    for (const auto& [name, title] : trees)
+    {
+      bool status = true;
+      if (title == ChannelMoments::TreeTitle())
+      {
+        status = merge_into(moments, file.get(), name);
+      }
+      else if (title == ChannelHistogram::TreeTitle())
+      {
+        status = merge_into(histograms, file.get(), name);
+      }
+      else if (title == CrossingScalers::TreeTitle())
+      {
+        status = merge_into(scalers, file.get(), name);
+      }
+      else
+      {
+        continue;
+      }
+
+      if (!status)
+      {
+        std::cout << argv[0] << " - failed to merge " << name << " from " << argv[i] << std::endl;
+        return 1;
+      }
+    }
+  }
+
+  std::unique_ptr<TFile> output(TFile::Open(argv[1], "RECREATE"));
+  if (!output || output->IsZombie())
+  {
+    std::cout << argv[0] << " - cannot create " << argv[1] << std::endl;
+    return 1;
+  }
+
+  bool status = true;
+  for (const auto& [name, accumulator] : moments)
+  {
+    status &= accumulator.Write(output.get(), name);
+  }
+  for (const auto& [name, accumulator] : histograms)
+  {
+    status &= accumulator.Write(output.get(), name);
+  }
+  for (const auto& [name, accumulator] : scalers)
+  {
+    status &= accumulator.Write(output.get(), name);
+  }
+  output->Close();
+
+  std::cout << argv[0] << " - merged " << moments.size() << " ChannelMoments, "
+            << histograms.size() << " ChannelHistogram and " << scalers.size() << " CrossingScalers from " << argc - 2 << " files into " << argv[1] << std::endl;
+  return status ? 0 : 1;
+}
@@ -38,9 +38,6 @@ TPCPedestalCalibration::TPCPedestalCalibration(const std::string &name)
   {
     for(int channel_no=0;channel_no<256;channel_no++)
     {
-      m_aveADCFeeChannel[fee_no][channel_no]=0.0;
-      m_stdADCFeeChannel[fee_no][channel_no]=0.0;
-      m_countsADCFeeChannel[fee_no][channel_no]=0.0;
       m_aliveArrayFeeChannel[fee_no][channel_no]=1;
     }
   }
@@ -124,11 +121,7 @@ int TPCPedestalCalibration::process_event(PHCompositeNode *topNode)
       }
       if (dead) {continue;}
 
-      for(int adc_sam_no=0;adc_sam_no<m_nSamples;adc_sam_no++){
-        m_aveADCFeeChannel[m_fee][m_Channel]+=m_adcSamples[adc_sam_no];
-        m_stdADCFeeChannel[m_fee][m_Channel]+=pow(m_adcSamples[adc_sam_no],2);
-        m_countsADCFeeChannel[m_fee][m_Channel]+=1.0;
-      }
+      m_adcStats.fill(m_fee*256 + m_Channel, m_adcSamples.data(), m_nSamples);
     }
   }  //   for (int packet : m_packets)
 
@@ -143,43 +136,43 @@ int TPCPedestalCalibration::EndRun(const int runnumber)
   {
     for(int channel_no=0;channel_no<256;channel_no++)
     {
-      if(m_countsADCFeeChannel[fee_no][channel_no] != 0.0)
-      {
-        float temp1 = m_aveADCFeeChannel[fee_no][channel_no]/m_countsADCFeeChannel[fee_no][channel_no];
-        float temp2 = m_stdADCFeeChannel[fee_no][channel_no]/m_countsADCFeeChannel[fee_no][channel_no];
-        m_aveADCFeeChannel[fee_no][channel_no] = temp1;
-        m_stdADCFeeChannel[fee_no][channel_no] = temp2;
-      }
-      else
+      const int index = fee_no*256 + channel_no;
+      if(m_adcStats.count(index) == 0)
       {
-        m_aveADCFeeChannel[fee_no][channel_no] = 0.0;
-        m_stdADCFeeChannel[fee_no][channel_no] = 0.0;
         m_aliveArrayFeeChannel[fee_no][channel_no]=0;
       }
 
-      if(m_aveADCFeeChannel[fee_no][channel_no] > 200 || m_aveADCFeeChannel[fee_no][channel_no] < 10)
+      m_pedMean=m_adcStats.mean(index);
+      m_pedStd=m_adcStats.rms(index);
+
+      if(m_pedMean > 200 || m_pedMean < 10)
       {
         m_aliveArrayFeeChannel[fee_no][channel_no]=0;
       }
       
-      m_pedMean=m_aveADCFeeChannel[fee_no][channel_no];
-      m_pedStd=sqrt(m_stdADCFeeChannel[fee_no][channel_no] - pow(m_aveADCFeeChannel[fee_no][channel_no],2));
       m_isAlive=m_aliveArrayFeeChannel[fee_no][channel_no];
       m_chan=channel_no;
       m_outFEE=fee_no;
       m_module=mod_arr[fee_no];
       m_slot=slot_arr[fee_no];
       
-      m_cdbttree->SetIntValue(fee_no*256 + channel_no,"isAlive",m_isAlive);
-      m_cdbttree->SetFloatValue(fee_no*256 + channel_no,"pedMean",m_pedMean);
-      m_cdbttree->SetFloatValue(fee_no*256 + channel_no,"pedStd",m_pedStd);
-      m_cdbttree->SetIntValue(fee_no*256 + channel_no,"sector",m_sector);
-      m_cdbttree->SetIntValue(fee_no*256 + channel_no,"fee",m_outFEE);
-      m_cdbttree->SetIntValue(fee_no*256 + channel_no,"channel",m_chan);
-      m_cdbttree->SetIntValue(fee_no*256 + channel_no,"module",m_module);
-      m_cdbttree->SetIntValue(fee_no*256 + channel_no,"slot",m_slot);
+      m_cdbttree->SetIntValue(index,"isAlive",m_isAlive);
+      m_cdbttree->SetFloatValue(index,"pedMean",m_pedMean);
+      m_cdbttree->SetFloatValue(index,"pedStd",m_pedStd);
+      m_cdbttree->SetIntValue(index,"sector",m_sector);
+      m_cdbttree->SetIntValue(index,"fee",m_outFEE);
+      m_cdbttree->SetIntValue(index,"channel",m_chan);
+      m_cdbttree->SetIntValue(index,"module",m_module);
+      m_cdbttree->SetIntValue(index,"slot",m_slot);
     }
   }
+
+  if (!m_statsfname.empty())
+  {
+    TFile statsfile(m_statsfname.c_str(), "RECREATE");
+    m_adcStats.Write(&statsfile, "TPCPedestalADC_sector" + std::to_string(m_sector));
+    statsfile.Close();
+  }
   
   return Fun4AllReturnCodes::EVENT_OK;
 }
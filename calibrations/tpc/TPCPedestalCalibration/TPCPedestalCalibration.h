@@ -7,6 +7,8 @@
 #include <cdbobjects/CDBTTree.h>
 #include <sphenixnpc/CDBUtils.h>
 
+#include <chanstats/ChannelMoments.h>
+
 #include <string>
 #include <vector>
 
@@ -47,6 +49,12 @@ class TPCPedestalCalibration : public SubsysReco
     m_username = username; 
   }
 
+  //! also write the per channel ADC moments to this file, they can be merged across jobs with chanstats_merge
+  void WriteChannelStats(const std::string &filename)
+  {
+    m_statsfname = filename;
+  }
+
   void NewCDBGlobalTag(std::string username)
   {
     CDBUtils *uti = new CDBUtils();
@@ -70,11 +78,12 @@ class TPCPedestalCalibration : public SubsysReco
   int m_Channel = 0;
   std::vector<unsigned short> m_adcSamples; 
 
-  float m_aveADCFeeChannel[26][256]{};
-  float m_stdADCFeeChannel[26][256]{};
-  float m_countsADCFeeChannel[26][256]{};
+  //! ADC moments, channel index is fee*256 + channel
+  ChannelMoments m_adcStats{26 * 256};
   int m_aliveArrayFeeChannel[26][256]{};
 
+  std::string m_statsfname;
+
   std::string m_username = "test";
   bool m_firstBCO = true;
   int m_isAlive = 1;
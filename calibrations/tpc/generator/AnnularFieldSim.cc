@@ -3,6 +3,7 @@
 #include "AnalyticFieldModel.h"
 #include "ChargeMapReader.h"
 #include "MultiArray.h"  //for TH3 alternative
+#include "MultiArrayVector3.h"
 #include "Rossegger.h"
 
 #include <TCanvas.h>
@@ -18,14 +19,44 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
 #include <cassert>  // for assert
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #define ALMOST_ZERO 0.00001
 
+namespace
+{
+  // identifies (and versions) the binary lookup cache
+  const char lookup_cache_magic[8] = {'A', 'F', 'S', 'L', 'U', 'T', '0', '1'};
+
+  // run f(ithread,nthreads) on nthreads threads, the calling thread being thread zero, and wait for all of them.
+  template <class F>
+  void run_parallel(int nthreads, F &&f)
+  {
+    nthreads = std::max(nthreads, 1);
+    std::vector<std::thread> threads;
+    threads.reserve(nthreads - 1);
+    for (int ithread = 1; ithread < nthreads; ithread++)
+    {
+      threads.emplace_back(f, ithread, nthreads);
+    }
+    f(0, nthreads);
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+    return;
+  }
+}  // namespace
+
 AnnularFieldSim::AnnularFieldSim(float in_innerRadius, float in_outerRadius, float in_outerZ,
                                  int r, int roi_r0, int roi_r1, int /*in_rLowSpacing*/, int /*in_rHighSize*/,
                                  int phi, int roi_phi0, int roi_phi1, int /*in_phiLowSpacing*/, int /*in_phiHighSize*/,
@@ -166,20 +197,13 @@ AnnularFieldSim::AnnularFieldSim(float in_innerRadius, float in_outerRadius, flo
   {
     std::cout << boost::str(boost::format("AnnularFieldSim::AnnularFieldSim building Epartial (full3D) with  nr_roi=%d nphi_roi=%d nz_roi=%d  =~%2.2fM TVector3 objects") % nr_roi % nphi_roi % nz_roi % (nr_roi * nphi_roi * nz_roi * nr * nphi * nz / (1.0e6))) << std::endl;
 
-    Epartial = new MultiArray<TVector3>(nr_roi, nphi_roi, nz_roi, nr, nphi, nz);
-    for (int i = 0; i < Epartial->Length(); i++)
-    {
-      Epartial->GetFlat(i)->SetXYZ(0, 0, 0);
-    }
+    Epartial = new MultiArrayVector3(nr_roi, nphi_roi, nz_roi, nr, nphi, nz);  // zeroed on construction
     // and kill the arrays we shouldn't be using:
-    Epartial_highres = new MultiArray<TVector3>(1);
-    Epartial_highres->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial_highres = new MultiArrayVector3(1);
 
-    Epartial_lowres = new MultiArray<TVector3>(1);
-    Epartial_lowres->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial_lowres = new MultiArrayVector3(1);
 
-    Epartial_phislice = new MultiArray<TVector3>(1);
-    Epartial_phislice->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial_phislice = new MultiArrayVector3(1);
     q_lowres = new MultiArray<double>(1);
     *(q_lowres->GetFlat(0)) = 0;
     q_local = new MultiArray<double>(1);
@@ -189,29 +213,20 @@ AnnularFieldSim::AnnularFieldSim(float in_innerRadius, float in_outerRadius, flo
   {
     std::cout << "lookupCase==HybridRes" << std::endl;
     // zero out the other two:
-    Epartial = new MultiArray<TVector3>(1);
-    Epartial->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial = new MultiArrayVector3(1);
 
-    Epartial_phislice = new MultiArray<TVector3>(1);
-    Epartial_phislice->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial_phislice = new MultiArrayVector3(1);
   }
   else if (lookupCase == PhiSlice)
   {
     std::cout << "lookupCase==PhiSlice" << std::endl;
 
-    Epartial_phislice = new MultiArray<TVector3>(nr_roi, 1, nz_roi, nr, nphi, nz);
-    for (int i = 0; i < Epartial_phislice->Length(); i++)
-    {
-      Epartial_phislice->GetFlat(i)->SetXYZ(0, 0, 0);
-    }
+    Epartial_phislice = new MultiArrayVector3(nr_roi, 1, nz_roi, nr, nphi, nz);  // zeroed on construction
     // zero out the other two:
-    Epartial = new MultiArray<TVector3>(1);
-    Epartial->GetFlat(0)->SetXYZ(0, 0, 0);
-    Epartial_highres = new MultiArray<TVector3>(1);
-    Epartial_highres->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial = new MultiArrayVector3(1);
+    Epartial_highres = new MultiArrayVector3(1);
 
-    Epartial_lowres = new MultiArray<TVector3>(1);
-    Epartial_lowres->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial_lowres = new MultiArrayVector3(1);
 
     q_lowres = new MultiArray<double>(1);
     *(q_lowres->GetFlat(0)) = 0;
@@ -223,17 +238,13 @@ AnnularFieldSim::AnnularFieldSim(float in_innerRadius, float in_outerRadius, flo
     std::cout << "lookupCase==Analytic (or NoLookup)" << std::endl;
 
     // zero them all out:
-    Epartial_phislice = new MultiArray<TVector3>(1);
-    Epartial_phislice->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial_phislice = new MultiArrayVector3(1);
 
-    Epartial = new MultiArray<TVector3>(1);
-    Epartial->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial = new MultiArrayVector3(1);
 
-    Epartial_highres = new MultiArray<TVector3>(1);
-    Epartial_highres->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial_highres = new MultiArrayVector3(1);
 
-    Epartial_lowres = new MultiArray<TVector3>(1);
-    Epartial_lowres->GetFlat(0)->SetXYZ(0, 0, 0);
+    Epartial_lowres = new MultiArrayVector3(1);
 
     q_lowres = new MultiArray<double>(1);
     *(q_lowres->GetFlat(0)) = 0;
@@ -1329,29 +1340,48 @@ void AnnularFieldSim::populate_fieldmap()
   unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << boost::str(boost::format("total elements = %llu") % (totalelements * nr * nphi * nz)) << std::endl;
 
-  int el = 0;
+  // the hybrid lookup sums through a shared q_local holder, and the analytic model is not thread-safe, so those stay on one thread.
+  int nthreads_used = nthreads;
+  if (lookupCase == HybridRes || lookupCase == Analytic)
+  {
+    nthreads_used = 1;
+  }
+  if (nthreads_used > 1)
+  {
+    std::cout << boost::str(boost::format("populating fieldmap using %d threads") % nthreads_used) << std::endl;
+  }
 
-  TVector3 localF;  // holder for the summed field at the current position.
-  for (int ir = rmin_roi; ir < rmax_roi; ir++)
+  // target cells are dealt out to the threads in turn.  Each cell is written by exactly one thread.
+  // thread zero reports progress for everyone.
+  auto populate = [&](int ithread, int nthreads_local)
   {
-    for (int iphi = phimin_roi; iphi < phimax_roi; iphi++)
+    unsigned long long percent_local = std::max(percent / nthreads_local, 1ULL);
+    unsigned long long el = 0;
+    TVector3 localF;  // holder for the summed field at the current position.
+    for (unsigned long long i = ithread; i < totalelements; i += nthreads_local)
     {
-      for (int iz = zmin_roi; iz < zmax_roi; iz++)
+      int iz = zmin_roi + i % nz_roi;
+      int iphi = phimin_roi + (i / nz_roi) % nphi_roi;
+      int ir = rmin_roi + i / (nz_roi * nphi_roi);
+      if (nthreads_local > 1)
+      {
+        localF = sum_field_at_quiet(ir, iphi, iz);  // asks in global coordinates
+      }
+      else
       {
         localF = sum_field_at(ir, iphi, iz);  // asks in global coordinates
-        if (!(el % percent))
-        {
-          std::cout << boost::str(boost::format("populate_fieldmap %llu%%:  ") % ((uint64_t) (debug_npercent) *el / percent));
-          std::cout << boost::str(boost::format("sum_field_at (ir=%d,iphi=%d,iz=%d) gives (%E,%E,%E)") % ir % iphi % iz % localF.X() % localF.Y() % localF.Z()) << std::endl;
-        }
-        el++;
-
-        Efield->Set(ir - rmin_roi, iphi - phimin_roi, iz - zmin_roi, localF);  // sets in roi coordinates.
-                                                                               // if (localF.Mag()>1e-9)
-                                                                               // if(debugFlag()) print_need_cout("%d: AnnularFieldSim::populate_fieldmap fieldmap@ (%d,%d,%d) mag=%f\n",__LINE__,ir,iphi,iz,localF.Mag());
       }
+      if (ithread == 0 && !(el % percent_local))
+      {
+        std::cout << boost::str(boost::format("populate_fieldmap %llu%%:  ") % ((uint64_t) (debug_npercent) *el / percent_local));
+        std::cout << boost::str(boost::format("sum_field_at (ir=%d,iphi=%d,iz=%d) gives (%E,%E,%E)") % ir % iphi % iz % localF.X() % localF.Y() % localF.Z()) << std::endl;
+      }
+      el++;
+
+      Efield->Set(ir - rmin_roi, iphi - phimin_roi, iz - zmin_roi, localF);  // sets in roi coordinates.
     }
-  }
+  };
+  run_parallel(nthreads_used, populate);
   return;
 }
 
@@ -1408,54 +1438,56 @@ void AnnularFieldSim::populate_full3d_lookup()
   totalelements *= nz;  // breaking up this multiplication prevents a 32bit math overflow
   unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << boost::str(boost::format("total elements = %llu") % totalelements) << std::endl;
-  TVector3 at(1, 0, 0);
-  TVector3 from(1, 0, 0);
   TVector3 zero(0, 0, 0);
 
-  int el = 0;
-  for (int ifr = rmin_roi; ifr < rmax_roi; ifr++)
+  // target cells are dealt out to the threads in turn.  Each target cell is written by exactly one thread.
+  const int ntargets = (rmax_roi - rmin_roi) * (phimax_roi - phimin_roi) * (zmax_roi - zmin_roi);
+  auto populate = [&](int ithread, int nthreads_local)
   {
-    for (int ifphi = phimin_roi; ifphi < phimax_roi; ifphi++)
+    TVector3 at(1, 0, 0);
+    TVector3 from(1, 0, 0);
+    unsigned long long percent_local = std::max(percent / nthreads_local, 1ULL);
+    unsigned long long el = 0;
+    for (int itarget = ithread; itarget < ntargets; itarget += nthreads_local)
     {
-      for (int ifz = zmin_roi; ifz < zmax_roi; ifz++)
+      int ifz = zmin_roi + itarget % (zmax_roi - zmin_roi);
+      int ifphi = phimin_roi + (itarget / (zmax_roi - zmin_roi)) % (phimax_roi - phimin_roi);
+      int ifr = rmin_roi + itarget / ((zmax_roi - zmin_roi) * (phimax_roi - phimin_roi));
+      at = GetCellCenter(ifr, ifphi, ifz);
+      for (int ior = 0; ior < nr; ior++)
       {
-        at = GetCellCenter(ifr, ifphi, ifz);
-        for (int ior = 0; ior < nr; ior++)
+        for (int iophi = 0; iophi < nphi; iophi++)
         {
-          for (int iophi = 0; iophi < nphi; iophi++)
+          for (int ioz = 0; ioz < nz; ioz++)
           {
-            for (int ioz = 0; ioz < nz; ioz++)
+            el++;
+            if (ithread == 0 && !(el % percent_local))
             {
-              el++;
-              if (!(el % percent))
-              {
-                std::cout << boost::str(boost::format("populate_full3d_lookup %d%%") % ((uint64_t) (debug_npercent) *el / percent)) << std::endl;
-              }
-              from = GetCellCenter(ior, iophi, ioz);
+              std::cout << boost::str(boost::format("populate_full3d_lookup %d%%") % ((uint64_t) (debug_npercent) *el / percent_local)) << std::endl;
+            }
+            from = GetCellCenter(ior, iophi, ioz);
 
-              //*f[ifx][ify][ifz][iox][ioy][ioz]=cacl_unit_field(at,from);
-              // print_need_cout("calc_unit_field...\n");
-              if (ifr == ior && ifphi == iophi && ifz == ioz)
-              {
-                Epartial->Set(ifr - rmin_roi, ifphi - phimin_roi, ifz - zmin_roi, ior, iophi, ioz, zero);
-              }
-              else
-              {
-                Epartial->Set(ifr - rmin_roi, ifphi - phimin_roi, ifz - zmin_roi, ior, iophi, ioz, calc_unit_field(at, from));
-              }
+            //*f[ifx][ify][ifz][iox][ioy][ioz]=cacl_unit_field(at,from);
+            // print_need_cout("calc_unit_field...\n");
+            if (ifr == ior && ifphi == iophi && ifz == ioz)
+            {
+              Epartial->Set(ifr - rmin_roi, ifphi - phimin_roi, ifz - zmin_roi, ior, iophi, ioz, zero);
+            }
+            else
+            {
+              Epartial->Set(ifr - rmin_roi, ifphi - phimin_roi, ifz - zmin_roi, ior, iophi, ioz, calc_unit_field(at, from));
             }
           }
         }
       }
     }
-  }
+  };
+  run_parallel(nthreads, populate);
   return;
 }
 
 void AnnularFieldSim::populate_highres_lookup()
 {
-  TVector3 at(1, 0, 0);
-  TVector3 from(1, 0, 0);
   TVector3 zero(0, 0, 0);
 
   // populate_highres_lookup();
@@ -1463,261 +1495,289 @@ void AnnularFieldSim::populate_highres_lookup()
   int phi_highres_dist = (nphi_high - 1) / 2;
   int z_highres_dist = (nz_high - 1) / 2;
 
-  // number of fbins contained in the 26 weirdly-shaped edge regions (and one center region which we won't use)
-  static int nfbinsin[3][3][3];
-  for (auto &i : nfbinsin)
-  {
-    for (auto &j : i)
-    {
-      for (int &k : j)
-      {
-        k = 0;  // we could count total volume, but without knowing the charge prior, it's not clear that'd be /better/
-      }
-    }
-  }
-
   // todo: if this runs too slowly, I can do geometry instead of looping over all the cells that are possibly in range
 
-  // loop over all the f-bins in the roi:
-  TVector3 currentf, newf;  // the averaged field vector without, and then with the new contribution from the f-bin being considered.
-  for (int ifr = rmin_roi; ifr < rmax_roi; ifr++)
+  // call f(ir,phiFilt,iz,rbin,phibin,zbin,rcell,phicell,zcell) for every f-bin in the l-bins around the f-bin (ifr,ifphi,ifz) of the roi
+  auto for_each_fbin = [&](int ifr, int ifphi, int ifz, auto &&f)
   {
     int r_parentlow = floor((ifr - r_highres_dist) / (r_spacing * 1.0));       // l-bin partly enclosed in our high-res region
     int r_parenthigh = floor((ifr + r_highres_dist) / (r_spacing * 1.0)) + 1;  // definitely not enclosed in our high-res region
     int r_startpoint = r_parentlow * r_spacing;                                // the first f-bin of the lowest-r f-bin that our h-region touches.  COuld be less than zero.
     int r_endpoint = r_parenthigh * r_spacing;                                 // the first f-bin of the lowest-r l-bin after that that our h-region does not touch.  could be larger than max.
 
-    for (int ifphi = phimin_roi; ifphi < phimax_roi; ifphi++)
+    int phi_parentlow = floor(FilterPhiIndex(ifphi - phi_highres_dist) / (phi_spacing * 1.0));  // note this may have wrapped around
+    bool phi_parentlow_wrapped = (ifphi - phi_highres_dist < 0);
+    int phi_startpoint = phi_parentlow * phi_spacing;  // the first f-bin of the lowest-z f-bin that our h-region touches.
+    if (phi_parentlow_wrapped)
+    {
+      phi_startpoint -= nphi;  // if we wrapped, re-wrap us so we're negative again
+    }
+
+    int phi_parenthigh = floor(FilterPhiIndex(ifphi + phi_highres_dist) / (phi_spacing * 1.0)) + 1;  // note that this may have wrapped around
+    bool phi_parenthigh_wrapped = (ifphi + phi_highres_dist >= nphi);
+    int phi_endpoint = phi_parenthigh * phi_spacing;
+    if (phi_parenthigh_wrapped)
     {
-      int phi_parentlow = floor(FilterPhiIndex(ifphi - phi_highres_dist) / (phi_spacing * 1.0));  // note this may have wrapped around
-      bool phi_parentlow_wrapped = (ifphi - phi_highres_dist < 0);
-      int phi_startpoint = phi_parentlow * phi_spacing;  // the first f-bin of the lowest-z f-bin that our h-region touches.
-      if (phi_parentlow_wrapped)
+      phi_endpoint += nphi;  // if we wrapped, re-wrap us so we're larger than nphi again.  We use these relative coords to determine the position relative to the center of our h-region.
+    }
+
+    int z_parentlow = floor((ifz - z_highres_dist) / (z_spacing * 1.0));
+    int z_parenthigh = floor((ifz + z_highres_dist) / (z_spacing * 1.0)) + 1;
+    int z_startpoint = z_parentlow * z_spacing;  // the first f-bin of the lowest-z f-bin that our h-region touches.
+    int z_endpoint = z_parenthigh * z_spacing;   // the first f-bin of the lowest-z l-bin after that that our h-region does not touch.
+
+    // note we automatically skip f-bins that would've been out of the valid overall volume.
+    for (int ir = r_startpoint; ir < r_endpoint; ir++)
+    {
+      // skip parts that are out of range:
+      // could speed this up by moving this into the definition of start and endpoint.
+      if (ir < 0)
       {
-        phi_startpoint -= nphi;  // if we wrapped, re-wrap us so we're negative again
+        ir = 0;
+      }
+      if (ir >= nr)
+      {
+        break;
       }
 
-      int phi_parenthigh = floor(FilterPhiIndex(ifphi + phi_highres_dist) / (phi_spacing * 1.0)) + 1;  // note that this may have wrapped around
-      bool phi_parenthigh_wrapped = (ifphi + phi_highres_dist >= nphi);
-      int phi_endpoint = phi_parenthigh * phi_spacing;
-      if (phi_parenthigh_wrapped)
+      int rbin = (ir - ifr) + r_highres_dist;  // zeroth bin when we're at max distance below, etc.
+      int rcell = 1;
+      if (rbin <= 0)
+      {
+        rbin = 0;
+        rcell = 0;
+      }
+      if (rbin >= nr_high)
       {
-        phi_endpoint += nphi;  // if we wrapped, re-wrap us so we're larger than nphi again.  We use these relative coords to determine the position relative to the center of our h-region.
+        rbin = nr_high - 1;
+        rcell = 2;
       }
 
-      for (int ifz = zmin_roi; ifz < zmax_roi; ifz++)
+      for (int iphi = phi_startpoint; iphi < phi_endpoint; iphi++)
       {
-        // if(debugFlag()) print_need_cout("%d: AnnularFieldSim::populate_highres_lookup icell=(%d,%d,%d)\n",__LINE__,ifr,ifphi,ifz);
-
-        int z_parentlow = floor((ifz - z_highres_dist) / (z_spacing * 1.0));
-        int z_parenthigh = floor((ifz + z_highres_dist) / (z_spacing * 1.0)) + 1;
-        int z_startpoint = z_parentlow * z_spacing;  // the first f-bin of the lowest-z f-bin that our h-region touches.
-        int z_endpoint = z_parenthigh * z_spacing;   // the first f-bin of the lowest-z l-bin after that that our h-region does not touch.
-
-        // our 'at' position, in global coords:
-        at = GetCellCenter(ifr, ifphi, ifz);
-        // define the farthest-away parent l-bin cells we're dealing with here:
-        // note we're still in absolute coordinates
-
-        // for every f-bin in the l-bins we're dealing with, figure out which relative highres bin it's in, and average the field vector into that bin's vector
-        // note most of these relative bins have exactly one f-bin in them.  It's only the edges that can get more.
-        // note this is a running average:  Anew=(Aold*Nold+V)/(Nold+1) and so on.
-        // note also that we automatically skip f-bins that would've been out of the valid overall volume.
-        for (int ir = r_startpoint; ir < r_endpoint; ir++)
+        // no phi out-of-range checks since it's circular, but we provide ourselves a filtered version:
+        int phiFilt = FilterPhiIndex(iphi);
+        int phibin = (iphi - ifphi) + phi_highres_dist;
+        int phicell = 1;
+        if (phibin <= 0)
+        {
+          phibin = 0;
+          phicell = 0;
+        }
+        if (phibin >= nphi_high)
         {
-          // skip parts that are out of range:
-          // could speed this up by moving this into the definition of start and endpoint.
-          if (ir < 0)
+          phibin = nphi_high - 1;
+          phicell = 2;
+        }
+        for (int iz = z_startpoint; iz < z_endpoint; iz++)
+        {
+          if (iz < 0)
           {
-            ir = 0;
+            iz = 0;
           }
-          if (ir >= nr)
+          if (iz >= nz)
           {
             break;
           }
-
-          int rbin = (ir - ifr) + r_highres_dist;  // zeroth bin when we're at max distance below, etc.
-          int rcell = 1;
-          if (rbin <= 0)
+          int zbin = (iz - ifz) + z_highres_dist;
+          int zcell = 1;
+          if (zbin <= 0)
           {
-            rbin = 0;
-            rcell = 0;
+            zbin = 0;
+            zcell = 0;
           }
-          if (rbin >= nr_high)
+          if (zbin >= nz_high)
           {
-            rbin = nr_high - 1;
-            rcell = 2;
+            zbin = nz_high - 1;
+            zcell = 2;
           }
+          f(ir, phiFilt, iz, rbin, phibin, zbin, rcell, phicell, zcell);
+        }
+      }
+    }
+  };
+
+  // number of fbins contained in the 26 weirdly-shaped edge regions (and one center region which we won't use)
+  // the edge bins hold a running average:  Anew=(Aold*Nold+V)/(Nold+1), where N counts the f-bins seen so far
+  // over all the f-bins of the roi, visited in (r,phi,z) order.
+  // We could count total volume, but without knowing the charge prior, it's not clear that'd be /better/
+  // To spread the f-bins of the roi over threads, we first count how many f-bins each one adds to each region,
+  // which gives every f-bin of the roi the counts it starts from.
+  const int ntargets = nr_roi * nphi_roi * nz_roi;
+  std::vector<int> nfbinsin(static_cast<size_t>(ntargets) * 27, 0);
+  auto count = [&](int ithread, int nthreads_local)
+  {
+    for (int itarget = ithread; itarget < ntargets; itarget += nthreads_local)
+    {
+      int ifz = zmin_roi + itarget % nz_roi;
+      int ifphi = phimin_roi + (itarget / nz_roi) % nphi_roi;
+      int ifr = rmin_roi + itarget / (nz_roi * nphi_roi);
+      int *n_target = &nfbinsin[static_cast<size_t>(itarget) * 27];
+      for_each_fbin(ifr, ifphi, ifz, [n_target](int, int, int, int, int, int, int rcell, int phicell, int zcell)
+                    { n_target[(rcell * 3 + phicell) * 3 + zcell]++; });
+    }
+  };
+  run_parallel(nthreads, count);
+
+  // turn the counts into the counts before each f-bin of the roi
+  int nsum[27] = {0};
+  for (int itarget = 0; itarget < ntargets; itarget++)
+  {
+    int *n_target = &nfbinsin[static_cast<size_t>(itarget) * 27];
+    for (int icell = 0; icell < 27; icell++)
+    {
+      int n = n_target[icell];
+      n_target[icell] = nsum[icell];
+      nsum[icell] += n;
+    }
+  }
 
-          for (int iphi = phi_startpoint; iphi < phi_endpoint; iphi++)
+  // loop over all the f-bins in the roi.  Each one is written by exactly one thread.
+  auto populate = [&](int ithread, int nthreads_local)
+  {
+    TVector3 at(1, 0, 0);
+    TVector3 from(1, 0, 0);
+    TVector3 currentf, newf;  // the averaged field vector without, and then with the new contribution from the f-bin being considered.
+    for (int itarget = ithread; itarget < ntargets; itarget += nthreads_local)
+    {
+      int ifz = zmin_roi + itarget % nz_roi;
+      int ifphi = phimin_roi + (itarget / nz_roi) % nphi_roi;
+      int ifr = rmin_roi + itarget / (nz_roi * nphi_roi);
+      int *n_target = &nfbinsin[static_cast<size_t>(itarget) * 27];
+
+      // our 'at' position, in global coords:
+      at = GetCellCenter(ifr, ifphi, ifz);
+      // coordinates relative to the region of interest:
+      int ir_rel = ifr - rmin_roi;
+      int iphi_rel = ifphi - phimin_roi;
+      int iz_rel = ifz - zmin_roi;
+
+      // for every f-bin in the l-bins we're dealing with, figure out which relative highres bin it's in, and average the field vector into that bin's vector
+      // note most of these relative bins have exactly one f-bin in them.  It's only the edges that can get more.
+      for_each_fbin(ifr, ifphi, ifz, [&](int ir, int phiFilt, int iz, int rbin, int phibin, int zbin, int rcell, int phicell, int zcell)
+                    {
+        //'from' is in absolute coordinates
+        from = GetCellCenter(ir, phiFilt, iz);
+
+        int nf = ++n_target[(rcell * 3 + phicell) * 3 + zcell];
+        if (zcell != 1 || rcell != 1 || phicell != 1)
+        {
+          // we're not in the center, so deal with our weird shapes by averaging:
+          // but Epartial is in coordinates relative to the roi
+          if (iphi_rel < 0)
           {
-            // no phi out-of-range checks since it's circular, but we provide ourselves a filtered version:
-            int phiFilt = FilterPhiIndex(iphi);
-            int phibin = (iphi - ifphi) + phi_highres_dist;
-            int phicell = 1;
-            if (phibin <= 0)
-            {
-              phibin = 0;
-              phicell = 0;
-            }
-            if (phibin >= nphi_high)
-            {
-              phibin = nphi_high - 1;
-              phicell = 2;
-            }
-            for (int iz = z_startpoint; iz < z_endpoint; iz++)
-            {
-              if (iz < 0)
-              {
-                iz = 0;
-              }
-              if (iz >= nz)
-              {
-                break;
-              }
-              int zbin = (iz - ifz) + z_highres_dist;
-              int zcell = 1;
-              if (zbin <= 0)
-              {
-                zbin = 0;
-                zcell = 0;
-              }
-              if (zbin >= nz_high)
-              {
-                zbin = nz_high - 1;
-                zcell = 2;
-              }
-              //'from' is in absolute coordinates
-              from = GetCellCenter(ir, phiFilt, iz);
-
-              nfbinsin[rcell][phicell][zcell]++;
-              int nf = nfbinsin[rcell][phicell][zcell];
-              // coordinates relative to the region of interest:
-              int ir_rel = ifr - rmin_roi;
-              int iphi_rel = ifphi - phimin_roi;
-              int iz_rel = ifz - zmin_roi;
-              if (zcell != 1 || rcell != 1 || phicell != 1)
-              {
-                // we're not in the center, so deal with our weird shapes by averaging:
-                // but Epartial is in coordinates relative to the roi
-                if (iphi_rel < 0)
-                {
-                  std::cout << boost::str(boost::format("%d: Getting with phi=%d") % __LINE__ % iphi_rel) << std::endl;
-                }
-                currentf = Epartial_highres->Get(ir_rel, iphi_rel, iz_rel, rbin, phibin, zbin);
-                // to keep this as the average, we multiply what's there back to its initial summed-but-not-divided value
-                // then add our new value, and the divide the new sum by the total number of cells
-                newf = (currentf * (nf - 1) + calc_unit_field(at, from)) * (1 / (nf * 1.0));
-                Epartial_highres->Set(ir_rel, iphi_rel, iz_rel, rbin, phibin, zbin, newf);
-              }
-              else
-              {
-                // we're in the center cell, which means any f-bin that's not on the outer edge of our region:
-                // calc_unit_field will return zero when at=from, so the center will be automatically zero here.
-                if (ifr == rbin && ifphi == phibin && ifz == zbin)
-                {
-                  Epartial_highres->Set(ir_rel, iphi_rel, iz_rel, rbin, phibin, zbin, zero);
-                }
-                else
-                {  // for extra carefulness, only calc the field if it's not self-to-self.
-                  newf = calc_unit_field(at, from);
-                  Epartial_highres->Set(ir_rel, iphi_rel, iz_rel, rbin, phibin, zbin, newf);
-                }
-              }
-            }
+            std::cout << boost::str(boost::format("%d: Getting with phi=%d") % __LINE__ % iphi_rel) << std::endl;
           }
+          currentf = Epartial_highres->Get(ir_rel, iphi_rel, iz_rel, rbin, phibin, zbin);
+          // to keep this as the average, we multiply what's there back to its initial summed-but-not-divided value
+          // then add our new value, and the divide the new sum by the total number of cells
+          newf = (currentf * (nf - 1) + calc_unit_field(at, from)) * (1 / (nf * 1.0));
+          Epartial_highres->Set(ir_rel, iphi_rel, iz_rel, rbin, phibin, zbin, newf);
         }
-      }
+        else
+        {
+          // we're in the center cell, which means any f-bin that's not on the outer edge of our region:
+          // calc_unit_field will return zero when at=from, so the center will be automatically zero here.
+          if (ifr == rbin && ifphi == phibin && ifz == zbin)
+          {
+            Epartial_highres->Set(ir_rel, iphi_rel, iz_rel, rbin, phibin, zbin, zero);
+          }
+          else
+          {  // for extra carefulness, only calc the field if it's not self-to-self.
+            newf = calc_unit_field(at, from);
+            Epartial_highres->Set(ir_rel, iphi_rel, iz_rel, rbin, phibin, zbin, newf);
+          }
+        } });
     }
-  }
+  };
+  run_parallel(nthreads, populate);
   return;
 }
 
 void AnnularFieldSim::populate_lowres_lookup()
 {
-  TVector3 at(1, 0, 0);
-  TVector3 from(1, 0, 0);
   TVector3 zero(0, 0, 0);
-  int fphi_low, fphi_high, fz_low, fz_high;             // edges of the outer l-bin
-  int r_low, r_high, phi_low, phi_high, z_low, z_high;  // edges of the inner l-bin
+
+  // target l-bins are dealt out to the threads in turn.  Each target l-bin is written by exactly one thread.
+  const int ntargets = (rmax_roi_low - rmin_roi_low) * (phimax_roi_low - phimin_roi_low) * (zmax_roi_low - zmin_roi_low);
 
   // todo:  add in handling if roi_low is wrap-around in phi
-  for (int ifr = rmin_roi_low; ifr < rmax_roi_low; ifr++)
+  auto populate = [&](int ithread, int nthreads_local)
   {
-    int fr_low = ifr * r_spacing;
-    int fr_high = fr_low + r_spacing - 1;
-    if (fr_high >= nr)
-    {
-      fr_high = nr - 1;
-    }
-    for (int ifphi = phimin_roi_low; ifphi < phimax_roi_low; ifphi++)
+    TVector3 at(1, 0, 0);
+    TVector3 from(1, 0, 0);
+    int fphi_low, fphi_high, fz_low, fz_high;             // edges of the outer l-bin
+    int r_low, r_high, phi_low, phi_high, z_low, z_high;  // edges of the inner l-bin
+    for (int itarget = ithread; itarget < ntargets; itarget += nthreads_local)
     {
+      int ifz = zmin_roi_low + itarget % (zmax_roi_low - zmin_roi_low);
+      int ifphi = phimin_roi_low + (itarget / (zmax_roi_low - zmin_roi_low)) % (phimax_roi_low - phimin_roi_low);
+      int ifr = rmin_roi_low + itarget / ((zmax_roi_low - zmin_roi_low) * (phimax_roi_low - phimin_roi_low));
+
+      int fr_low = ifr * r_spacing;
+      int fr_high = fr_low + r_spacing - 1;
+      if (fr_high >= nr)
+      {
+        fr_high = nr - 1;
+      }
       fphi_low = ifphi * phi_spacing;
       fphi_high = fphi_low + phi_spacing - 1;
       if (fphi_high >= nphi)
       {
         fphi_high = nphi - 1;  // if our phi l-bins aren't evenly spaced, we need to catch that here.
       }
-      for (int ifz = zmin_roi_low; ifz < zmax_roi_low; ifz++)
+      fz_low = ifz * z_spacing;
+      fz_high = fz_low + z_spacing - 1;
+      if (fz_high >= nz)
       {
-        fz_low = ifz * z_spacing;
-        fz_high = fz_low + z_spacing - 1;
-        if (fz_high >= nz)
+        fz_high = nz - 1;
+      }
+      at = GetGroupCellCenter(fr_low, fr_high, fphi_low, fphi_high, fz_low, fz_high);
+
+      for (int ior = 0; ior < nr_low; ior++)
+      {
+        r_low = ior * r_spacing;
+        r_high = r_low + r_spacing - 1;
+        int ir_rel = ifr - rmin_roi_low;
+
+        if (r_high >= nr)
         {
-          fz_high = nz - 1;
+          r_high = nr - 1;
         }
-        at = GetGroupCellCenter(fr_low, fr_high, fphi_low, fphi_high, fz_low, fz_high);
-        // print_need_cout("ifr=%d, rlow=%d,rhigh=%d,r_spacing=%d\n",ifr,r_low,r_high,r_spacing);
-        // if(debugFlag())	  print_need_cout("%d: AnnularFieldSim::populate_lowres_lookup icell=(%d,%d,%d)\n",__LINE__,ifr,ifphi,ifz);
-
-        for (int ior = 0; ior < nr_low; ior++)
+        for (int iophi = 0; iophi < nphi_low; iophi++)
         {
-          r_low = ior * r_spacing;
-          r_high = r_low + r_spacing - 1;
-          int ir_rel = ifr - rmin_roi_low;
-
-          if (r_high >= nr)
+          phi_low = iophi * phi_spacing;
+          phi_high = phi_low + phi_spacing - 1;
+          if (phi_high >= nphi)
           {
-            r_high = nr - 1;
+            phi_high = nphi - 1;
           }
-          for (int iophi = 0; iophi < nphi_low; iophi++)
+          int iphi_rel = ifphi - phimin_roi_low;
+          for (int ioz = 0; ioz < nz_low; ioz++)
           {
-            phi_low = iophi * phi_spacing;
-            phi_high = phi_low + phi_spacing - 1;
-            if (phi_high >= nphi)
+            z_low = ioz * z_spacing;
+            z_high = z_low + z_spacing - 1;
+            if (z_high >= nz)
             {
-              phi_high = nphi - 1;
+              z_high = nz - 1;
             }
-            int iphi_rel = ifphi - phimin_roi_low;
-            for (int ioz = 0; ioz < nz_low; ioz++)
-            {
-              z_low = ioz * z_spacing;
-              z_high = z_low + z_spacing - 1;
-              if (z_high >= nz)
-              {
-                z_high = nz - 1;
-              }
-              int iz_rel = ifz - zmin_roi_low;
-              from = GetGroupCellCenter(r_low, r_high, phi_low, phi_high, z_low, z_high);
-
-              if (ifr == ior && ifphi == iophi && ifz == ioz)
-              {
-                Epartial_lowres->Set(ir_rel, iphi_rel, iz_rel, ior, iophi, ioz, zero);
-              }
-              else
-              {  // for extra carefulness, only calc the field if it's not self-to-self.
-                Epartial_lowres->Set(ir_rel, iphi_rel, iz_rel, ior, iophi, ioz, calc_unit_field(at, from));
-              }
+            int iz_rel = ifz - zmin_roi_low;
+            from = GetGroupCellCenter(r_low, r_high, phi_low, phi_high, z_low, z_high);
 
-              //*f[ifx][ify][ifz][iox][ioy][ioz]=cacl_unit_field(at,from);
-              // print_need_cout("calc_unit_field...\n");
-              // this calc's okay.
+            if (ifr == ior && ifphi == iophi && ifz == ioz)
+            {
+              Epartial_lowres->Set(ir_rel, iphi_rel, iz_rel, ior, iophi, ioz, zero);
+            }
+            else
+            {  // for extra carefulness, only calc the field if it's not self-to-self.
+              Epartial_lowres->Set(ir_rel, iphi_rel, iz_rel, ior, iophi, ioz, calc_unit_field(at, from));
             }
           }
         }
       }
     }
-  }
+  };
+  run_parallel(nthreads, populate);
   return;
 }
 
@@ -1734,15 +1794,20 @@ void AnnularFieldSim::populate_phislice_lookup()
   totalelements *= nz_roi;  // breaking up this multiplication prevents a 32bit math overflow
   unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << boost::str(boost::format("total elements = %llu") % totalelements) << std::endl;
-  TVector3 at(1, 0, 0);
-  TVector3 from(1, 0, 0);
   TVector3 zero(0, 0, 0);
 
-  int el = 0;
-  for (int ifr = rmin_roi; ifr < rmax_roi; ifr++)
+  // target cells are dealt out to the threads in turn.  Each target cell is written by exactly one thread.
+  const int ntargets = nr_roi * nz_roi;
+  auto populate = [&](int ithread, int nthreads_local)
   {
-    for (int ifz = zmin_roi; ifz < zmax_roi; ifz++)
+    TVector3 at(1, 0, 0);
+    TVector3 from(1, 0, 0);
+    unsigned long long percent_local = std::max(percent / nthreads_local, 1ULL);
+    unsigned long long el = 0;
+    for (int itarget = ithread; itarget < ntargets; itarget += nthreads_local)
     {
+      int ifz = zmin_roi + itarget % nz_roi;
+      int ifr = rmin_roi + itarget / nz_roi;
       at = GetCellCenter(ifr, 0, ifz);
       for (int ior = 0; ior < nr; ior++)
       {
@@ -1751,14 +1816,15 @@ void AnnularFieldSim::populate_phislice_lookup()
           for (int ioz = 0; ioz < nz; ioz++)
           {
             el++;
+            bool report = (ithread == 0 && !(el % percent_local));
             from = GetCellCenter(ior, iophi, ioz);
             //*f[ifx][ify][ifz][iox][ioy][ioz]=cacl_unit_field(at,from);
             // print_need_cout("calc_unit_field...\n");
             if (ifr == ior && 0 == iophi && ifz == ioz)
             {
-              if (!(el % percent))
+              if (report)
               {
-                std::cout << boost::str(boost::format("populate_phislice_lookup %llu%%:  ") % ((uint64_t) (debug_npercent) *el / percent));
+                std::cout << boost::str(boost::format("populate_phislice_lookup %llu%%:  ") % ((uint64_t) (debug_npercent) *el / percent_local));
                 std::cout << boost::str(boost::format("self-to-self is zero (ir=%d,iphi=%d,iz=%d) to (or=%d,ophi=0,oz=%d) gives (%E,%E,%E)") % ior % iophi % ioz % ifr % ifz % zero.X() % zero.Y() % zero.Z()) << std::endl;
               }
               Epartial_phislice->Set(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz, zero);
@@ -1766,13 +1832,10 @@ void AnnularFieldSim::populate_phislice_lookup()
             else
             {
               TVector3 unitf = calc_unit_field(at, from);
-              if (true)
+              if (report)
               {
-                if (!(el % percent))
-                {
-                  std::cout << boost::str(boost::format("populate_phislice_lookup %llu%%:  ") % ((uint64_t) (debug_npercent) *el / percent));
-                  std::cout << boost::str(boost::format("calc_unit_field (ir=%d,iphi=%d,iz=%d) to (or=%d,ophi=0,oz=%d) gives (%E,%E,%E)") % ior % iophi % ioz % ifr % ifz % unitf.X() % unitf.Y() % unitf.Z()) << std::endl;
-                }
+                std::cout << boost::str(boost::format("populate_phislice_lookup %llu%%:  ") % ((uint64_t) (debug_npercent) *el / percent_local));
+                std::cout << boost::str(boost::format("calc_unit_field (ir=%d,iphi=%d,iz=%d) to (or=%d,ophi=0,oz=%d) gives (%E,%E,%E)") % ior % iophi % ioz % ifr % ifz % unitf.X() % unitf.Y() % unitf.Z()) << std::endl;
               }
 
               Epartial_phislice->Set(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz, unitf);  // the origin phi is relative to zero anyway.
@@ -1781,7 +1844,8 @@ void AnnularFieldSim::populate_phislice_lookup()
         }
       }
     }
-  }
+  };
+  run_parallel(nthreads, populate);
   return;
 }
 
@@ -1955,6 +2019,92 @@ void AnnularFieldSim::save_phislice_lookup(const std::string &destfile)
   return;
 }
 
+MultiArrayVector3 *AnnularFieldSim::GetLookupTable()
+{
+  if (lookupCase == Full3D)
+  {
+    return Epartial;
+  }
+  if (lookupCase == PhiSlice)
+  {
+    return Epartial_phislice;
+  }
+  return nullptr;  // hybrid has two tables, analytic and nolookup have none.
+}
+
+void AnnularFieldSim::save_lookup_cache(const std::string &destfile)
+{
+  MultiArrayVector3 *table = GetLookupTable();
+  if (!table)
+  {
+    std::cout << boost::str(boost::format("AnnularFieldSim::save_lookup_cache: no single lookup table for lookupCase=%d, nothing saved.") % lookupCase) << std::endl;
+    return;
+  }
+  std::cout << boost::str(boost::format("saving %s lookup cache (%d elements) to %s") % GetLookupString() % table->Length() % destfile) << std::endl;
+
+  // header: everything the table depends on, then the three component arrays in their native (float) form.
+  int header[] = {(int) lookupCase, nr, nphi, nz, rmin_roi, rmax_roi, phimin_roi, phimax_roi, zmin_roi, zmax_roi, table->dim, table->n[0], table->n[1], table->n[2], table->n[3], table->n[4], table->n[5]};
+  float bounds[] = {rmin, rmax, zmin, zmax};
+
+  std::ofstream output(destfile, std::ios::binary);
+  output.write(lookup_cache_magic, sizeof(lookup_cache_magic));
+  output.write(reinterpret_cast<const char *>(header), sizeof(header));
+  output.write(reinterpret_cast<const char *>(bounds), sizeof(bounds));
+  for (const auto *component : {&table->x, &table->y, &table->z})
+  {
+    output.write(reinterpret_cast<const char *>(component->data()), component->size() * sizeof(float));
+  }
+  if (!output)
+  {
+    std::cout << boost::str(boost::format("AnnularFieldSim::save_lookup_cache: failed writing %s") % destfile) << std::endl;
+  }
+  return;
+}
+
+bool AnnularFieldSim::load_lookup_cache(const std::string &sourcefile)
+{
+  MultiArrayVector3 *table = GetLookupTable();
+  if (!table)
+  {
+    std::cout << boost::str(boost::format("AnnularFieldSim::load_lookup_cache: no single lookup table for lookupCase=%d, nothing loaded.") % lookupCase) << std::endl;
+    return false;
+  }
+
+  std::ifstream input(sourcefile, std::ios::binary);
+  if (!input)
+  {
+    std::cout << boost::str(boost::format("AnnularFieldSim::load_lookup_cache: cannot open %s") % sourcefile) << std::endl;
+    return false;
+  }
+  std::cout << boost::str(boost::format("loading %s lookup cache (%d elements) from %s") % GetLookupString() % table->Length() % sourcefile) << std::endl;
+
+  int header[] = {(int) lookupCase, nr, nphi, nz, rmin_roi, rmax_roi, phimin_roi, phimax_roi, zmin_roi, zmax_roi, table->dim, table->n[0], table->n[1], table->n[2], table->n[3], table->n[4], table->n[5]};
+  float bounds[] = {rmin, rmax, zmin, zmax};
+  char file_magic[sizeof(lookup_cache_magic)];
+  int file_header[sizeof(header) / sizeof(int)];
+  float file_bounds[sizeof(bounds) / sizeof(float)];
+  input.read(file_magic, sizeof(file_magic));
+  input.read(reinterpret_cast<char *>(file_header), sizeof(file_header));
+  input.read(reinterpret_cast<char *>(file_bounds), sizeof(file_bounds));
+  if (!input || memcmp(file_magic, lookup_cache_magic, sizeof(file_magic)) != 0 || memcmp(file_header, header, sizeof(header)) != 0 || memcmp(file_bounds, bounds, sizeof(bounds)) != 0)
+  {
+    std::cout << boost::str(boost::format("AnnularFieldSim::load_lookup_cache: %s does not match fieldsim parameters, not loaded.") % sourcefile) << std::endl;
+    return false;
+  }
+
+  for (auto *component : {&table->x, &table->y, &table->z})
+  {
+    input.read(reinterpret_cast<char *>(component->data()), component->size() * sizeof(float));
+  }
+  if (!input)
+  {
+    std::cout << boost::str(boost::format("AnnularFieldSim::load_lookup_cache: %s is truncated, table reset to zero.") % sourcefile) << std::endl;
+    table->SetAll(zero_vector);
+    return false;
+  }
+  return true;
+}
+
 void AnnularFieldSim::setFlatFields(float B, float E)
 {
   // these only cover the roi, but since we address them flat, we don't need to know that here.
@@ -1991,6 +2141,17 @@ TVector3 AnnularFieldSim::sum_field_at(int r, int phi, int z)
   return sum;
   */
 
+  TVector3 sum = sum_field_at_quiet(r, phi, z);
+  if (debugFlag())
+  {
+    std::cout << boost::str(boost::format("summed field at (%d,%d,%d)=(%f,%f,%f)") % r % phi % z % sum.X() % sum.Y() % sum.Z()) << std::endl;
+  }
+
+  return sum;
+}
+
+TVector3 AnnularFieldSim::sum_field_at_quiet(int r, int phi, int z)
+{
   TVector3 sum(0, 0, 0);
   if (lookupCase == Full3D)
   {
@@ -2014,10 +2175,6 @@ TVector3 AnnularFieldSim::sum_field_at(int r, int phi, int z)
     // do nothing.  We are forcibly assuming E from spacecharge is zero everywhere.
   }
   sum += Eexternal->Get(r - rmin_roi, phi - phimin_roi, z - zmin_roi);
-  if (debugFlag())
-  {
-    std::cout << boost::str(boost::format("summed field at (%d,%d,%d)=(%f,%f,%f)") % r % phi % z % sum.X() % sum.Y() % sum.Z()) << std::endl;
-  }
 
   return sum;
 }
@@ -2418,14 +2575,22 @@ TVector3 AnnularFieldSim::sum_phislice_field_at(int r, int phi, int z)
 
   // unsigned long long el=0;
 
-  TVector3 sum(0, 0, 0);
-  TVector3 unrotatedField(0, 0, 0);
-  TVector3 unitField(0, 0, 0);
-  int phirel;
+  // every unit field in the slice is rotated by the same rotphi, so sum the unrotated fields straight out of the flat arrays and rotate once at the end.
+  // the source cells of a given (r,phirel) row are contiguous in z.
+  const long int rowlength = nz;
+  const long int targetoffset = Epartial_phislice->Index(r - rmin_roi, 0, z - zmin_roi, 0, 0, 0);
+  const float *ex = Epartial_phislice->x.data();
+  const float *ey = Epartial_phislice->y.data();
+  const float *ez = Epartial_phislice->z.data();
+  double sumx = 0;
+  double sumy = 0;
+  double sumz = 0;
   for (int ir = 0; ir < nr; ir++)
   {
     for (int iphi = 0; iphi < nphi; iphi++)
     {
+      int phirel = FilterPhiIndex(iphi - phi);
+      long int rowoffset = targetoffset + (long int) (ir * nphi + phirel) * rowlength;
       for (int iz = 0; iz < nz; iz++)
       {
         // sum+=*partial[x][phi][z][ix][iphi][iz] * *q[ix][iphi][iz];
@@ -2433,23 +2598,15 @@ TVector3 AnnularFieldSim::sum_phislice_field_at(int r, int phi, int z)
         {
           continue;  // dont' compute self-to-self field.
         }
-        phirel = FilterPhiIndex(iphi - phi);
-        unitField = Epartial_phislice->Get(r - rmin_roi, 0, z - zmin_roi, ir, phirel, iz);
-        unitField.RotateZ(rotphi);  // previously was rotate by the step.Phi()*phi.    //annoying that I can't rename this to 'rotated field' here without unnecessary overhead.
-
-        sum += unitField * q->GetChargeInBin(ir, iphi, iz);
-        ;
-
-        /*
-        if(!(el%percent)) {print_need_cout("summing phislices %d%%:  ",(int)(el/percent));
-          print_need_cout("unit field at (r=%d,p=%d,z=%d) from  (ir=%d,ip=%d,iz=%d) is (%E,%E,%E) (xyz), q=%E\n",
-                 r,phi,z,ir,iphi,iz,unitField.X(),unitField.Y(),unitField.Z(),q->GetChargeInBin(ir,iphi,iz));
-        }
-        el++;
-        */
+        double charge = q->GetChargeInBin(ir, iphi, iz);
+        sumx += ex[rowoffset + iz] * charge;
+        sumy += ey[rowoffset + iz] * charge;
+        sumz += ez[rowoffset + iz] * charge;
       }
     }
   }
+  TVector3 sum(sumx, sumy, sumz);
+  sum.RotateZ(rotphi);  // previously was rotate by the step.Phi()*phi, per source cell.
   // print_need_cout("summed field at (%d,%d,%d)=(%f,%f,%f)\n",x,y,z,sum.X(),sum.Y(),sum.Z());
   return sum;
 }
@@ -13,6 +13,7 @@ class TTree;
 
 template <class T>
 class MultiArray;
+class MultiArrayVector3;
 
 class AnnularFieldSim
 {
@@ -93,6 +94,11 @@ class AnnularFieldSim
     truncation_length = x;
     return;
   }
+  void SetNThreads(int n)
+  {
+    nthreads = n;
+    return;
+  };  // number of threads used to populate the lookup tables and the fieldmap.
 
   // getters for internal states:
   const std::string GetLookupString();
@@ -198,6 +204,10 @@ class AnnularFieldSim
   void load_phislice_lookup(const std::string &sourcefile);
   void save_phislice_lookup(const std::string &destfile);
 
+  // raw binary dump of the current lookup table, much faster to read back than the phislice TTree.  Only valid for an identical geometry and lookupCase.
+  bool load_lookup_cache(const std::string &sourcefile);
+  void save_lookup_cache(const std::string &destfile);
+
   Rossegger *green;   // stand-alone class to compute greens functions.
   float green_shift;  // how far to offset our position in z when querying our green's functions.
   AnnularFieldSim *twin = nullptr;
@@ -222,6 +232,9 @@ class AnnularFieldSim
   int GetPhiIndex(float pos);
   int GetZindex(float pos);
 
+  TVector3 sum_field_at_quiet(int r, int phi, int z);  // sum_field_at without the debug printout, safe to call from several threads for the non-hybrid lookups.
+  MultiArrayVector3 *GetLookupTable();                  // the lookup table used by the current lookupCase, if any.
+
   void UpdateOmegaTau()
   {
     omegatau_nominal = -Bnominal * vdrift / abs(Enominal);
@@ -299,6 +312,7 @@ class AnnularFieldSim
   LookupCase lookupCase;  // which lookup system to instantiate and use.
   ChargeCase chargeCase;  // which charge model to use
   int truncation_length;  // distance in cells (full 3D metric in units of bins)
+  int nthreads = 1;       // number of threads for lookup and fieldmap population
 
   // variables related to the region of interest:
   //
@@ -333,10 +347,10 @@ class AnnularFieldSim
   // 3- and 6-dimensional arrays to handle bin and bin-to-bin data
   //
   MultiArray<TVector3> *Efield;             // total electric field in each f-bin in the roi for given configuration of charge AND external field.
-  MultiArray<TVector3> *Epartial_highres;   // electric field in each f-bin in the roi from charge in a given f-bin or summed bin in the high res region.
-  MultiArray<TVector3> *Epartial_lowres;    // electric field in each l-bin in the roi from charge in a given l-bin anywhere in the volume.
-  MultiArray<TVector3> *Epartial;           // electric field for the old brute-force model.
-  MultiArray<TVector3> *Epartial_phislice;  // electric field in a 2D phi-slice from the full 3D region.
+  MultiArrayVector3 *Epartial_highres;   // electric field in each f-bin in the roi from charge in a given f-bin or summed bin in the high res region.
+  MultiArrayVector3 *Epartial_lowres;    // electric field in each l-bin in the roi from charge in a given l-bin anywhere in the volume.
+  MultiArrayVector3 *Epartial;           // electric field for the old brute-force model.
+  MultiArrayVector3 *Epartial_phislice;  // electric field in a 2D phi-slice from the full 3D region.
   MultiArray<TVector3> *Eexternal;          // externally applied electric field in each f-bin in the roi
   MultiArray<TVector3> *Bfield;             // magnetic field in each f-bin in the roi
 
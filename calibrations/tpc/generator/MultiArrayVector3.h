@@ -0,0 +1,140 @@
+
+#ifndef MULTIARRAYVECTOR3_H
+#define MULTIARRAYVECTOR3_H
+
+#include <TVector3.h>
+
+#include <cassert>
+#include <cstdio>  // for printf
+#include <vector>
+
+class MultiArrayVector3
+{
+  // same indexing as MultiArray<TVector3>, but stores each component in its own contiguous float array instead of one TVector3 per element.
+  // a TVector3 is a TObject with three doubles, so this is ~3x smaller, and lets the summation loops run straight through memory.
+  // this is meant for the large lookup tables.  Values are converted to and from TVector3 on Get/Set, so precision is that of a float.
+ public:
+  static const int MAX_DIM = 6;
+  int dim;
+  int n[6];
+  long int length;
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> z;
+
+  MultiArrayVector3(int a = 0, int b = 0, int c = 0, int d = 0, int e = 0, int f = 0)
+  {
+    int n_[6];
+    for (int i = 0; i < MAX_DIM; i++)
+      n[i] = 0;
+    n_[0] = a;
+    n_[1] = b;
+    n_[2] = c;
+    n_[3] = d;
+    n_[4] = e;
+    n_[5] = f;
+    length = 1;
+    dim = MAX_DIM;
+    for (int i = 0; i < dim; i++)
+    {
+      if (n_[i] < 1)
+      {
+        dim = i;
+        break;
+      }
+      n[i] = n_[i];
+      length *= n[i];
+    }
+    // unlike MultiArray, the arrays are zeroed on construction.
+    x.assign(length, 0);
+    y.assign(length, 0);
+    z.assign(length, 0);
+  }
+  //! delete copy ctor and assignment opertor (cppcheck)
+  explicit MultiArrayVector3(const MultiArrayVector3 &) = delete;
+  MultiArrayVector3 &operator=(const MultiArrayVector3 &) = delete;
+
+  long int Index(int a = 0, int b = 0, int c = 0, int d = 0, int e = 0, int f = 0) const
+  {  // flat index.  bounds are only checked by assert, so this costs nothing in optimized builds.
+    int n_[6];
+    n_[0] = a;
+    n_[1] = b;
+    n_[2] = c;
+    n_[3] = d;
+    n_[4] = e;
+    n_[5] = f;
+    assert(dim < 1 || (n_[0] >= 0 && n_[0] < n[0]));
+    long int index = n_[0];
+    for (int i = 1; i < dim; i++)
+    {
+      assert(n_[i] >= 0 && n_[i] < n[i]);
+      index = (index * n[i]) + n_[i];
+    }
+    assert(index >= 0 && index < length);
+    return index;
+  }
+
+  void Add(int a, int b, int c, int d, int e, int f, const TVector3 &in)
+  {
+    long int index = Index(a, b, c, d, e, f);
+    x[index] += in.X();
+    y[index] += in.Y();
+    z[index] += in.Z();
+    return;
+  }
+
+  TVector3 Get(int a = 0, int b = 0, int c = 0, int d = 0, int e = 0, int f = 0) const
+  {
+    int n_[6];
+    n_[0] = a;
+    n_[1] = b;
+    n_[2] = c;
+    n_[3] = d;
+    n_[4] = e;
+    n_[5] = f;
+    long int index = 0;
+    for (int i = 0; i < dim; i++)
+    {
+      if (n[i] <= n_[i] || n_[i] < 0)
+      {  // check bounds
+        printf("asking for el %d %d %d %d %d %d.  %dth element is outside of bounds 0<x<%d\n", n_[0], n_[1], n_[2], n_[3], n_[4], n_[5], n_[i], n[i]);
+        assert(false);
+      }
+      index = (index * n[i]) + n_[i];
+    }
+    return TVector3(x[index], y[index], z[index]);
+  }
+
+  TVector3 GetFlat(long int a) const
+  {
+    if (a < 0 || a >= length)
+    {
+      printf("tried to seek element %ld of multiarrayvector3, but bounds are 0<a<%ld\n", a, length);
+      assert(a >= 0 && a < length);  // check bounds
+    }
+    return TVector3(x[a], y[a], z[a]);
+  }
+
+  int Length() const
+  {
+    return (int) length;
+  }
+
+  void Set(int a, int b, int c, int d, int e, int f, const TVector3 &in)
+  {
+    long int index = Index(a, b, c, d, e, f);
+    x[index] = in.X();
+    y[index] = in.Y();
+    z[index] = in.Z();
+    return;
+  }
+
+  void SetAll(const TVector3 &in)
+  {
+    x.assign(length, in.X());
+    y.assign(length, in.Y());
+    z.assign(length, in.Z());
+    return;
+  }
+};
+#endif  // MULTIARRAYVECTOR3_H
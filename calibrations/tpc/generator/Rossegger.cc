@@ -16,6 +16,7 @@
 #include <cstdlib>  // for exit, abs
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
 
@@ -25,6 +26,12 @@ extern "C"
   void dkia_(int *IFAC, double *X, double *A, double *DKI, double *DKID, int *IERRO);
   void dlia_(int *IFAC, double *X, double *A, double *DLI, double *DLID, int *IERRO);
 }
+namespace
+{
+  // dkia_ and dlia_ keep their intermediate results in COMMON blocks, which are shared by the whole process.
+  // Calls are serialized so the green's functions can be evaluated from several threads.
+  std::mutex fortran_mutex;
+}  // namespace
 //
 
 // Bessel Function J_n(x):
@@ -351,6 +358,7 @@ double Rossegger::Limu(double mu, double x)
   int IERRO = 0;
 
   double X = x;
+  std::lock_guard<std::mutex> lock(fortran_mutex);
   dlia_(&IFAC, &X, &A, &DLI, &DERR, &IERRO);
   return DLI;
 }
@@ -363,6 +371,7 @@ double Rossegger::Kimu(double mu, double x)
   int IERRO = 0;
 
   double X = x;
+  std::lock_guard<std::mutex> lock(fortran_mutex);
   dkia_(&IFAC, &X, &A, &DKI, &DERR, &IERRO);
   return DKI;
 }
@@ -13,6 +13,7 @@
 #include <Event/packet.h>
 
 #include <TCanvas.h>
+#include <TFile.h>
 #include <TH1.h>
 
 #include <boost/format.hpp>
@@ -30,15 +31,6 @@ XingShiftCal::XingShiftCal(const std::string &name, const int poverwriteSpinEntr
 {
   // overwriteSpinEntry = poverwriteSpinEntry;
   nevt = 0;
-  
-  for (auto &scalercount : scalercounts)
-  {
-    for (unsigned long &j : scalercount)
-    {
-      j = 0;
-    }
-  }
-
 
   std::cout << "XingShiftCal::XingShiftCal(const std::string &name) Calling ctor" << std::endl;
 }
@@ -258,15 +250,27 @@ int XingShiftCal::process_event(PHCompositeNode *topNode)
   else if (evt->getEvtType() == DATAEVENT)
   {
     p = evt->getPacket(packet_GL1);
-    int bunchnr = p->lValue(0, "BunchNumber");
-    
-    for (int i = 0; i < NTRIG; i++)
+    if (!p)
+    {
+      // no scaler update, the event is still counted
+      std::cout << PHWHERE << " missing GL1 packet " << packet_GL1 << std::endl;
+    }
+    else
     {
-      // 2nd arg of lValue: 0 is raw trigger count, 1 is live trigger count, 2 is scaled trigger count
-      long gl1pscaler = p->lValue(i, "GL1PLIVE");
-      scalercounts[i][bunchnr] = gl1pscaler;
+      int bunchnr = p->lValue(0, "BunchNumber");
+
+      if (bunchnr >= 0 && bunchnr < NBUNCHES)
+      {
+        for (int i = 0; i < NTRIG; i++)
+        {
+          // 2nd arg of lValue: 0 is raw trigger count, 1 is live trigger count, 2 is scaled trigger count
+          // the scalers are cumulative, the largest value is kept
+          long gl1pscaler = p->lValue(i, "GL1PLIVE");
+          scalercounts.update_scaler(i, bunchnr, gl1pscaler);
+        }
+      }
+      delete p;
     }
-    delete p;
   }
 
   if (nevt > threshold)
@@ -321,6 +325,13 @@ int XingShiftCal::End(PHCompositeNode * /*topNode*/)
     std::cout << "Not enough statistics. Did not calibrate." << std::endl;
   }
 
+  if (!scalerfname.empty())
+  {
+    TFile scalerfile(scalerfname.c_str(), "RECREATE");
+    scalercounts.Write(&scalerfile, (boost::format("GL1PSCALERS_%08d") % runnumber).str());
+    scalerfile.Close();
+  }
+
   const std::string cdbfname = (boost::format("SPIN-%08d_crossingshiftCDBTTree.root") % runnumber).str();
   WriteToCDB(cdbfname);
   CommitToSpinDB();
@@ -371,7 +382,7 @@ int XingShiftCal::Calibrate(const int final)
   return 0;
 }
 
-int XingShiftCal::CalculateCrossingShift(int &xing, uint64_t counts[NTRIG][NBUNCHES], bool &succ)
+int XingShiftCal::CalculateCrossingShift(int &xing, const CrossingScalers &counts, bool &succ)
 {
   succ = false;
   int shift_array[NTRIG] = {0};
@@ -380,13 +391,24 @@ int XingShiftCal::CalculateCrossingShift(int &xing, uint64_t counts[NTRIG][NBUNC
 
   int last_active_index = 0;
 
+  // bunches which are not filled in both beams (abort gaps), they do not depend on the trigger
+  int unfilled_bunches[NBUNCHES] = {0};
+  int nunfilled = 0;
+  for (int ibunch = 0; ibunch < NBUNCHES; ibunch++)
+  {
+    if (!(blueFillPattern[ibunch] && yellFillPattern[ibunch]))
+    {
+      unfilled_bunches[nunfilled++] = ibunch;
+    }
+  }
+
   int _temp;
   for (int itrig = 0; itrig < NTRIG; itrig++)
   {
     long long _counts = 0;
     for (int ii = 0; ii < NBUNCHES; ii++)
     {
-      _counts += counts[itrig][ii];
+      _counts += counts.scaler(itrig, ii);
     }
 
     if (_counts < 10000)
@@ -404,18 +426,14 @@ int XingShiftCal::CalculateCrossingShift(int &xing, uint64_t counts[NTRIG][NBUNC
     for (int ishift = 0; ishift < NBUNCHES; ishift++)
     {
       long long abort_sum = 0;
-      for (int iunfillbunch = 0; iunfillbunch < NBUNCHES; iunfillbunch++)
+      for (int iunfill = 0; iunfill < nunfilled; iunfill++)
       {
-	if (blueFillPattern[iunfillbunch] && yellFillPattern[iunfillbunch])
-	{
-	  continue;
-	}
-	int shiftbunch = iunfillbunch - ishift;
+	int shiftbunch = unfilled_bunches[iunfill] - ishift;
 	if (shiftbunch < 0)
 	{
 	  shiftbunch = 120 + shiftbunch;
 	}
-        abort_sum += counts[itrig][(shiftbunch) % NBUNCHES];
+        abort_sum += counts.scaler(itrig, (shiftbunch) % NBUNCHES);
       }
       if (abort_sum < abort_sum_prev)
       {
@@ -1255,5 +1273,21 @@ int XingShiftCal::Reset(PHCompositeNode * /*topNode*/)
 void XingShiftCal::Print(const std::string &what) const
 {
   std::cout << "XingShiftCal::Print(const std::string &what) const Printing info for " << what << std::endl;
+  if (what == "ALL" || what == "SCALERS")
+  {
+    // GL1P live scalers per spin state (++, +-, -+, --, other) with the current crossing shift
+    std::cout << "xingshift = " << xingshift << std::endl;
+    for (int itrig = 0; itrig < NTRIG; itrig++)
+    {
+      uint64_t sums[CrossingScalers::NSPINSTATES];
+      scalercounts.spin_sums(itrig, blueSpinPattern, yellSpinPattern, xingshift, sums, true);
+      std::cout << "trigger " << itrig << ":";
+      for (uint64_t sum : sums)
+      {
+        std::cout << " " << sum;
+      }
+      std::cout << std::endl;
+    }
+  }
 }
 
@@ -5,6 +5,8 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <chanstats/CrossingScalers.h>
+
 #include <map>
 #include <cstdint>
 #include <string>
@@ -33,12 +35,15 @@ class XingShiftCal : public SubsysReco
   void Print(const std::string &what = "ALL") const override;
 
   int Calibrate(const int final = 0);
-  int CalculateCrossingShift(int &xingshift, uint64_t counts[NTRIG][NBUNCHES], bool &success);
+  int CalculateCrossingShift(int &xingshift, const CrossingScalers &counts, bool &success);
   int WriteToCDB(const std::string &fname);
   int CommitToSpinDB();
   int SpinDBQA();
   std::string SQLArrayConstF(float x, int n);
 
+  //! also write the per crossing GL1P scalers to this file, they can be merged across jobs with chanstats_merge
+  void SetScalerFile(const std::string &fname) { scalerfname = fname; }
+
  private:
   Packet *p{nullptr};
 
@@ -100,7 +105,9 @@ class XingShiftCal : public SubsysReco
   int fillnumberBlue{0};
   int fillnumberYellow{0};
 
-  uint64_t scalercounts[NTRIG][NBUNCHES]{};
+  // latest GL1P live scaler per trigger and crossing
+  CrossingScalers scalercounts{NTRIG};
+  std::string scalerfname;
 
   int64_t mbdns[NBUNCHES]{0};
   int64_t mbdvtx[NBUNCHES]{0};
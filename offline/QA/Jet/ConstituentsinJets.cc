@@ -21,8 +21,7 @@
 // calobase includes
 #include <calobase/RawTower.h>
 #include <calobase/RawTowerContainer.h>
-#include <calobase/RawTowerGeom.h>
-#include <calobase/RawTowerGeomContainer.h>
+#include <calobase/RawTowerGeomTable.h>
 #include <calobase/TowerInfo.h>
 #include <calobase/TowerInfoContainer.h>
 
@@ -215,9 +214,9 @@ int ConstituentsinJets::process_event(PHCompositeNode *topNode)
     exit(-1);  // fatal
   }
 
-  // get tower geometry
-  RawTowerGeomContainer *tower_geomIH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
-  RawTowerGeomContainer *tower_geomOH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
+  // get tower geometry, as dense tables for the per tower lookups
+  RawTowerGeomTable *tower_geomIH = RawTowerGeomTable::GetTable(topNode, "TOWERGEOM_HCALIN");
+  RawTowerGeomTable *tower_geomOH = RawTowerGeomTable::GetTable(topNode, "TOWERGEOM_HCALOUT");
   if (!tower_geomIH || !tower_geomOH)
   {
     std::cout << "ConstituentsinJets::process_event - Error can not find tower geometry node " << std::endl;
@@ -291,9 +290,13 @@ int ConstituentsinJets::process_event(PHCompositeNode *topNode)
         unsigned int calokey = towersIH3->encode_key(channel);
         int ieta = towersIH3->getTowerEtaBin(calokey);
         int iphi = towersIH3->getTowerPhiBin(calokey);
-        const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALIN, ieta, iphi);
-        float tower_phi = tower_geomIH->get_tower_geometry(key)->get_phi();
-        float tower_eta = tower_geomIH->get_tower_geometry(key)->get_eta();
+        const unsigned int itower = tower_geomIH->index(ieta, iphi);
+        if (!tower_geomIH->has_tower(itower))
+        {
+          continue;
+        }
+        float tower_phi = tower_geomIH->get_phi(itower);
+        float tower_eta = tower_geomIH->get_eta(itower);
         tower_eT = tower->get_energy() / std::cosh(tower_eta);
 
         if (comp.first == 30)
@@ -324,9 +327,13 @@ int ConstituentsinJets::process_event(PHCompositeNode *topNode)
         unsigned int calokey = towersOH3->encode_key(channel);
         int ieta = towersOH3->getTowerEtaBin(calokey);
         int iphi = towersOH3->getTowerPhiBin(calokey);
-        const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALOUT, ieta, iphi);
-        float tower_phi = tower_geomOH->get_tower_geometry(key)->get_phi();
-        float tower_eta = tower_geomOH->get_tower_geometry(key)->get_eta();
+        const unsigned int itower = tower_geomOH->index(ieta, iphi);
+        if (!tower_geomOH->has_tower(itower))
+        {
+          continue;
+        }
+        float tower_phi = tower_geomOH->get_phi(itower);
+        float tower_eta = tower_geomOH->get_eta(itower);
         tower_eT = tower->get_energy() / std::cosh(tower_eta);
 
         if (comp.first == 31)
@@ -357,9 +364,13 @@ int ConstituentsinJets::process_event(PHCompositeNode *topNode)
         unsigned int calokey = towersEM3->encode_key(channel);
         int ieta = towersEM3->getTowerEtaBin(calokey);
         int iphi = towersEM3->getTowerPhiBin(calokey);
-        const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALIN, ieta, iphi);
-        float tower_phi = tower_geomIH->get_tower_geometry(key)->get_phi();
-        float tower_eta = tower_geomIH->get_tower_geometry(key)->get_eta();
+        const unsigned int itower = tower_geomIH->index(ieta, iphi);
+        if (!tower_geomIH->has_tower(itower))
+        {
+          continue;
+        }
+        float tower_phi = tower_geomIH->get_phi(itower);
+        float tower_eta = tower_geomIH->get_eta(itower);
         tower_eT = tower->get_energy() / std::cosh(tower_eta);
 
         if (comp.first == 29)
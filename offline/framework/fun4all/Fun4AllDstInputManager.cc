@@ -646,6 +646,30 @@ int Fun4AllDstInputManager::PushBackEvents(const int i)
   return -1;
 }
 
+int Fun4AllDstInputManager::ReopenAfterFork()
+{
+  if (!IsOpen())
+  {
+    return 0;
+  }
+  // a forked process shares the file offset with its parent, so we need our own
+  // file handle. Reopen the current file and go back to where we were
+  size_t EventOnDst = m_IManager->getEventNumber();
+  delete m_IManager;
+  m_IManager = new PHNodeIOManager(fullfilename, PHReadOnly);
+  if (!m_IManager->isFunctional())
+  {
+    std::cout << PHWHERE << Name() << ": Could not reopen " << fullfilename << std::endl;
+    delete m_IManager;
+    m_IManager = nullptr;
+    IsOpen(0);
+    return -1;
+  }
+  setBranches();
+  m_IManager->setEventNumber(EventOnDst);
+  return 0;
+}
+
 int Fun4AllDstInputManager::HasSyncObject() const
 {
   if (m_HaveSyncObject)
@@ -27,6 +27,7 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
   virtual int setSyncBranches(PHNodeIOManager *iman);
   void Print(const std::string &what = "ALL") const override;
   int PushBackEvents(const int i) override;
+  int ReopenAfterFork() override;
   int HasSyncObject() const override;
 
  protected:
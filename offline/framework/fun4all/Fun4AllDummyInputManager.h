@@ -26,6 +26,7 @@ class Fun4AllDummyInputManager : public Fun4AllInputManager
   void setSyncManager(Fun4AllSyncManager* master) override;
   int PushBackEvents(const int nevt) override;
   int NoSyncPushBackEvents(const int nevt) override { return PushBackEvents(nevt); }
+  int ReopenAfterFork() override { return 0; }
   int ResetFileList() override;
 
  private:
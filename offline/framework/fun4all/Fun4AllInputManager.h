@@ -37,6 +37,8 @@ class Fun4AllInputManager : public Fun4AllBase
   // with negative arg
   virtual int skip(const int nevt) { return PushBackEvents(-nevt); }
   virtual int NoSyncPushBackEvents(const int /*nevt*/) { return -1; }
+  //! called in the workers forked by Fun4AllServer, open files must get their own file handle
+  virtual int ReopenAfterFork() { return (IsOpen() ? -1 : 0); }
   int AddFile(const std::string &filename);
   int AddListFile(const std::string &filename, const int do_it = 0);
   int registerSubsystem(SubsysReco *subsystem);
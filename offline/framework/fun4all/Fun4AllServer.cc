@@ -2,6 +2,7 @@
 
 #include "Fun4AllHistoBinDefs.h"
 #include "Fun4AllHistoManager.h"  // for Fun4AllHistoManager
+#include "Fun4AllInputManager.h"
 #include "Fun4AllMemoryTracker.h"
 #include "Fun4AllMonitoring.h"
 #include "Fun4AllOutputManager.h"
@@ -15,6 +16,7 @@
 #include <phool/PHNodeReset.h>
 #include <phool/PHObject.h>
 #include <phool/PHPointerListIterator.h>
+#include <phool/PHRandomSeed.h>
 #include <phool/PHTimeStamp.h>
 #include <phool/PHTimer.h>  // for PHTimer
 #include <phool/getClass.h>
@@ -22,22 +24,124 @@
 #include <phool/recoConsts.h>
 
 #include <Rtypes.h>  // for kMAXSIGNALS
+#include <TClass.h>
 #include <TDirectory.h>
+#include <TFile.h>
 #include <TH1.h>
+#include <TList.h>
 #include <TROOT.h>
+#include <TRandom.h>
 #include <TSysEvtHandler.h>  // for ESignals
 
 #include <TSystem.h>
 
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <exception>
+#include <filesystem>
+#include <functional>
 #include <iostream>
 #include <memory>  // for allocator_traits<>::value_type
+#include <mutex>
+#include <set>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 //#define FFAMEMTRACKER
 
+//! threads which are kept between events to run the modules concurrently
+class Fun4AllThreadPool
+{
+ public:
+  //! starts nthreads-1 threads, the thread calling Run() is the last one
+  explicit Fun4AllThreadPool(const int nthreads)
+  {
+    for (int i = 1; i < nthreads; i++)
+    {
+      m_Threads.emplace_back(&Fun4AllThreadPool::Loop, this);
+    }
+  }
+
+  ~Fun4AllThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Exit = true;
+    }
+    m_Start.notify_all();
+    for (auto &thread : m_Threads)
+    {
+      thread.join();
+    }
+  }
+
+  Fun4AllThreadPool(const Fun4AllThreadPool &) = delete;
+  Fun4AllThreadPool &operator=(const Fun4AllThreadPool &) = delete;
+
+  int NThreads() const { return m_Threads.size() + 1; }
+
+  //! run job on every thread including the calling one, returns when all of them are done
+  void Run(const std::function<void()> &job)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Job = &job;
+      m_Running = m_Threads.size();
+      m_Generation++;
+    }
+    m_Start.notify_all();
+    job();
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Done.wait(lock, [this]
+                { return m_Running == 0; });
+    m_Job = nullptr;
+  }
+
+ private:
+  void Loop()
+  {
+    unsigned long generation = 0;
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    while (true)
+    {
+      m_Start.wait(lock, [this, generation]
+                   { return m_Exit || m_Generation != generation; });
+      if (m_Exit)
+      {
+        return;
+      }
+      generation = m_Generation;
+      const std::function<void()> *job = m_Job;
+      lock.unlock();
+      (*job)();
+      lock.lock();
+      if (--m_Running == 0)
+      {
+        m_Done.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> m_Threads;
+  std::mutex m_Mutex;
+  std::condition_variable m_Start;
+  std::condition_variable m_Done;
+  const std::function<void()> *m_Job = nullptr;
+  unsigned long m_Generation = 0;
+  unsigned int m_Running = 0;
+  bool m_Exit = false;
+};
+
 Fun4AllServer *Fun4AllServer::__instance = nullptr;
 
 Fun4AllServer *Fun4AllServer::instance()
@@ -62,6 +166,7 @@ Fun4AllServer::Fun4AllServer(const std::string &name)
 
 Fun4AllServer::~Fun4AllServer()
 {
+  delete m_ThreadPool;
   Reset();
   delete beginruntimestamp;
   while (Subsystems.begin() != Subsystems.end())
@@ -271,6 +376,8 @@ int Fun4AllServer::registerSubsystem(SubsysReco *subsystem, const std::string &t
     timer_map.insert(make_pair(timer_name, timer));
   }
   RetCodes.push_back(iret);  // vector with return codes
+  m_ModuleGraphValid = false;
+  m_SkimGatesValid = false;
   return 0;
 }
 
@@ -325,6 +432,8 @@ int Fun4AllServer::unregisterSubsystemsNow()
   }
   unregistersubsystem = 0;
   DeleteSubsystems.clear();
+  m_ModuleGraphValid = false;
+  m_SkimGatesValid = false;
   return 0;
 }
 
@@ -381,6 +490,7 @@ int Fun4AllServer::registerOutputManager(Fun4AllOutputManager *manager)
   }
   UpdateEventSelector(manager);
   OutputManager.push_back(manager);
+  m_SkimGatesValid = false;
   return 0;
 }
 
@@ -530,86 +640,49 @@ int Fun4AllServer::process_event()
   }
   gROOT->cd(default_Tdirectory.c_str());
   std::string currdir = gDirectory->GetPath();
-  for (auto &Subsystem : Subsystems)
+  bool concurrent = (m_ConcurrentThreads > 1);
+  if (concurrent)
   {
-    if (Verbosity() >= VERBOSITY_MORE)
+    if (!m_ModuleGraphValid || m_ModuleSuccessors.size() != Subsystems.size())
     {
-      std::cout << "Fun4AllServer::process_event processing " << Subsystem.first->Name() << std::endl;
+      BuildModuleGraph();
     }
-    std::string newdirname = Subsystem.second->getName() + "/" + Subsystem.first->Name();
-    if (!gROOT->cd(newdirname.c_str()))
+    ProcessEventConcurrently();
+  }
+  bool skimgates = (!concurrent && !m_SkimGateNames.empty());
+  if (skimgates)
+  {
+    if (!m_SkimGatesValid || m_ModuleOutputs.size() != Subsystems.size() || m_OutputRejected.size() != OutputManager.size())
     {
-      std::cout << PHWHERE << "Unexpected TDirectory Problem cd'ing to "
-                << Subsystem.second->getName()
-                << " - send e-mail to off-l with your macro" << std::endl;
-      exit(1);
+      BuildSkimGates();
     }
-    else
+    std::fill(m_OutputRejected.begin(), m_OutputRejected.end(), 0);
+  }
+  for (auto &Subsystem : Subsystems)
+  {
+    if (concurrent)
     {
-      if (Verbosity() >= VERBOSITY_EVEN_MORE)
+      // the return codes are evaluated in registration order, modules which
+      // were not started because the event was aborted are skipped
+      if (!m_ModuleDone[icnt])
       {
-        std::cout << "process_event: cded to " << newdirname << std::endl;
+        icnt++;
+        continue;
       }
     }
-
-    try
+    else if (skimgates)
     {
-      std::string timer_name;
-      timer_name = Subsystem.first->Name() + "_" + Subsystem.second->getName();
-      std::map<const std::string, PHTimer>::iterator titer = timer_map.find(timer_name);
-      bool timer_found = false;
-      if (titer != timer_map.end())
-      {
-        timer_found = true;
-        titer->second.restart();
-      }
-      else
-      {
-        std::cout << "could not find timer for " << timer_name << std::endl;
-      }
-#ifdef FFAMEMTRACKER
-      ffamemtracker->Start(timer_name, "SubsysReco");
-      ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
-#endif
-      int retcode = Subsystem.first->process_event(Subsystem.second);
-#ifdef FFAMEMTRACKER
-      ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
-#endif
-      // we have observed an index overflow in RetCodes. I assume it is some
-      // memory corruption elsewhere which hits the icnt variable. Rather than
-      // the previous [], use at() which does bounds checking and throws an
-      // exception which will allow us to catch this and print out icnt and the size
-      try
-      {
-        RetCodes.at(icnt) = retcode;
-      }
-      catch (const std::exception &e)
+      if (SkipModule(icnt))
       {
-        std::cout << PHWHERE << " caught exception thrown during RetCodes.at(icnt)" << std::endl;
-        std::cout << "RetCodes.size(): " << RetCodes.size() << ", icnt: " << icnt << std::endl;
-        std::cout << "error: " << e.what() << std::endl;
-        gSystem->Exit(1);
+        icnt++;
+        continue;
       }
-      if (timer_found)
-      {
-        titer->second.stop();
-      }
-#ifdef FFAMEMTRACKER
-      ffamemtracker->Stop(timer_name, "SubsysReco");
-#endif
+      ProcessEventSubsystem(icnt);
+      EvaluateSkimGate(icnt);
     }
-    catch (const std::exception &e)
-    {
-      std::cout << PHWHERE << " caught exception thrown during process_event from "
-                << Subsystem.first->Name() << std::endl;
-      std::cout << "error: " << e.what() << std::endl;
-      gSystem->Exit(1);
-    }
-    catch (...)
+    else
     {
-      std::cout << PHWHERE << " caught unknown type exception thrown during process_event from "
-                << Subsystem.first->Name() << std::endl;
-      exit(1);
+      ProcessEventSubsystem(icnt);
     }
     if (RetCodes[icnt])
     {
@@ -754,6 +827,495 @@ int Fun4AllServer::process_event()
   return 0;
 }
 
+//_________________________________________________________________
+int Fun4AllServer::ProcessEventSubsystem(const unsigned int icnt)
+{
+  std::pair<SubsysReco *, PHCompositeNode *> &Subsystem = Subsystems[icnt];
+  if (Verbosity() >= VERBOSITY_MORE)
+  {
+    std::cout << "Fun4AllServer::process_event processing " << Subsystem.first->Name() << std::endl;
+  }
+  std::string newdirname = Subsystem.second->getName() + "/" + Subsystem.first->Name();
+  if (!gROOT->cd(newdirname.c_str()))
+  {
+    std::cout << PHWHERE << "Unexpected TDirectory Problem cd'ing to "
+              << Subsystem.second->getName()
+              << " - send e-mail to off-l with your macro" << std::endl;
+    exit(1);
+  }
+  else
+  {
+    if (Verbosity() >= VERBOSITY_EVEN_MORE)
+    {
+      std::cout << "process_event: cded to " << newdirname << std::endl;
+    }
+  }
+
+  try
+  {
+    std::string timer_name;
+    timer_name = Subsystem.first->Name() + "_" + Subsystem.second->getName();
+    std::map<const std::string, PHTimer>::iterator titer = timer_map.find(timer_name);
+    bool timer_found = false;
+    if (titer != timer_map.end())
+    {
+      timer_found = true;
+      titer->second.restart();
+    }
+    else
+    {
+      std::cout << "could not find timer for " << timer_name << std::endl;
+    }
+#ifdef FFAMEMTRACKER
+    ffamemtracker->Start(timer_name, "SubsysReco");
+    ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
+#endif
+    int retcode = Subsystem.first->process_event(Subsystem.second);
+#ifdef FFAMEMTRACKER
+    ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
+#endif
+    // we have observed an index overflow in RetCodes. I assume it is some
+    // memory corruption elsewhere which hits the icnt variable. Rather than
+    // the previous [], use at() which does bounds checking and throws an
+    // exception which will allow us to catch this and print out icnt and the size
+    try
+    {
+      RetCodes.at(icnt) = retcode;
+    }
+    catch (const std::exception &e)
+    {
+      std::cout << PHWHERE << " caught exception thrown during RetCodes.at(icnt)" << std::endl;
+      std::cout << "RetCodes.size(): " << RetCodes.size() << ", icnt: " << icnt << std::endl;
+      std::cout << "error: " << e.what() << std::endl;
+      gSystem->Exit(1);
+    }
+    if (timer_found)
+    {
+      titer->second.stop();
+    }
+#ifdef FFAMEMTRACKER
+    ffamemtracker->Stop(timer_name, "SubsysReco");
+#endif
+  }
+  catch (const std::exception &e)
+  {
+    std::cout << PHWHERE << " caught exception thrown during process_event from "
+              << Subsystem.first->Name() << std::endl;
+    std::cout << "error: " << e.what() << std::endl;
+    gSystem->Exit(1);
+  }
+  catch (...)
+  {
+    std::cout << PHWHERE << " caught unknown type exception thrown during process_event from "
+              << Subsystem.first->Name() << std::endl;
+    exit(1);
+  }
+  return RetCodes[icnt];
+}
+
+//_________________________________________________________________
+void Fun4AllServer::BuildModuleGraph()
+{
+  // module i depends on an earlier module j if one of them did not declare
+  // its nodes or if j writes what i reads or writes or reads what i writes
+  unsigned int nmodules = Subsystems.size();
+  std::vector<std::vector<char>> ancestor(nmodules, std::vector<char>(nmodules, 0));
+  m_ModulePredecessors.assign(nmodules, std::vector<unsigned int>());
+  m_ModuleSuccessors.assign(nmodules, std::vector<unsigned int>());
+  auto overlap = [](const std::set<std::string> &a, const std::set<std::string> &b)
+  {
+    for (const auto &nodename : a)
+    {
+      if (b.find(nodename) != b.end())
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+  for (unsigned int i = 0; i < nmodules; i++)
+  {
+    SubsysReco *mod = Subsystems[i].first;
+    std::vector<unsigned int> depends;
+    for (unsigned int j = 0; j < i; j++)
+    {
+      SubsysReco *prev = Subsystems[j].first;
+      if (!mod->DeclaredNodes() || !prev->DeclaredNodes() ||
+          (Subsystems[i].second == Subsystems[j].second &&
+           (overlap(prev->OutputNodes(), mod->InputNodes()) ||
+            overlap(prev->OutputNodes(), mod->OutputNodes()) ||
+            overlap(prev->InputNodes(), mod->OutputNodes()))))
+      {
+        depends.push_back(j);
+        ancestor[i][j] = 1;
+        for (unsigned int k = 0; k < j; k++)
+        {
+          ancestor[i][k] |= ancestor[j][k];
+        }
+      }
+    }
+    // keep only the direct dependencies, the others are implied
+    for (unsigned int j : depends)
+    {
+      bool implied = false;
+      for (unsigned int k : depends)
+      {
+        if (k != j && ancestor[k][j])
+        {
+          implied = true;
+          break;
+        }
+      }
+      if (!implied)
+      {
+        m_ModulePredecessors[i].push_back(j);
+        m_ModuleSuccessors[j].push_back(i);
+      }
+    }
+  }
+  m_ModuleDone.assign(nmodules, 0);
+  if (m_ConcurrentThreads > 1)
+  {
+    ROOT::EnableThreadSafety();
+  }
+  m_ModuleGraphValid = true;
+  if (Verbosity() > 0)
+  {
+    PrintModuleGraph();
+  }
+  return;
+}
+
+//_________________________________________________________________
+void Fun4AllServer::ProcessEventConcurrently()
+{
+  // modules are started as soon as all modules they depend on are done,
+  // the lowest registration index first
+  unsigned int nmodules = Subsystems.size();
+  std::vector<unsigned int> npending(nmodules);
+  std::set<unsigned int> ready;
+  for (unsigned int i = 0; i < nmodules; i++)
+  {
+    m_ModuleDone[i] = 0;
+    npending[i] = m_ModulePredecessors[i].size();
+    if (npending[i] == 0)
+    {
+      ready.insert(i);
+    }
+  }
+  std::mutex mtx;
+  std::condition_variable cv;
+  unsigned int nfinished = 0;
+  bool stop = false;
+  auto worker = [&]()
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true)
+    {
+      cv.wait(lock, [&]
+              { return stop || nfinished == nmodules || !ready.empty(); });
+      if (stop || ready.empty())
+      {
+        break;
+      }
+      unsigned int imodule = *ready.begin();
+      ready.erase(ready.begin());
+      lock.unlock();
+      int retcode = ProcessEventSubsystem(imodule);
+      lock.lock();
+      m_ModuleDone[imodule] = 1;
+      nfinished++;
+      if (retcode && retcode != Fun4AllReturnCodes::DISCARDEVENT)
+      {
+        // event (or run) is aborted, do not start anything else
+        stop = true;
+      }
+      else
+      {
+        for (unsigned int next : m_ModuleSuccessors[imodule])
+        {
+          if (--npending[next] == 0)
+          {
+            ready.insert(next);
+          }
+        }
+      }
+      cv.notify_all();
+    }
+  };
+  if (!m_ThreadPool || m_ThreadPool->NThreads() != m_ConcurrentThreads)
+  {
+    delete m_ThreadPool;
+    m_ThreadPool = new Fun4AllThreadPool(m_ConcurrentThreads);
+  }
+  m_ThreadPool->Run(worker);
+  return;
+}
+
+//_________________________________________________________________
+void Fun4AllServer::PrintModuleGraph()
+{
+  if (!m_ModuleGraphValid || m_ModuleSuccessors.size() != Subsystems.size())
+  {
+    BuildModuleGraph();
+  }
+  // earliest finishing time of each module with unlimited threads,
+  // using the average time per event from the module timers
+  unsigned int nmodules = Subsystems.size();
+  std::vector<double> modtime(nmodules, 0);
+  std::vector<double> finish(nmodules, 0);
+  std::vector<int> critical(nmodules, -1);
+  double sumtime = 0;
+  int last = -1;
+  std::cout << "--------------------------------------" << std::endl
+            << std::endl;
+  std::cout << "Module dependencies in Fun4AllServer:" << std::endl;
+  for (unsigned int i = 0; i < nmodules; i++)
+  {
+    std::string timer_name = Subsystems[i].first->Name() + "_" + Subsystems[i].second->getName();
+    std::map<const std::string, PHTimer>::const_iterator titer = timer_map.find(timer_name);
+    if (titer != timer_map.end() && titer->second.get_ncycle() > 0)
+    {
+      modtime[i] = titer->second.get_time_per_cycle();
+    }
+    double start = 0;
+    for (unsigned int j : m_ModulePredecessors[i])
+    {
+      if (finish[j] > start)
+      {
+        start = finish[j];
+        critical[i] = j;
+      }
+    }
+    finish[i] = start + modtime[i];
+    sumtime += modtime[i];
+    if (last < 0 || finish[i] > finish[last])
+    {
+      last = i;
+    }
+    std::cout << Subsystems[i].first->Name() << ": " << modtime[i] << " ms/event";
+    if (!Subsystems[i].first->DeclaredNodes())
+    {
+      std::cout << ", no declared nodes";
+    }
+    if (!m_ModulePredecessors[i].empty())
+    {
+      std::cout << ", after";
+      for (unsigned int j : m_ModulePredecessors[i])
+      {
+        std::cout << " " << Subsystems[j].first->Name();
+      }
+    }
+    std::cout << std::endl;
+  }
+  if (last < 0)
+  {
+    return;
+  }
+  std::vector<std::string> path;
+  for (int i = last; i >= 0; i = critical[i])
+  {
+    path.push_back(Subsystems[i].first->Name());
+  }
+  std::cout << "Critical path:";
+  for (auto iter = path.rbegin(); iter != path.rend(); ++iter)
+  {
+    std::cout << " " << *iter;
+  }
+  std::cout << std::endl;
+  std::cout << "Critical path: " << finish[last] << " ms/event, sum of all modules: "
+            << sumtime << " ms/event";
+  if (finish[last] > 0)
+  {
+    std::cout << ", achievable speedup: " << sumtime / finish[last];
+  }
+  std::cout << std::endl
+            << std::endl;
+  return;
+}
+
+//_________________________________________________________________
+int Fun4AllServer::AddSkimGate(const std::string &modulename)
+{
+  if (std::find(m_SkimGateNames.begin(), m_SkimGateNames.end(), modulename) != m_SkimGateNames.end())
+  {
+    std::cout << "Skim gate " << modulename << " already in list" << std::endl;
+    return -1;
+  }
+  m_SkimGateNames.push_back(modulename);
+  m_SkimGatesValid = false;
+  return 0;
+}
+
+//_________________________________________________________________
+int Fun4AllServer::AddModuleOutput(const std::string &modulename, const std::string &outputmanagername)
+{
+  std::pair<std::string, std::string> moduleoutput(modulename, outputmanagername);
+  if (std::find(m_ModuleOutputNames.begin(), m_ModuleOutputNames.end(), moduleoutput) != m_ModuleOutputNames.end())
+  {
+    std::cout << "Output " << outputmanagername << " of module " << modulename << " already in list" << std::endl;
+    return -1;
+  }
+  m_ModuleOutputNames.push_back(moduleoutput);
+  m_SkimGatesValid = false;
+  return 0;
+}
+
+//_________________________________________________________________
+void Fun4AllServer::BuildSkimGates()
+{
+  unsigned int nmodules = Subsystems.size();
+  m_GateOutputs.assign(nmodules, std::vector<unsigned int>());
+  m_ModuleOutputs.assign(nmodules, std::vector<unsigned int>());
+  m_OutputRejected.assign(OutputManager.size(), 0);
+  std::map<std::string, unsigned int> outindex;
+  for (unsigned int iout = 0; iout < OutputManager.size(); iout++)
+  {
+    outindex[OutputManager[iout]->Name()] = iout;
+  }
+  std::set<std::string> unused(m_SkimGateNames.begin(), m_SkimGateNames.end());
+  for (const auto &moduleoutput : m_ModuleOutputNames)
+  {
+    unused.insert(moduleoutput.first);
+  }
+  for (unsigned int i = 0; i < nmodules; i++)
+  {
+    const std::string &name = Subsystems[i].first->Name();
+    bool isgate = (std::find(m_SkimGateNames.begin(), m_SkimGateNames.end(), name) != m_SkimGateNames.end());
+    std::vector<unsigned int> &outputs = m_ModuleOutputs[i];
+    for (const auto &moduleoutput : m_ModuleOutputNames)
+    {
+      if (moduleoutput.first != name)
+      {
+        continue;
+      }
+      std::map<std::string, unsigned int>::const_iterator oiter = outindex.find(moduleoutput.second);
+      if (oiter == outindex.end())
+      {
+        std::cout << PHWHERE << " Output manager " << moduleoutput.second << " of module "
+                  << name << " is not registered, module will not be skipped" << std::endl;
+        outputs.clear();
+        break;
+      }
+      outputs.push_back(oiter->second);
+    }
+    // event selectors also feed the output managers they select for, a gate
+    // can only reject the output managers which use it as event selector
+    for (unsigned int iout = 0; iout < OutputManager.size(); iout++)
+    {
+      std::vector<unsigned> *recoindex = OutputManager[iout]->RecoModuleIndex();
+      if (std::find(recoindex->begin(), recoindex->end(), i) == recoindex->end())
+      {
+        continue;
+      }
+      if (isgate)
+      {
+        m_GateOutputs[i].push_back(iout);
+      }
+      if (!outputs.empty() && std::find(outputs.begin(), outputs.end(), iout) == outputs.end())
+      {
+        outputs.push_back(iout);
+      }
+    }
+    if (isgate && m_GateOutputs[i].empty())
+    {
+      std::cout << PHWHERE << " Skim gate " << name
+                << " is not an event selector of any output manager" << std::endl;
+    }
+    unused.erase(name);
+  }
+  for (const auto &name : unused)
+  {
+    std::cout << PHWHERE << " Module " << name << " used for skim gates is not registered" << std::endl;
+  }
+  m_SkimGatesValid = true;
+  return;
+}
+
+//_________________________________________________________________
+bool Fun4AllServer::SkipModule(const unsigned int icnt)
+{
+  const std::vector<unsigned int> &outputs = m_ModuleOutputs[icnt];
+  if (outputs.empty())
+  {
+    return false;
+  }
+  for (unsigned int iout : outputs)
+  {
+    if (!m_OutputRejected[iout])
+    {
+      return false;
+    }
+  }
+  if (Verbosity() >= VERBOSITY_MORE)
+  {
+    std::cout << "Fun4AllServer::Skipping " << Subsystems[icnt].first->Name()
+              << ", all its output managers rejected the event" << std::endl;
+  }
+  RetCodes[icnt] = Fun4AllReturnCodes::EVENT_OK;
+  m_SkippedEvents[Subsystems[icnt].first->Name() + "_" + Subsystems[icnt].second->getName()]++;
+  return true;
+}
+
+//_________________________________________________________________
+void Fun4AllServer::EvaluateSkimGate(const unsigned int icnt)
+{
+  if (m_GateOutputs[icnt].empty())
+  {
+    return;
+  }
+  const std::string &name = Subsystems[icnt].first->Name();
+  m_SkimGateEvents[name]++;
+  if (RetCodes[icnt] == Fun4AllReturnCodes::EVENT_OK)
+  {
+    m_SkimGateAccepted[name]++;
+    return;
+  }
+  for (unsigned int iout : m_GateOutputs[icnt])
+  {
+    m_OutputRejected[iout] = 1;
+  }
+  return;
+}
+
+//_________________________________________________________________
+void Fun4AllServer::PrintSkimGates() const
+{
+  std::cout << "--------------------------------------" << std::endl
+            << std::endl;
+  std::cout << "Skim gates in Fun4AllServer:" << std::endl;
+  for (const auto &name : m_SkimGateNames)
+  {
+    std::map<std::string, unsigned long>::const_iterator eiter = m_SkimGateEvents.find(name);
+    std::map<std::string, unsigned long>::const_iterator aiter = m_SkimGateAccepted.find(name);
+    unsigned long nevents = (eiter != m_SkimGateEvents.end()) ? eiter->second : 0;
+    unsigned long naccepted = (aiter != m_SkimGateAccepted.end()) ? aiter->second : 0;
+    std::cout << name << ": accepted " << naccepted << " of " << nevents << " events";
+    if (nevents > 0)
+    {
+      std::cout << " (" << 100. * naccepted / nevents << "%)";
+    }
+    std::cout << std::endl;
+  }
+  // the time saved is estimated from the average time of the events the module processed
+  double savedtime = 0;
+  for (const auto &skipped : m_SkippedEvents)
+  {
+    double modtime = 0;
+    std::map<const std::string, PHTimer>::const_iterator titer = timer_map.find(skipped.first);
+    if (titer != timer_map.end() && titer->second.get_ncycle() > 0)
+    {
+      modtime = titer->second.get_time_per_cycle();
+    }
+    std::cout << skipped.first << ": skipped " << skipped.second << " events, saved "
+              << modtime * skipped.second / 1000. << " s" << std::endl;
+    savedtime += modtime * skipped.second;
+  }
+  std::cout << "Total time saved by skim gates: " << savedtime / 1000. << " s" << std::endl
+            << std::endl;
+  return;
+}
+
 int Fun4AllServer::ResetNodeTree()
 {
   std::vector<std::string> ResetNodeList;
@@ -809,6 +1371,7 @@ int Fun4AllServer::BeginRunTimeStamp(PHTimeStamp &TimeStp)
 int Fun4AllServer::BeginRun(const int runno)
 {
   eventcounter = 0;  // reset event counter for every new run
+  m_ModuleGraphValid = false;  // module dependencies are rebuilt for every run
 #ifdef FFAMEMTRACKER
   ffamemtracker->Snapshot("Fun4AllServerBeginRun");
 #endif
@@ -1052,13 +1615,18 @@ int Fun4AllServer::EndRun(const int runno)
 
 int Fun4AllServer::End()
 {
-  recoConsts *rc = recoConsts::instance();
-  EndRun(rc->get_IntFlag("RUNNUMBER"));  // call SubsysReco EndRun methods for current run
+  // with forked workers, EndRun and End of the modules ran in the workers on their events,
+  // here the modules did not process any events
+  if (m_WorkerPids.empty())
+  {
+    recoConsts *rc = recoConsts::instance();
+    EndRun(rc->get_IntFlag("RUNNUMBER"));  // call SubsysReco EndRun methods for current run
+  }
   int i = 0;
   std::vector<std::pair<SubsysReco *, PHCompositeNode *>>::iterator iter;
   gROOT->cd(default_Tdirectory.c_str());
   std::string currdir = gDirectory->GetPath();
-  for (iter = Subsystems.begin(); iter != Subsystems.end(); ++iter)
+  for (iter = Subsystems.begin(); iter != Subsystems.end() && m_WorkerPids.empty(); ++iter)
   {
     if (Verbosity() >= VERBOSITY_SOME)
     {
@@ -1106,7 +1674,8 @@ int Fun4AllServer::End()
   }
   else
   {
-    if (!OutputManager.empty())  // there are registered IO managers
+    // with forked workers, the workers wrote the output files
+    if (!OutputManager.empty() && m_WorkerPids.empty())  // there are registered IO managers
     {
       MakeNodesTransient(runNode);  // make all nodes transient by default
       std::vector<Fun4AllOutputManager *>::iterator IOiter;
@@ -1120,6 +1689,11 @@ int Fun4AllServer::End()
   // done inside outfileclose())
   outfileclose();
 
+  if (!m_SkimGateNames.empty())
+  {
+    PrintSkimGates();
+  }
+
   if (ScreamEveryEvent)
   {
     std::cout << "*******************************************************************************" << std::endl;
@@ -1363,6 +1937,12 @@ int Fun4AllServer::run(const int nevnts, const bool require_nevents)
   int iret = 0;
   int icnt = 0;
   int icnt_good = 0;
+  int nevnts_worker = nevnts;  // events processed by a forked worker
+  if (!m_WorkerPids.empty())
+  {
+    std::cout << PHWHERE << " events were already processed by forked workers, run() can only be called once when using workers" << std::endl;
+    return -1;
+  }
   std::vector<Fun4AllSyncManager *>::const_iterator iter;
   while (!iret)
   {
@@ -1447,6 +2027,42 @@ int Fun4AllServer::run(const int nevnts, const bool require_nevents)
       setRun(runnumber);
       BeginRun(runnumber);
       ifirst = 0;
+      if (m_NumberOfWorkers > 1)
+      {
+        if (require_nevents)
+        {
+          std::cout << "Fun4AllServer: require_nevents is not supported with workers, "
+                    << nevnts << " events will be read" << std::endl;
+        }
+        int ifork = ForkWorkers();
+        if (ifork > 0)
+        {
+          // this is the parent, the events are processed by the workers
+          return WaitForWorkers();
+        }
+        if (ifork == 0)
+        {
+          // worker - with a given number of events every worker processes its own range of them,
+          // otherwise every n-th event. Skip the events of the workers before us
+          // and read the pushed back event again
+          int nskip = m_WorkerId;
+          if (nevnts > 0)
+          {
+            nskip = WorkerFirstEvent(m_WorkerId, nevnts);
+            nevnts_worker = WorkerFirstEvent(m_WorkerId + 1, nevnts) - nskip;
+            if (nevnts_worker <= 0)
+            {
+              FinishWorker();  // no events for us, does not return
+            }
+          }
+          SkipEventsInWorker(nskip);
+          continue;
+        }
+        if (ifork < -1)
+        {
+          return -1;
+        }
+      }
     }
     else if (!run_number_forced)
     {
@@ -1482,7 +2098,7 @@ int Fun4AllServer::run(const int nevnts, const bool require_nevents)
 
     ++icnt;  // completed one event processing
 
-    if (require_nevents)
+    if (require_nevents && m_WorkerId < 0)
     {
       if (std::find(RetCodes.begin(),
                     RetCodes.end(),
@@ -1495,14 +2111,254 @@ int Fun4AllServer::run(const int nevnts, const bool require_nevents)
         break;
       }
     }
-    else if (iret || (nevnts > 0 && icnt >= nevnts))
+    else if (iret || (nevnts > 0 && icnt >= nevnts_worker))
     {
       break;
     }
+    if (m_WorkerId >= 0 && nevnts <= 0)
+    {
+      // skip the events of the other workers
+      SkipEventsInWorker(m_NumberOfWorkers - 1);
+    }
+  }
+  if (m_WorkerId >= 0)
+  {
+    FinishWorker();  // does not return
   }
   return iret;
 }
 
+//_________________________________________________________________
+int Fun4AllServer::ForkWorkers()
+{
+  // generators which were seeded before the fork would produce the same
+  // random numbers in every worker, we cannot reseed them from here
+  if (PHRandomSeed::NumberOfSeeds() > 0)
+  {
+    std::cout << PHWHERE << " " << PHRandomSeed::NumberOfSeeds()
+              << " random seeds were handed out before forking (e.g. in Init/InitRun of generator or simulation modules),"
+              << " every worker would repeat the same random sequence. Not processing any events,"
+              << " use NumberOfWorkers(1) for this job" << std::endl;
+    return -2;
+  }
+  // push back the event which was read for the first BeginRun,
+  // so the workers read it again
+  std::vector<Fun4AllInputManager *> pushedback;
+  for (Fun4AllSyncManager *syncman : SyncManagers)
+  {
+    for (Fun4AllInputManager *inman : syncman->GetInputManagers())
+    {
+      if (inman->PushBackEvents(1))
+      {
+        std::cout << PHWHERE << " " << inman->Name() << " cannot push back events, running in a single process" << std::endl;
+        for (Fun4AllInputManager *done : pushedback)
+        {
+          done->PushBackEvents(-1);
+        }
+        m_NumberOfWorkers = 1;
+        return -1;
+      }
+      pushedback.push_back(inman);
+    }
+  }
+  ResetNodeTree();
+  // threads do not survive the fork, the workers start their own
+  delete m_ThreadPool;
+  m_ThreadPool = nullptr;
+
+  std::cout << "Fun4AllServer: forking " << m_NumberOfWorkers << " workers" << std::endl;
+  // do not let the workers inherit unflushed output
+  std::cout.flush();
+  fflush(stdout);
+  for (int iworker = 0; iworker < m_NumberOfWorkers; iworker++)
+  {
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+      std::cout << PHWHERE << " could not fork worker " << iworker << ": " << strerror(errno) << std::endl;
+      for (int workerpid : m_WorkerPids)
+      {
+        kill(workerpid, SIGKILL);
+        waitpid(workerpid, nullptr, 0);
+      }
+      gSystem->Exit(1);
+    }
+    if (pid == 0)
+    {
+      m_WorkerId = iworker;
+      m_WorkerPids.clear();
+      recoConsts *rc = recoConsts::instance();
+      rc->set_IntFlag("FUN4ALL_WORKER", iworker);
+      // seeds drawn from now on (e.g. in InitRun for a new run) differ between workers
+      PHRandomSeed::InitWorkerSeed(iworker);
+      gRandom->SetSeed(PHRandomSeed());
+      for (Fun4AllSyncManager *syncman : SyncManagers)
+      {
+        for (Fun4AllInputManager *inman : syncman->GetInputManagers())
+        {
+          if (inman->ReopenAfterFork())
+          {
+            std::cout << PHWHERE << " worker " << iworker << ": " << inman->Name()
+                      << " cannot reopen its input in a forked process" << std::endl;
+            _exit(1);
+          }
+        }
+      }
+      // each worker writes its own output files
+      for (Fun4AllOutputManager *outman : OutputManager)
+      {
+        if (!outman->OutFileName().empty())
+        {
+          std::filesystem::path p = outman->OutFileName();
+          std::string workerfile = p.stem().string() + "_worker" + std::to_string(iworker) + p.extension().string();
+          outman->OutFileName((p.parent_path() / workerfile).string());
+        }
+      }
+      return 0;
+    }
+    m_WorkerPids.push_back(pid);
+  }
+  return 1;
+}
+
+//_________________________________________________________________
+int Fun4AllServer::WaitForWorkers()
+{
+  int nfailed = 0;
+  for (unsigned int iworker = 0; iworker < m_WorkerPids.size(); iworker++)
+  {
+    int status = 0;
+    if (waitpid(m_WorkerPids[iworker], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+      std::cout << PHWHERE << " worker " << iworker << " (pid " << m_WorkerPids[iworker] << ") failed" << std::endl;
+      nfailed++;
+    }
+  }
+  // add the histograms of all workers to ours, the histograms in this process
+  // are still empty since the workers processed all events
+  for (unsigned int iworker = 0; iworker < m_WorkerPids.size(); iworker++)
+  {
+    std::string fname = WorkerHistoFileName(iworker);
+    TFile *f = TFile::Open(fname.c_str(), "READ");
+    if (!f || f->IsZombie())
+    {
+      std::cout << PHWHERE << " could not open histogram file " << fname
+                << " of worker " << iworker << std::endl;
+      delete f;
+      continue;
+    }
+    for (Fun4AllHistoManager *histomanager : HistoManager)
+    {
+      TDirectory *dir = f->GetDirectory(histomanager->Name().c_str());
+      if (!dir)
+      {
+        continue;
+      }
+      for (unsigned int ihisto = 0; ihisto < histomanager->nHistos(); ihisto++)
+      {
+        TNamed *histo = histomanager->getHisto(ihisto);
+        TObject *workerhisto = dir->Get(std::to_string(ihisto).c_str());
+        if (!histo || !workerhisto || std::string(histo->GetName()) != workerhisto->GetName())
+        {
+          if (Verbosity() > 0)
+          {
+            std::cout << "Fun4AllServer: " << histomanager->getHistoName(ihisto)
+                      << " not found for worker " << iworker << std::endl;
+          }
+          continue;
+        }
+        // TTree::Merge appends the entries of the worker tree
+        ROOT::MergeFunc_t merge = histo->IsA()->GetMerge();
+        if (merge)
+        {
+          TList histolist;
+          histolist.Add(workerhisto);
+          merge(histo, &histolist, nullptr);
+        }
+      }
+    }
+    delete f;
+    std::remove(fname.c_str());
+  }
+  return (nfailed ? -1 : 0);
+}
+
+//_________________________________________________________________
+void Fun4AllServer::FinishWorker()
+{
+  // save our histograms before End(), the parent adds them up
+  int iret = 0;
+  TFile f(WorkerHistoFileName(m_WorkerId).c_str(), "RECREATE");
+  if (f.IsZombie())
+  {
+    std::cout << PHWHERE << " worker " << m_WorkerId << " could not open "
+              << WorkerHistoFileName(m_WorkerId) << std::endl;
+    iret = 1;
+  }
+  else
+  {
+    for (Fun4AllHistoManager *histomanager : HistoManager)
+    {
+      TDirectory *dir = f.mkdir(histomanager->Name().c_str());
+      for (unsigned int ihisto = 0; ihisto < histomanager->nHistos(); ihisto++)
+      {
+        TNamed *histo = histomanager->getHisto(ihisto);
+        if (histo)
+        {
+          dir->WriteTObject(histo, std::to_string(ihisto).c_str());
+        }
+      }
+    }
+    f.Close();
+  }
+  // closes our output files
+  End();
+  std::cout.flush();
+  fflush(stdout);
+  // skip the exit handlers, whatever was set up before the fork belongs to the parent
+  _exit(iret);
+}
+
+//_________________________________________________________________
+void Fun4AllServer::SkipEventsInWorker(const int nevnts)
+{
+  if (nevnts <= 0)
+  {
+    return;
+  }
+  // the input managers skip without reading the events, every input manager
+  // supports this since the fork pushed back an event in each of them
+  for (Fun4AllSyncManager *syncman : SyncManagers)
+  {
+    for (Fun4AllInputManager *inman : syncman->GetInputManagers())
+    {
+      if (inman->skip(nevnts))
+      {
+        std::cout << PHWHERE << " worker " << m_WorkerId << ": " << inman->Name()
+                  << " could not skip " << nevnts << " events, exiting" << std::endl;
+        std::cout.flush();
+        fflush(stdout);
+        _exit(1);
+      }
+    }
+  }
+  eventcounter += nevnts;  // so it reflects the number of events in the input
+}
+
+//_________________________________________________________________
+int Fun4AllServer::WorkerFirstEvent(const int iworker, const int nevnts) const
+{
+  return static_cast<int>(static_cast<long long>(nevnts) * iworker / m_NumberOfWorkers);
+}
+
+//_________________________________________________________________
+std::string Fun4AllServer::WorkerHistoFileName(const int iworker) const
+{
+  int parentpid = (m_WorkerId < 0 ? getpid() : getppid());
+  std::string fname = "fun4all_" + std::to_string(parentpid) + "_worker" + std::to_string(iworker) + ".root";
+  return (std::filesystem::temp_directory_path() / fname).string();
+}
+
 //_________________________________________________________________
 int Fun4AllServer::skip(const int nevnts)
 {
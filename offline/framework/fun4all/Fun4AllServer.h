@@ -20,6 +20,7 @@ class Fun4AllInputManager;
 class Fun4AllMemoryTracker;
 class Fun4AllSyncManager;
 class Fun4AllOutputManager;
+class Fun4AllThreadPool;
 class PHCompositeNode;
 class PHTimeStamp;
 class SubsysReco;
@@ -117,6 +118,52 @@ class Fun4AllServer : public Fun4AllBase
   std::map<const std::string, PHTimer>::const_iterator timer_begin() { return timer_map.begin(); }
   std::map<const std::string, PHTimer>::const_iterator timer_end() { return timer_map.end(); }
 
+  /*!
+    \brief process events in n forked worker processes.
+    The workers are forked by run() after the first BeginRun, so they share
+    everything which was set up in Init/InitRun. For run(nevnts) each worker
+    processes its own contiguous range of the nevnts events, for run(0) every
+    n-th event. Workers skip the events of the others with skip() of their input
+    managers without reading them, like Fun4AllServer::skip() this does not carry
+    over to the next file of a file list. Seeds from PHRandomSeed differ between workers (reproducible
+    with a fixed RANDOMSEED). If any seed was handed out before the fork the
+    generators would repeat in every worker, run() then returns an error without
+    processing events. DST output goes into one file per worker
+    (<name>_worker<i>.<ext>). Histograms and TTrees registered with Histo Managers
+    are saved by each worker before its End() and added up in this process once
+    all workers are done. EndRun and End of the modules only run in the workers.
+    Modules which open their own output files need to use WorkerId() to make their names unique
+  */
+  void NumberOfWorkers(const int n) { m_NumberOfWorkers = n; }
+  int NumberOfWorkers() const { return m_NumberOfWorkers; }
+  //! index of this worker, -1 if this is not a forked worker
+  int WorkerId() const { return m_WorkerId; }
+
+  /*!
+    \brief run modules concurrently on n threads (1: sequentially in registration order).
+    The module dependencies are derived once per run from the nodes declared by
+    SubsysReco::DeclareInputNode/DeclareOutputNode, modules without declarations
+    keep their place in the registration order. The n-1 extra threads are started
+    with the first event and kept until the server is deleted (or workers are forked)
+  */
+  void ConcurrentThreads(const int n) { m_ConcurrentThreads = n; }
+  int ConcurrentThreads() const { return m_ConcurrentThreads; }
+  //! print the module dependencies, the critical path and the achievable speedup using the module timers
+  void PrintModuleGraph();
+
+  /*!
+    \brief use the event selector module modulename as skim gate.
+    The return code of a gate is evaluated right after it ran, if it discards the event
+    all output managers which use it as event selector are rejected for this event.
+    Modules which only feed rejected output managers (see AddModuleOutput) are then
+    skipped for the rest of the event. Only used when modules run sequentially
+  */
+  int AddSkimGate(const std::string &modulename);
+  //! declare that the output of module modulename is only written by output manager outputmanagername
+  int AddModuleOutput(const std::string &modulename, const std::string &outputmanagername);
+  //! print the acceptance of the skim gates and the time saved by skipping modules
+  void PrintSkimGates() const;
+
  protected:
   Fun4AllServer(const std::string &name = "Fun4AllServer");
   int InitNodeTree(PHCompositeNode *topNode);
@@ -125,6 +172,18 @@ class Fun4AllServer : public Fun4AllBase
   int UpdateEventSelector(Fun4AllOutputManager *manager);
   int unregisterSubsystemsNow();
   int setRun(const int runnumber);
+  int ForkWorkers();
+  int WaitForWorkers();
+  void FinishWorker();
+  void SkipEventsInWorker(const int nevnts);
+  std::string WorkerHistoFileName(const int iworker) const;
+  int WorkerFirstEvent(const int iworker, const int nevnts) const;
+  int ProcessEventSubsystem(const unsigned int icnt);
+  void ProcessEventConcurrently();
+  void BuildModuleGraph();
+  void BuildSkimGates();
+  bool SkipModule(const unsigned int icnt);
+  void EvaluateSkimGate(const unsigned int icnt);
   static Fun4AllServer *__instance;
   TH1 *FrameWorkVars = nullptr;
   Fun4AllMemoryTracker *ffamemtracker = nullptr;
@@ -132,6 +191,7 @@ class Fun4AllServer : public Fun4AllBase
   PHTimeStamp *beginruntimestamp = nullptr;
   PHCompositeNode *TopNode = nullptr;
   Fun4AllSyncManager *defaultSyncManager = nullptr;
+  Fun4AllThreadPool *m_ThreadPool = nullptr;
 
   int OutNodeCount = 0;
   int bortime_override = 0;
@@ -141,6 +201,10 @@ class Fun4AllServer : public Fun4AllBase
   int eventnumber = 0;
   int eventcounter = 0;
   int keep_db_connected = 0;
+  int m_NumberOfWorkers = 1;
+  int m_WorkerId = -1;
+  int m_ConcurrentThreads = 1;
+  bool m_ModuleGraphValid = false;
 
   std::vector<std::string> ComplaintList;
   std::vector<std::pair<SubsysReco *, PHCompositeNode *>> Subsystems;
@@ -155,6 +219,21 @@ class Fun4AllServer : public Fun4AllBase
   std::vector<Fun4AllSyncManager *> SyncManagers;
   std::map<int, int> retcodesmap;
   std::map<const std::string, PHTimer> timer_map;
+  std::vector<int> m_WorkerPids;
+  // direct dependencies between modules (index in Subsystems), predecessors are always registered before
+  std::vector<std::vector<unsigned int>> m_ModulePredecessors;
+  std::vector<std::vector<unsigned int>> m_ModuleSuccessors;
+  std::vector<char> m_ModuleDone;
+  // skim gates, the module and output manager indices are rebuilt when modules or output managers change
+  bool m_SkimGatesValid = false;
+  std::vector<std::string> m_SkimGateNames;
+  std::vector<std::pair<std::string, std::string>> m_ModuleOutputNames;
+  std::vector<std::vector<unsigned int>> m_GateOutputs;    // output managers rejected by a gate, per module
+  std::vector<std::vector<unsigned int>> m_ModuleOutputs;  // output managers fed by a module, empty: never skipped
+  std::vector<char> m_OutputRejected;
+  std::map<std::string, unsigned long> m_SkimGateEvents;
+  std::map<std::string, unsigned long> m_SkimGateAccepted;
+  std::map<std::string, unsigned long> m_SkippedEvents;
 };
 
 #endif
@@ -5,6 +5,7 @@
 
 #include "Fun4AllBase.h"
 
+#include <set>
 #include <string>
 
 class PHCompositeNode;
@@ -60,6 +61,27 @@ class SubsysReco : public Fun4AllBase
 
   void Print(const std::string & /*what*/ = "ALL") const override {}
 
+  /** Declare the nodes (by name, under this module's topNode) which are read
+      and written in process_event(). Fun4AllServer runs modules concurrently
+      when their declared nodes do not overlap (see Fun4AllServer::ConcurrentThreads()).
+      A module without declarations is run after all modules registered before
+      it and before all modules registered after it.
+      Nodes must not be created in process_event() by modules which declare their nodes.
+   */
+  void DeclareInputNode(const std::string &nodename)
+  {
+    m_InputNodes.insert(nodename);
+    m_DeclaredNodes = true;
+  }
+  void DeclareOutputNode(const std::string &nodename)
+  {
+    m_OutputNodes.insert(nodename);
+    m_DeclaredNodes = true;
+  }
+  const std::set<std::string> &InputNodes() const { return m_InputNodes; }
+  const std::set<std::string> &OutputNodes() const { return m_OutputNodes; }
+  bool DeclaredNodes() const { return m_DeclaredNodes; }
+
  protected:
   /** ctor.
       @param name is the reference used inside the Fun4AllServer
@@ -68,6 +90,11 @@ class SubsysReco : public Fun4AllBase
     : Fun4AllBase(name)
   {
   }
+
+ private:
+  bool m_DeclaredNodes = false;
+  std::set<std::string> m_InputNodes;
+  std::set<std::string> m_OutputNodes;
 };
 
 #endif
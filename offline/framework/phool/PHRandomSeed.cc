@@ -13,6 +13,7 @@ static std::uniform_int_distribution<unsigned int> fDistribution;
 bool PHRandomSeed::fInitialized(false);
 bool PHRandomSeed::fFixed(false);
 int PHRandomSeed::verbose(1);
+unsigned int PHRandomSeed::fNumberOfSeeds(0);
 
 unsigned int PHRandomSeed::GetSeed()
 {
@@ -38,6 +39,7 @@ unsigned int PHRandomSeed::GetSeed()
       iseed = rdev();
     }
   }
+  ++fNumberOfSeeds;
   if (verbose)
   {
     std::cout << "PHRandomSeed::GetSeed() seed: " << iseed << std::endl;
@@ -59,6 +61,33 @@ void PHRandomSeed::InitSeed()
   }
 }
 
+void PHRandomSeed::InitWorkerSeed(const int worker)
+{
+  // preloaded seeds would be handed out identically in every worker
+  if (!seedqueue.empty())
+  {
+    std::cout << "PHRandomSeed: worker " << worker << " drops " << seedqueue.size()
+              << " preloaded seeds" << std::endl;
+    std::queue<unsigned int>().swap(seedqueue);
+  }
+  recoConsts *rc = recoConsts::instance();
+  if (rc->FlagExist("RANDOMSEED"))
+  {
+    // derive the worker seed from the fixed seed and the worker id
+    std::seed_seq seq{static_cast<unsigned int>(rc->get_IntFlag("RANDOMSEED")), static_cast<unsigned int>(worker)};
+    std::mt19937 seedgen(seq);
+    const unsigned int seed = fDistribution(seedgen);
+    // for modules which use RANDOMSEED directly
+    rc->set_IntFlag("RANDOMSEED", static_cast<int>(seed));
+    std::cout << "PHRandomSeed: worker " << worker << " using fixed seed " << seed << std::endl;
+    fRandomGenerator.seed(seed);
+    fDistribution.reset();
+    fFixed = true;
+    fInitialized = true;
+  }
+  // otherwise the seeds come from std::random_device, which differs between processes
+}
+
 void PHRandomSeed::LoadSeed(const unsigned int iseed)
 {
   seedqueue.push(iseed);
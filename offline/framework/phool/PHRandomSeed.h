@@ -20,6 +20,11 @@ class PHRandomSeed
   //! get a seed
   static unsigned int GetSeed();
   static void LoadSeed(const unsigned int iseed);
+  //! number of seeds handed out so far
+  static unsigned int NumberOfSeeds() { return fNumberOfSeeds; }
+  //! restart the seed sequence in a forked worker process, seeds differ between workers.
+  //! With a fixed RANDOMSEED the sequence of each worker is reproducible
+  static void InitWorkerSeed(const int worker);
   static void Verbosity(const int iverb);
   static int Verbosity() { return verbose; };
 
@@ -28,6 +33,7 @@ class PHRandomSeed
   static bool fFixed;
   static bool fInitialized;
   static int verbose;
+  static unsigned int fNumberOfSeeds;
 };
 
 #endif
@@ -0,0 +1,126 @@
+#include "RawTowerGeomTable.h"
+
+#include "RawTowerGeom.h"
+#include "RawTowerGeomContainer.h"
+#include "RawTowerGeomContainer_Cylinderv1.h"
+#include "TowerInfoContainer.h"
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <algorithm>  // for max
+#include <iostream>
+#include <utility>    // for pair
+
+RawTowerGeomTable::RawTowerGeomTable(RawTowerGeomContainer *geom)
+{
+  if (geom)
+  {
+    build(geom);
+  }
+}
+
+RawTowerGeomTable *RawTowerGeomTable::GetTable(PHCompositeNode *topNode, const std::string &geomnodename)
+{
+  RawTowerGeomContainer *geom = findNode::getClass<RawTowerGeomContainer>(topNode, geomnodename);
+  if (!geom)
+  {
+    return nullptr;
+  }
+  const std::string tablenodename = geomnodename + "_TABLE";
+  RawTowerGeomTable *table = findNode::getClass<RawTowerGeomTable>(topNode, tablenodename);
+  if (!table)
+  {
+    PHNodeIterator iter(topNode);
+    PHCompositeNode *runNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "RUN"));
+    if (!runNode)
+    {
+      std::cout << PHWHERE << " RUN node missing, cannot store " << tablenodename << std::endl;
+      return nullptr;
+    }
+    table = new RawTowerGeomTable(geom);
+    runNode->addNode(new PHDataNode<RawTowerGeomTable>(table, tablenodename));
+  }
+  else if (!table->is_built_from(geom))
+  {
+    table->build(geom);
+  }
+  return table;
+}
+
+bool RawTowerGeomTable::is_built_from(const RawTowerGeomContainer *geom) const
+{
+  return geom == m_Geom && geom->size() == m_NTowers;
+}
+
+void RawTowerGeomTable::build(RawTowerGeomContainer *geom)
+{
+  m_Geom = geom;
+  m_NTowers = geom->size();
+  m_CaloId = geom->get_calorimeter_id();
+  // the binning is taken from the tower keys, this works for all geometry containers
+  m_EtaBins = 0;
+  m_PhiBins = 0;
+  RawTowerGeomContainer::ConstRange begin_end = geom->get_tower_geometries();
+  for (auto iter = begin_end.first; iter != begin_end.second; ++iter)
+  {
+    m_EtaBins = std::max(m_EtaBins, static_cast<int>(RawTowerDefs::decode_index1(iter->first)) + 1);
+    m_PhiBins = std::max(m_PhiBins, static_cast<int>(RawTowerDefs::decode_index2(iter->first)) + 1);
+  }
+  unsigned int ntable = m_EtaBins * m_PhiBins;
+  m_HasTower.assign(ntable, 0);
+  m_Key.assign(ntable, 0);
+  m_Eta.assign(ntable, 0);
+  m_Phi.assign(ntable, 0);
+  m_X.assign(ntable, 0);
+  m_Y.assign(ntable, 0);
+  m_Z.assign(ntable, 0);
+  m_R.assign(ntable, 0);
+  m_EtaBin.assign(ntable, -1);
+  m_PhiBin.assign(ntable, -1);
+  // the channel map has to be redone for a new geometry
+  m_ChannelDetector = -1;
+  m_ChannelIndex.clear();
+
+  // get_etabin/get_phibin are only implemented for cylindrical calorimeters
+  const RawTowerGeomContainer_Cylinderv1 *cylinder = dynamic_cast<const RawTowerGeomContainer_Cylinderv1 *>(geom);
+  for (auto iter = begin_end.first; iter != begin_end.second; ++iter)
+  {
+    const RawTowerGeom *tower_geom = iter->second;
+    unsigned int i = index_of_key(iter->first);
+    m_HasTower[i] = 1;
+    m_Key[i] = iter->first;
+    m_Eta[i] = tower_geom->get_eta();
+    m_Phi[i] = tower_geom->get_phi();
+    m_X[i] = tower_geom->get_center_x();
+    m_Y[i] = tower_geom->get_center_y();
+    m_Z[i] = tower_geom->get_center_z();
+    m_R[i] = tower_geom->get_center_radius();
+    if (cylinder)
+    {
+      m_EtaBin[i] = cylinder->get_etabin(tower_geom->get_eta());
+      m_PhiBin[i] = cylinder->get_phibin(tower_geom->get_phi());
+    }
+  }
+}
+
+void RawTowerGeomTable::map_channels(TowerInfoContainer *towerinfos)
+{
+  if (m_ChannelDetector == towerinfos->get_detectorid() && m_ChannelIndex.size() == towerinfos->size())
+  {
+    return;
+  }
+  m_ChannelDetector = towerinfos->get_detectorid();
+  unsigned int nchannels = towerinfos->size();
+  m_ChannelIndex.resize(nchannels);
+  for (unsigned int channel = 0; channel < nchannels; channel++)
+  {
+    unsigned int calokey = towerinfos->encode_key(channel);
+    int ieta = towerinfos->getTowerEtaBin(calokey);
+    int iphi = towerinfos->getTowerPhiBin(calokey);
+    m_ChannelIndex[channel] = (ieta < m_EtaBins && iphi < m_PhiBins) ? index(ieta, iphi) : size();
+  }
+}
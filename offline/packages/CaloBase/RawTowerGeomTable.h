@@ -0,0 +1,92 @@
+#ifndef CALOBASE_RAWTOWERGEOMTABLE_H
+#define CALOBASE_RAWTOWERGEOMTABLE_H
+
+#include "RawTowerDefs.h"
+
+#include <string>
+#include <vector>
+
+class PHCompositeNode;
+class RawTowerGeomContainer;
+class TowerInfoContainer;
+
+/*! \class RawTowerGeomTable
+    \brief dense copy of a RawTowerGeomContainer for fast per tower access
+
+    The tower centers are stored in flat arrays indexed by
+    ieta * phibins + iphi (the tower indices of the RawTowerDefs key),
+    which replaces the map lookup of RawTowerGeomContainer::get_tower_geometry().
+    The table lives in a (transient) PHDataNode on the RUN node next to the
+    geometry container, so all modules share it, use GetTable() to access it.
+    Towers which are not in the geometry container have has_tower() false.
+*/
+class RawTowerGeomTable
+{
+ public:
+  explicit RawTowerGeomTable(RawTowerGeomContainer *geom = nullptr);
+  virtual ~RawTowerGeomTable() = default;
+
+  //! get the table for geometry node geomnodename (e.g. TOWERGEOM_CEMC), it is created
+  //! or updated if the geometry container has changed. Returns nullptr without geometry node
+  static RawTowerGeomTable *GetTable(PHCompositeNode *topNode, const std::string &geomnodename);
+
+  //! (re)fill the table from the geometry container
+  void build(RawTowerGeomContainer *geom);
+
+  //! true if the table was built from this geometry container (and it did not change size)
+  bool is_built_from(const RawTowerGeomContainer *geom) const;
+
+  RawTowerDefs::CalorimeterId get_calorimeter_id() const { return m_CaloId; }
+  int get_etabins() const { return m_EtaBins; }
+  int get_phibins() const { return m_PhiBins; }
+  unsigned int size() const { return m_Eta.size(); }
+
+  //! index of tower bin (ieta, iphi)
+  unsigned int index(const int ieta, const int iphi) const { return (ieta * m_PhiBins) + iphi; }
+  //! index of tower key
+  unsigned int index_of_key(const RawTowerDefs::keytype key) const
+  {
+    return index(RawTowerDefs::decode_index1(key), RawTowerDefs::decode_index2(key));
+  }
+
+  //! translate the TowerInfo channels of this calorimeter into table indices,
+  //! only redone if the TowerInfo container type or size changed
+  void map_channels(TowerInfoContainer *towerinfos);
+  //! index of TowerInfo channel, needs map_channels(). Channels outside the geometry get size()
+  unsigned int index_of_channel(const unsigned int channel) const { return m_ChannelIndex[channel]; }
+
+  bool has_tower(const unsigned int i) const { return i < m_HasTower.size() && m_HasTower[i]; }
+  RawTowerDefs::keytype get_key(const unsigned int i) const { return m_Key[i]; }
+  float get_eta(const unsigned int i) const { return m_Eta[i]; }
+  float get_phi(const unsigned int i) const { return m_Phi[i]; }
+  float get_center_x(const unsigned int i) const { return m_X[i]; }
+  float get_center_y(const unsigned int i) const { return m_Y[i]; }
+  float get_center_z(const unsigned int i) const { return m_Z[i]; }
+  float get_center_radius(const unsigned int i) const { return m_R[i]; }
+  //! eta/phi bin of the tower center in the cylinder binning (RawTowerGeomContainer::get_etabin(eta)),
+  //! -1 for non cylindrical geometries
+  int get_etabin(const unsigned int i) const { return m_EtaBin[i]; }
+  int get_phibin(const unsigned int i) const { return m_PhiBin[i]; }
+
+ private:
+  const RawTowerGeomContainer *m_Geom = nullptr;
+  unsigned int m_NTowers = 0;
+  RawTowerDefs::CalorimeterId m_CaloId = RawTowerDefs::NONE;
+  int m_EtaBins = 0;
+  int m_PhiBins = 0;
+
+  std::vector<char> m_HasTower;
+  std::vector<RawTowerDefs::keytype> m_Key;
+  std::vector<float> m_Eta;
+  std::vector<float> m_Phi;
+  std::vector<float> m_X;
+  std::vector<float> m_Y;
+  std::vector<float> m_Z;
+  std::vector<float> m_R;
+  std::vector<int> m_EtaBin;
+  std::vector<int> m_PhiBin;
+  int m_ChannelDetector = -1;
+  std::vector<unsigned int> m_ChannelIndex;
+};
+
+#endif
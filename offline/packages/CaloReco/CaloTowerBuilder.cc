@@ -154,6 +154,23 @@ int CaloTowerBuilder::InitRun(PHCompositeNode *topNode)
   }
 
   CreateNodeTree(topNode);
+
+  // lets Fun4AllServer run this module concurrently with modules using other nodes
+  if (!m_isdata)
+  {
+    DeclareInputNode(m_inputNodePrefix + m_detector);
+  }
+  else if (m_UseOfflinePacketFlag)
+  {
+    DeclareInputNode(nodemap.find(m_dettype)->second);
+  }
+  else
+  {
+    // decoding from the Event object is not known to be thread safe,
+    // declaring it as output serializes all modules reading it
+    DeclareOutputNode("PRDF");
+  }
+  DeclareOutputNode(TowerNodeName);
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
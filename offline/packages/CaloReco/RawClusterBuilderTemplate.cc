@@ -223,6 +223,20 @@ int RawClusterBuilderTemplate::InitRun(PHCompositeNode *topNode)
     //    PrintCylGeom(towergeom,"phieta.txt");
   }
 
+  // lets Fun4AllServer run this module concurrently with modules using other nodes
+  if (m_UseTowerInfo < 1)
+  {
+    DeclareInputNode("TOWER_CALIB_" + detector);
+  }
+  if (m_UseTowerInfo > 0)
+  {
+    DeclareInputNode(m_inputnodename.empty() ? "TOWERINFO_CALIB_" + detector : m_inputnodename);
+  }
+  DeclareInputNode(towergeomnodename);
+  DeclareInputNode("GlobalVertexMap");
+  DeclareInputNode("MbdVertexMap");
+  DeclareOutputNode(ClusterNodeName);
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
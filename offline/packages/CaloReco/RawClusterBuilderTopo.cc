@@ -6,6 +6,7 @@
 #include <calobase/RawTowerDefs.h>  // for encode_towerid, Calorime...
 #include <calobase/RawTowerGeom.h>
 #include <calobase/RawTowerGeomContainer.h>
+#include <calobase/RawTowerGeomTable.h>
 #include <calobase/TowerInfo.h>           // for TowerInfo
 #include <calobase/TowerInfoContainer.h>  // for TowerInfoContainer
 
@@ -263,7 +264,8 @@ void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_tow
       this_key = _TOWERMAP_KEY_LAYER_ETA_PHI[this_layer][this_ieta][this_iphi];
     }
 
-    RawTowerGeom *tower_geom = _geom_containers[this_layer]->get_tower_geometry(this_key);
+    const RawTowerGeomTable *geomtable = _geom_tables[this_layer];
+    unsigned int itower = geomtable->index_of_key(this_key);
 
     if (the_pair.second == -1)
     {
@@ -272,9 +274,9 @@ void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_tow
       clusters_E[the_pair.first] = clusters_E[the_pair.first] + this_E;
       clusters_absE[the_pair.first] = clusters_absE[the_pair.first] + std::fabs(this_E);
       // calculate position mean using absolute energy as weights
-      clusters_x[the_pair.first] = clusters_x[the_pair.first] + std::fabs(this_E) * tower_geom->get_center_x();
-      clusters_y[the_pair.first] = clusters_y[the_pair.first] + std::fabs(this_E) * tower_geom->get_center_y();
-      clusters_z[the_pair.first] = clusters_z[the_pair.first] + std::fabs(this_E) * tower_geom->get_center_z();
+      clusters_x[the_pair.first] = clusters_x[the_pair.first] + std::fabs(this_E) * geomtable->get_center_x(itower);
+      clusters_y[the_pair.first] = clusters_y[the_pair.first] + std::fabs(this_E) * geomtable->get_center_y(itower);
+      clusters_z[the_pair.first] = clusters_z[the_pair.first] + std::fabs(this_E) * geomtable->get_center_z(itower);
 
       if (Verbosity() > 5)
       {
@@ -284,8 +286,8 @@ void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_tow
     else
     {
       // assigned to two clusters! get energy sharing fraction ...
-      float dR1 = calculate_dR(tower_geom->get_eta(), pseudocluster_eta[the_pair.first], tower_geom->get_phi(), pseudocluster_phi[the_pair.first]) / _R_shower;
-      float dR2 = calculate_dR(tower_geom->get_eta(), pseudocluster_eta[the_pair.second], tower_geom->get_phi(), pseudocluster_phi[the_pair.second]) / _R_shower;
+      float dR1 = calculate_dR(geomtable->get_eta(itower), pseudocluster_eta[the_pair.first], geomtable->get_phi(itower), pseudocluster_phi[the_pair.first]) / _R_shower;
+      float dR2 = calculate_dR(geomtable->get_eta(itower), pseudocluster_eta[the_pair.second], geomtable->get_phi(itower), pseudocluster_phi[the_pair.second]) / _R_shower;
       float r = std::exp(dR1 - dR2);
       float frac1 = fabs(pseudocluster_sumE[the_pair.first]) / (fabs(pseudocluster_sumE[the_pair.first]) + r * fabs(pseudocluster_sumE[the_pair.second]));
 
@@ -296,16 +298,16 @@ void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_tow
       clusters[the_pair.first]->addTower(this_key, this_E * frac1);
       clusters_E[the_pair.first] = clusters_E[the_pair.first] + this_E * frac1;
       clusters_absE[the_pair.first] = clusters_absE[the_pair.first] + std::fabs(this_E) * frac1;
-      clusters_x[the_pair.first] = clusters_x[the_pair.first] + std::fabs(this_E) * tower_geom->get_center_x() * frac1;
-      clusters_y[the_pair.first] = clusters_y[the_pair.first] + std::fabs(this_E) * tower_geom->get_center_y() * frac1;
-      clusters_z[the_pair.first] = clusters_z[the_pair.first] + std::fabs(this_E) * tower_geom->get_center_z() * frac1;
+      clusters_x[the_pair.first] = clusters_x[the_pair.first] + std::fabs(this_E) * geomtable->get_center_x(itower) * frac1;
+      clusters_y[the_pair.first] = clusters_y[the_pair.first] + std::fabs(this_E) * geomtable->get_center_y(itower) * frac1;
+      clusters_z[the_pair.first] = clusters_z[the_pair.first] + std::fabs(this_E) * geomtable->get_center_z(itower) * frac1;
 
       clusters[the_pair.second]->addTower(this_key, this_E * (1 - frac1));
       clusters_E[the_pair.second] = clusters_E[the_pair.second] + this_E * (1 - frac1);
       clusters_absE[the_pair.second] = clusters_absE[the_pair.second] + std::fabs(this_E) * (1 - frac1);
-      clusters_x[the_pair.second] = clusters_x[the_pair.second] + std::fabs(this_E) * tower_geom->get_center_x() * (1 - frac1);
-      clusters_y[the_pair.second] = clusters_y[the_pair.second] + std::fabs(this_E) * tower_geom->get_center_y() * (1 - frac1);
-      clusters_z[the_pair.second] = clusters_z[the_pair.second] + std::fabs(this_E) * tower_geom->get_center_z() * (1 - frac1);
+      clusters_x[the_pair.second] = clusters_x[the_pair.second] + std::fabs(this_E) * geomtable->get_center_x(itower) * (1 - frac1);
+      clusters_y[the_pair.second] = clusters_y[the_pair.second] + std::fabs(this_E) * geomtable->get_center_y(itower) * (1 - frac1);
+      clusters_z[the_pair.second] = clusters_z[the_pair.second] + std::fabs(this_E) * geomtable->get_center_z(itower) * (1 - frac1);
     }
   }
 
@@ -352,6 +354,7 @@ RawClusterBuilderTopo::RawClusterBuilderTopo(const std::string &name)
   _HCAL_NETA = -1;
   _HCAL_NPHI = -1;
   std::fill(std::begin(_geom_containers), std::end(_geom_containers), nullptr);
+  std::fill(std::begin(_geom_tables), std::end(_geom_tables), nullptr);
   _noise_LAYER[0] = 0.0025;
   _noise_LAYER[1] = 0.006;
   _noise_LAYER[2] = 0.03;  // EM
@@ -446,6 +449,14 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     return Fun4AllReturnCodes::ABORTEVENT;
   }
 
+  // dense copies of the geometry, indexed by TowerInfo channel, replace the per tower map lookups
+  _geom_tables[0] = RawTowerGeomTable::GetTable(topNode, "TOWERGEOM_HCALIN");
+  _geom_tables[1] = RawTowerGeomTable::GetTable(topNode, "TOWERGEOM_HCALOUT");
+  _geom_tables[2] = RawTowerGeomTable::GetTable(topNode, "TOWERGEOM_CEMC");
+  _geom_tables[0]->map_channels(towerinfosIH);
+  _geom_tables[1]->map_channels(towerinfosOH);
+  _geom_tables[2]->map_channels(towerinfosEM);
+
   if (Verbosity() > 10)
   {
     std::cout << "RawClusterBuilderTopo::process_event: " << towerinfosEM->size() << " TOWERINFO_CALIB_CEMC towers" << std::endl;
@@ -515,15 +526,16 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       {
         continue;
       }
-      unsigned int towerinfo_key = towerinfosEM->encode_key(iEM);
-      int ti_ieta = towerinfosEM->getTowerEtaBin(towerinfo_key);
-      int ti_iphi = towerinfosEM->getTowerPhiBin(towerinfo_key);
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, ti_ieta, ti_iphi);
-
-      RawTowerGeom *tower_geom = _geom_containers[2]->get_tower_geometry(key);
+      unsigned int itower = _geom_tables[2]->index_of_channel(iEM);
+      if (!_geom_tables[2]->has_tower(itower))
+      {
+        // no geometry for this channel
+        continue;
+      }
+      const RawTowerDefs::keytype key = _geom_tables[2]->get_key(itower);
 
-      int ieta = _geom_containers[2]->get_etabin(tower_geom->get_eta());
-      int iphi = _geom_containers[2]->get_phibin(tower_geom->get_phi());
+      int ieta = _geom_tables[2]->get_etabin(itower);
+      int iphi = _geom_tables[2]->get_phibin(itower);
       float this_E = towerInfo->get_energy();
 
       // if not using abs E, short circuit all negative towers right here (same for IHCal, OHCal below)
@@ -561,15 +573,16 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       {
         continue;
       }
-      unsigned int towerinfo_key = towerinfosIH->encode_key(iIH);
-      int ti_ieta = towerinfosIH->getTowerEtaBin(towerinfo_key);
-      int ti_iphi = towerinfosIH->getTowerPhiBin(towerinfo_key);
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALIN, ti_ieta, ti_iphi);
-
-      RawTowerGeom *tower_geom = _geom_containers[0]->get_tower_geometry(key);
+      unsigned int itower = _geom_tables[0]->index_of_channel(iIH);
+      if (!_geom_tables[0]->has_tower(itower))
+      {
+        // no geometry for this channel
+        continue;
+      }
+      const RawTowerDefs::keytype key = _geom_tables[0]->get_key(itower);
 
-      int ieta = _geom_containers[0]->get_etabin(tower_geom->get_eta());
-      int iphi = _geom_containers[0]->get_phibin(tower_geom->get_phi());
+      int ieta = _geom_tables[0]->get_etabin(itower);
+      int iphi = _geom_tables[0]->get_phibin(itower);
       float this_E = towerInfo->get_energy();
 
       if (!_use_absE && this_E < 1.E-10)
@@ -600,15 +613,16 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       {
         continue;
       }
-      unsigned int towerinfo_key = towerinfosOH->encode_key(iOH);
-      int ti_ieta = towerinfosOH->getTowerEtaBin(towerinfo_key);
-      int ti_iphi = towerinfosOH->getTowerPhiBin(towerinfo_key);
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALOUT, ti_ieta, ti_iphi);
-
-      RawTowerGeom *tower_geom = _geom_containers[1]->get_tower_geometry(key);
+      unsigned int itower = _geom_tables[1]->index_of_channel(iOH);
+      if (!_geom_tables[1]->has_tower(itower))
+      {
+        // no geometry for this channel
+        continue;
+      }
+      const RawTowerDefs::keytype key = _geom_tables[1]->get_key(itower);
 
-      int ieta = _geom_containers[1]->get_etabin(tower_geom->get_eta());
-      int iphi = _geom_containers[1]->get_phibin(tower_geom->get_phi());
+      int ieta = _geom_tables[1]->get_etabin(itower);
+      int iphi = _geom_tables[1]->get_phibin(itower);
       float this_E = towerInfo->get_energy();
 
       if (!_use_absE && this_E < 1.E-10)
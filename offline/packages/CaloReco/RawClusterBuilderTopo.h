@@ -17,6 +17,7 @@
 class PHCompositeNode;
 class RawClusterContainer;
 class RawTowerGeomContainer;
+class RawTowerGeomTable;
 
 class RawClusterBuilderTopo : public SubsysReco
 {
@@ -219,6 +220,7 @@ class RawClusterBuilderTopo : public SubsysReco
   RawClusterContainer *_clusters = nullptr;
 
   RawTowerGeomContainer *_geom_containers[3]{};
+  RawTowerGeomTable *_geom_tables[3]{};
 
   float _noise_LAYER[3]{};
 
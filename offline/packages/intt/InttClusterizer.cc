@@ -11,6 +11,7 @@
 #include <trackbase/TrkrHitSetContainer.h>
 
 #include <trackbase/ClusHitsVerbosev1.h>
+#include <trackbase/ClusterizerTools.h>
 #include <trackbase/RawHit.h>
 #include <trackbase/RawHitSet.h>
 #include <trackbase/RawHitSetContainer.h>
@@ -32,10 +33,13 @@
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/connected_components.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <limits>
+#include <map>
 #include <memory>  // for unique_ptr, make_...
 #include <set>
 #include <vector>  // for vector
@@ -49,6 +53,284 @@ namespace
   {
     return x * x;
   }
+
+  /*
+    strip coordinates and payload, as used by the sorted clustering.
+    major and minor are the sorting coordinates. Without z-clustering, only strips
+    with the same major coordinate and consecutive minor coordinates are adjacent
+  */
+  struct strip_hit
+  {
+    uint16_t major = 0;
+    uint16_t minor = 0;
+    uint16_t col = 0;
+    uint16_t row = 0;
+    TrkrDefs::hitkey hitkey = 0;
+    unsigned int adc = 0;
+  };
+
+  using vec_dVerbose = std::vector<std::vector<std::pair<int, int>>>;
+
+  /// input, output and scratch buffers for all the sensors of a given ladder
+  struct thread_data
+  {
+    CylinderGeomIntt* geom = nullptr;
+    int layer = 0;
+    int ladder_phi_index = 0;
+    std::vector<TrkrHitSet*> hitsets;
+    std::vector<RawHitSet*> rawhitsets;
+    bool make_z_clustering = false;
+    bool make_e_weights = false;
+    bool fillClusHitsVerbose = false;
+    bool do_validation = false;
+    int verbosity = 0;
+
+    // output, copied to the node tree once the thread is joined
+    std::vector<std::pair<TrkrDefs::cluskey, TrkrCluster*>> cluster_vector;
+    std::vector<std::pair<TrkrDefs::cluskey, TrkrDefs::hitkey>> association_vector;
+    std::vector<std::pair<TrkrDefs::cluskey, short int>> crossing_vector;
+    std::vector<TrkrDefs::cluskey> cluskey_ClusHitsVerbose;  // only fill if fillClusHitsVerbose
+    vec_dVerbose phivec_ClusHitsVerbose;                     // only fill if fillClusHitsVerbose
+    vec_dVerbose zvec_ClusHitsVerbose;                       // only fill if fillClusHitsVerbose
+    std::vector<std::vector<int>> validation_components;     // only fill if do_validation
+
+    // scratch buffers, reused for all the sensors handled by this thread
+    std::vector<strip_hit> hits;
+    ClusterizerTools::ComponentBuffers components;
+    std::vector<std::pair<int, int>> phibins;
+    std::vector<std::pair<int, int>> zbins;
+  };
+
+  /// build clusters from the hits of a sensor, and store them in thread output
+  void make_clusters(thread_data& my_data, TrkrDefs::hitsetkey hitsetkey, bool is_raw)
+  {
+    const auto& hits = my_data.hits;
+    const unsigned int ncomponents = ClusterizerTools::find_components(
+        hits.size(), [&hits](unsigned int i)
+        { return (uint32_t(hits[i].major) << 16U) | hits[i].minor; },
+        my_data.make_z_clustering, my_data.components);
+    if (my_data.do_validation)
+    {
+      my_data.validation_components.push_back(my_data.components.component);
+    }
+
+    const int layer = my_data.layer;
+    const int ladder_z_index = InttDefs::getLadderZId(hitsetkey);
+    auto geom = my_data.geom;
+    const float pitch = geom->get_strip_y_spacing();
+    const float length = geom->get_strip_z_spacing();
+
+    // get the bunch crossing number from the hitsetkey
+    const short int crossing = InttDefs::getTimeBucketId(hitsetkey);
+
+    for (unsigned int clusid = 0; clusid < ncomponents; ++clusid)
+    {
+      const TrkrDefs::cluskey ckey = TrkrDefs::genClusKey(hitsetkey, clusid);
+
+      if (my_data.verbosity > 2)
+      {
+        std::cout << "Filling cluster with key " << ckey << std::endl;
+      }
+
+      // determine the size of the cluster in phi and z, useful for track fitting the cluster
+      auto& phibins = my_data.phibins;
+      auto& zbins = my_data.zbins;
+      phibins.clear();
+      zbins.clear();
+
+      // determine the cluster position...
+      double xlocalsum = 0.0;
+      double ylocalsum = 0.0;
+      double zlocalsum = 0.0;
+      unsigned int clus_adc = 0;
+      unsigned int clus_maxadc = 0;
+      unsigned nhits = 0;
+
+      for (unsigned int index = my_data.components.offsets[clusid]; index < my_data.components.offsets[clusid + 1]; ++index)
+      {
+        const auto& hit = my_data.hits[my_data.components.members[index]];
+        zbins.emplace_back(hit.col, hit.adc);
+        phibins.emplace_back(hit.row, hit.adc);
+
+        // Add clusterkey/bunch crossing to mmap
+        my_data.crossing_vector.emplace_back(ckey, crossing);
+
+        // now get the positions from the geometry
+        double local_hit_location[3] = {0., 0., 0.};
+        geom->find_strip_center_localcoords(ladder_z_index,
+                                            hit.row, hit.col,
+                                            local_hit_location);
+
+        if (my_data.make_e_weights)
+        {
+          xlocalsum += local_hit_location[0] * (double) hit.adc;
+          ylocalsum += local_hit_location[1] * (double) hit.adc;
+          zlocalsum += local_hit_location[2] * (double) hit.adc;
+        }
+        else
+        {
+          xlocalsum += local_hit_location[0];
+          ylocalsum += local_hit_location[1];
+          zlocalsum += local_hit_location[2];
+        }
+        if (hit.adc > clus_maxadc)
+        {
+          clus_maxadc = hit.adc;
+        }
+        clus_adc += hit.adc;
+        ++nhits;
+
+        // add this cluster-hit association to the association map of (clusterkey,hitkey)
+        if (!is_raw)
+        {
+          my_data.association_vector.emplace_back(ckey, hit.hitkey);
+        }
+
+        if (my_data.verbosity > 2)
+        {
+          std::cout << "  From  geometry object: hit x " << local_hit_location[0] << " hit y " << local_hit_location[1] << " hit z " << local_hit_location[2] << std::endl;
+          std::cout << "     nhits " << nhits << " clusx  = " << xlocalsum / nhits << " clusy " << ylocalsum / nhits << " clusz " << zlocalsum / nhits << " hit_adc " << hit.adc << std::endl;
+        }
+      }
+
+      ClusterizerTools::merge_bins(phibins);
+      ClusterizerTools::merge_bins(zbins);
+
+      if (my_data.fillClusHitsVerbose)
+      {
+        if (my_data.verbosity > 10)
+        {
+          for (auto const& hit : phibins)
+          {
+            std::cout << " m_phi(" << hit.first << " : " << hit.second << ") " << std::endl;
+          }
+        }
+        my_data.cluskey_ClusHitsVerbose.push_back(ckey);
+        my_data.phivec_ClusHitsVerbose.push_back(phibins);
+        my_data.zvec_ClusHitsVerbose.push_back(zbins);
+      }
+
+      static const float invsqrt12 = 1. / sqrt(12);
+
+      // scale factors (phi direction)
+      /*
+        they corresponds to clusters of size 1 and 2 in phi
+        other clusters, which are very few and pathological, get a scale factor of 1
+        These scale factors are applied to produce cluster pulls with width unity
+      */
+
+      float phierror = pitch * invsqrt12;
+
+      static constexpr std::array<double, 3> scalefactors_phi = {{0.85, 0.4, 0.33}};
+      if (phibins.size() == 1 && layer < 5)
+      {
+        phierror *= scalefactors_phi[0];
+      }
+      else if (phibins.size() == 2 && layer < 5)
+      {
+        phierror *= scalefactors_phi[1];
+      }
+      else if (phibins.size() == 2 && layer > 4)
+      {
+        phierror *= scalefactors_phi[2];
+      }
+      // z error.
+      const float zerror = zbins.size() * length * invsqrt12;
+
+      double cluslocaly = std::numeric_limits<double>::quiet_NaN();
+      double cluslocalz = std::numeric_limits<double>::quiet_NaN();
+
+      if (my_data.make_e_weights)
+      {
+        cluslocaly = ylocalsum / (double) clus_adc;
+        cluslocalz = zlocalsum / (double) clus_adc;
+      }
+      else
+      {
+        cluslocaly = ylocalsum / nhits;
+        cluslocalz = zlocalsum / nhits;
+      }
+
+      auto clus = new TrkrClusterv5;
+      clus->setAdc(clus_adc);
+      if (!is_raw)
+      {
+        clus->setMaxAdc(clus_maxadc);
+      }
+      clus->setLocalX(cluslocaly);
+      clus->setLocalY(cluslocalz);
+      clus->setPhiError(phierror);
+      clus->setZError(zerror);
+      clus->setPhiSize(phibins.size());
+      clus->setZSize(zbins.size());
+      // All silicon surfaces have a 1-1 map to hitsetkey.
+      // So set subsurface key to 0
+      clus->setSubSurfKey(0);
+
+      if (my_data.verbosity > 2)
+      {
+        clus->identify();
+      }
+
+      my_data.cluster_vector.emplace_back(ckey, clus);
+    }
+  }
+
+  /// cluster all sensors (hitsets) of a given ladder
+  void ProcessLadderData(thread_data* my_data)
+  {
+    for (const auto& hitset : my_data->hitsets)
+    {
+      // strips are adjacent along the row (phi) direction
+      my_data->hits.clear();
+      TrkrHitSet::ConstRange hitrangei = hitset->getHits();
+      for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
+           hitr != hitrangei.second;
+           ++hitr)
+      {
+        strip_hit& hit = my_data->hits.emplace_back();
+        hit.col = InttDefs::getCol(hitr->first);
+        hit.row = InttDefs::getRow(hitr->first);
+        hit.major = hit.col;
+        hit.minor = hit.row;
+        hit.hitkey = hitr->first;
+        hit.adc = hitr->second->getAdc();
+      }
+
+      if (my_data->verbosity > 2)
+      {
+        std::cout << "hitvec.size(): " << my_data->hits.size() << std::endl;
+      }
+
+      make_clusters(*my_data, hitset->getHitSetKey(), false);
+    }
+
+    for (const auto& hitset : my_data->rawhitsets)
+    {
+      // raw hits are adjacent along the phibin (col) direction
+      my_data->hits.clear();
+      RawHitSet::ConstRange hitrangei = hitset->getHits();
+      for (RawHitSet::ConstIterator hitr = hitrangei.first;
+           hitr != hitrangei.second;
+           ++hitr)
+      {
+        strip_hit& hit = my_data->hits.emplace_back();
+        hit.col = (*hitr)->getPhiBin();
+        hit.row = (*hitr)->getTBin();
+        hit.major = hit.row;
+        hit.minor = hit.col;
+        hit.adc = (*hitr)->getAdc();
+      }
+
+      if (my_data->verbosity > 2)
+      {
+        std::cout << "hitvec.size(): " << my_data->hits.size() << std::endl;
+      }
+
+      make_clusters(*my_data, hitset->getHitSetKey(), true);
+    }
+  }
+
 }  // namespace
 
 bool InttClusterizer::ladder_are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit*>& lhs, const std::pair<TrkrDefs::hitkey, TrkrHit*>& rhs, const int layer)
@@ -97,6 +379,68 @@ bool InttClusterizer::ladder_are_adjacent(RawHit* lhs, RawHit* rhs, const int la
   return false;
 }
 
+std::vector<int> InttClusterizer::graph_components(const std::vector<std::pair<TrkrDefs::hitkey, TrkrHit*>>& hitvec, const int layer)
+{
+  using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
+  Graph G;
+
+  // Find adjacent strips
+  for (unsigned int i = 0; i < hitvec.size(); i++)
+  {
+    for (unsigned int j = i + 1; j < hitvec.size(); j++)
+    {
+      if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
+      {
+        add_edge(i, j, G);
+      }
+    }
+
+    add_edge(i, i, G);
+  }
+
+  // Find the connections between the vertices of the graph (vertices are the rawhits,
+  // connections are made when they are adjacent to one another)
+  std::vector<int> component(num_vertices(G));
+
+  // this is the actual clustering, performed by boost
+  if (!component.empty())
+  {
+    connected_components(G, &component[0]);
+  }
+  return component;
+}
+
+std::vector<int> InttClusterizer::graph_components(const std::vector<RawHit*>& hitvec, const int layer)
+{
+  using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
+  Graph G;
+
+  // Find adjacent strips
+  for (unsigned int i = 0; i < hitvec.size(); i++)
+  {
+    for (unsigned int j = i + 1; j < hitvec.size(); j++)
+    {
+      if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
+      {
+        add_edge(i, j, G);
+      }
+    }
+
+    add_edge(i, i, G);
+  }
+
+  // Find the connections between the vertices of the graph (vertices are the rawhits,
+  // connections are made when they are adjacent to one another)
+  std::vector<int> component(num_vertices(G));
+
+  // this is the actual clustering, performed by boost
+  if (!component.empty())
+  {
+    connected_components(G, &component[0]);
+  }
+  return component;
+}
+
 InttClusterizer::InttClusterizer(const std::string& name,
                                  unsigned int /*min_layer*/,
                                  unsigned int /*max_layer*/)
@@ -231,6 +575,18 @@ int InttClusterizer::InitRun(PHCompositeNode* topNode)
     }
   }
 
+  // lets Fun4AllServer run this module concurrently with modules using other nodes
+  DeclareInputNode(do_read_raw ? "TRKR_RAWHITSET" : "TRKR_HITSET");
+  DeclareInputNode("G4CELL_INTT");
+  DeclareInputNode("CYLINDERGEOM_INTT");
+  DeclareOutputNode("TRKR_CLUSTER");
+  DeclareOutputNode("TRKR_CLUSTERHITASSOC");
+  DeclareOutputNode("TRKR_CLUSTERCROSSINGASSOC");
+  if (record_ClusHitsVerbose)
+  {
+    DeclareOutputNode("Trkr_SvtxClusHitsVerbose");
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -281,7 +637,11 @@ int InttClusterizer::process_event(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
-  if (!do_read_raw)
+  if (do_sorted_clustering)
+  {
+    ClusterLadderCellsSorted(topNode);
+  }
+  else if (!do_read_raw)
   {
     ClusterLadderCells(topNode);
   }
@@ -294,6 +654,16 @@ int InttClusterizer::process_event(PHCompositeNode* topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+int InttClusterizer::End(PHCompositeNode* /*topNode*/)
+{
+  if (do_sorted_clustering && do_validation)
+  {
+    std::cout << "InttClusterizer::End - validated hitsets: " << m_validated_hitsets
+              << " mismatched with graph-based clustering: " << m_mismatched_hitsets << std::endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 void InttClusterizer::CalculateLadderThresholds(PHCompositeNode* topNode)
 {
   /*
@@ -399,29 +769,8 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
       std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
     }
 
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
-    {
-      for (unsigned int j = i + 1; j < hitvec.size(); j++)
-      {
-        if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-        {
-          add_edge(i, j, G);
-        }
-      }
-
-      add_edge(i, i, G);
-    }
-
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
+    // find the connections between hits, performed by boost
+    std::vector<int> component = graph_components(hitvec, layer);
 
     // Loop over the components(hit cells) compiling a list of the
     // unique connected groups (ie. clusters).
@@ -669,29 +1018,8 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
       std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
     }
 
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
-    {
-      for (unsigned int j = i + 1; j < hitvec.size(); j++)
-      {
-        if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-        {
-          add_edge(i, j, G);
-        }
-      }
-
-      add_edge(i, i, G);
-    }
-
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
+    // find the connections between hits, performed by boost
+    std::vector<int> component = graph_components(hitvec, layer);
 
     // Loop over the components(hit cells) compiling a list of the
     // unique connected groups (ie. clusters).
@@ -903,6 +1231,201 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
   return;
 }
 
+void InttClusterizer::ClusterLadderCellsSorted(PHCompositeNode* topNode)
+{
+  if (Verbosity() > 0)
+  {
+    std::cout << "Entering InttClusterizer::ClusterLadderCellsSorted " << std::endl;
+  }
+
+  //----------
+  // Get Nodes
+  //----------
+
+  // get the geometry node
+  PHG4CylinderGeomContainer* geom_container = findNode::getClass<PHG4CylinderGeomContainer>(topNode, "CYLINDERGEOM_INTT");
+  if (!geom_container)
+  {
+    return;
+  }
+
+  //-----------
+  // Clustering
+  //-----------
+
+  // group InttHitSet objects (sensors) per ladder
+  std::vector<thread_data> ladders;
+  std::map<std::pair<int, int>, unsigned int> ladder_index;
+  auto get_ladder = [&](TrkrDefs::hitsetkey hitsetkey) -> thread_data&
+  {
+    const int layer = TrkrDefs::getLayer(hitsetkey);
+    const int ladder_phi_index = InttDefs::getLadderPhiId(hitsetkey);
+    const auto iter = ladder_index.try_emplace(std::make_pair(layer, ladder_phi_index), ladders.size());
+    if (iter.second)
+    {
+      auto& data = ladders.emplace_back();
+      data.geom = dynamic_cast<CylinderGeomIntt*>(geom_container->GetLayerGeom(layer));
+      data.layer = layer;
+      data.ladder_phi_index = ladder_phi_index;
+      data.make_z_clustering = get_z_clustering(layer);
+      data.make_e_weights = get_energy_weighting(layer);
+      data.fillClusHitsVerbose = do_read_raw && (mClusHitsVerbose != nullptr);
+      data.do_validation = do_validation;
+      data.verbosity = Verbosity();
+    }
+    return ladders[iter.first->second];
+  };
+
+  if (!do_read_raw)
+  {
+    TrkrHitSetContainer::ConstRange hitsetrange =
+        m_hits->getHitSets(TrkrDefs::TrkrId::inttId);
+    for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
+         hitsetitr != hitsetrange.second;
+         ++hitsetitr)
+    {
+      if (Verbosity() > 1)
+      {
+        std::cout << "InttClusterizer found hitsetkey " << hitsetitr->first << std::endl;
+      }
+      if (Verbosity() > 2)
+      {
+        hitsetitr->second->identify();
+      }
+      get_ladder(hitsetitr->first).hitsets.push_back(hitsetitr->second);
+    }
+  }
+  else
+  {
+    RawHitSetContainer::ConstRange hitsetrange =
+        m_rawhits->getHitSets(TrkrDefs::TrkrId::inttId);
+    for (RawHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
+         hitsetitr != hitsetrange.second;
+         ++hitsetitr)
+    {
+      if (Verbosity() > 1)
+      {
+        std::cout << "InttClusterizer found hitsetkey " << hitsetitr->first << std::endl;
+      }
+      if (Verbosity() > 2)
+      {
+        hitsetitr->second->identify();
+      }
+      get_ladder(hitsetitr->first).rawhitsets.push_back(hitsetitr->second);
+    }
+  }
+
+  // do the clustering
+  ClusterizerTools::process_modules(ladders, ProcessLadderData, do_sequential);
+
+  // copy clusters and associations to the node tree
+  for (const auto& data : ladders)
+  {
+    for (const auto& [ckey, cluster] : data.cluster_vector)
+    {
+      m_clusterlist->addClusterSpecifyKey(ckey, cluster);
+    }
+
+    for (const auto& [ckey, hkey] : data.association_vector)
+    {
+      m_clusterhitassoc->addAssoc(ckey, hkey);
+    }
+
+    for (const auto& [ckey, crossing] : data.crossing_vector)
+    {
+      m_clustercrossingassoc->addAssoc(ckey, crossing);
+    }
+
+    if (data.fillClusHitsVerbose)
+    {
+      for (unsigned int index = 0; index < data.cluskey_ClusHitsVerbose.size(); ++index)
+      {
+        for (const auto& hit : data.phivec_ClusHitsVerbose[index])
+        {
+          mClusHitsVerbose->addPhiHit(hit.first, hit.second);
+        }
+        for (const auto& hit : data.zvec_ClusHitsVerbose[index])
+        {
+          mClusHitsVerbose->addZHit(hit.first, hit.second);
+        }
+        mClusHitsVerbose->push_hits(data.cluskey_ClusHitsVerbose[index]);
+      }
+    }
+  }
+
+  // compare hit to cluster assignment to graph-based clustering
+  if (do_validation)
+  {
+    for (const auto& data : ladders)
+    {
+      for (unsigned int index = 0; index < data.hitsets.size(); ++index)
+      {
+        TrkrHitSet* hitset = data.hitsets[index];
+        std::vector<std::pair<TrkrDefs::hitkey, TrkrHit*>> hitvec;
+        TrkrHitSet::ConstRange hitrangei = hitset->getHits();
+        for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
+             hitr != hitrangei.second;
+             ++hitr)
+        {
+          hitvec.emplace_back(hitr->first, hitr->second);
+        }
+
+        ValidateComponents(hitset->getHitSetKey(), graph_components(hitvec, data.layer), data.validation_components[index]);
+      }
+
+      for (unsigned int index = 0; index < data.rawhitsets.size(); ++index)
+      {
+        RawHitSet* hitset = data.rawhitsets[index];
+        std::vector<RawHit*> hitvec;
+        RawHitSet::ConstRange hitrangei = hitset->getHits();
+        for (RawHitSet::ConstIterator hitr = hitrangei.first;
+             hitr != hitrangei.second;
+             ++hitr)
+        {
+          hitvec.push_back((*hitr));
+        }
+
+        ValidateComponents(hitset->getHitSetKey(), graph_components(hitvec, data.layer), data.validation_components[index]);
+      }
+    }
+  }
+
+  if (Verbosity() > 2)
+  {
+    // check that the associations were written correctly
+    std::cout << "After InttClusterizer, cluster-hit associations are:" << std::endl;
+    m_clusterhitassoc->identify();
+  }
+
+  if (Verbosity() > 0)
+  {
+    std::cout << " Cluster-crossing associations are:" << std::endl;
+    m_clustercrossingassoc->identify();
+  }
+
+  return;
+}
+
+void InttClusterizer::ValidateComponents(TrkrDefs::hitsetkey hitsetkey, const std::vector<int>& graph, const std::vector<int>& sorted)
+{
+  ++m_validated_hitsets;
+  if (graph == sorted)
+  {
+    return;
+  }
+
+  ++m_mismatched_hitsets;
+  if (Verbosity() > 0)
+  {
+    std::cout << "InttClusterizer::ValidateComponents - hitsetkey " << hitsetkey
+              << " graph-based and sorted clustering differ. hits: " << graph.size() << " / " << sorted.size() << std::endl;
+    for (unsigned int i = 0; i < std::min(graph.size(), sorted.size()); ++i)
+    {
+      std::cout << "  hit " << i << " graph cluster " << graph[i] << " sorted cluster " << sorted[i] << std::endl;
+    }
+  }
+}
+
 void InttClusterizer::PrintClusters(PHCompositeNode* topNode)
 {
   if (Verbosity() > 1)
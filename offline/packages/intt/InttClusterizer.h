@@ -5,10 +5,12 @@
 
 #include <trackbase/TrkrDefs.h>
 
+#include <cstdint>
 #include <limits>
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 class ClusHitsVerbosev1;
 class PHCompositeNode;
@@ -33,6 +35,9 @@ class InttClusterizer : public SubsysReco
   //! event processing
   int process_event(PHCompositeNode *topNode) override;
 
+  //! end of processing
+  int End(PHCompositeNode *topNode) override;
+
   //! set an energy requirement relative to the thickness MIP expectation
   void set_threshold(const float fraction_of_mip)
   {
@@ -72,6 +77,16 @@ class InttClusterizer : public SubsysReco
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
   void set_read_raw(bool read_raw) { do_read_raw = read_raw; }
 
+  //! use sorted strip clustering, one thread per ladder, instead of graph-based clustering (default off).
+  //! For raw hits the graph-based adjacency compares unsigned bins and depends on hit order, the sorted clustering does not
+  void set_do_sorted_clustering(bool value) { do_sorted_clustering = value; }
+
+  //! with sorted clustering, also run graph-based clustering and compare hit to cluster assignments
+  void set_do_validation(bool value) { do_validation = value; }
+
+  //! with sorted clustering, process ladders sequentially instead of one thread per ladder
+  void set_do_sequential(bool value) { do_sequential = value; }
+
   // for saving verbose clusters
   void set_ClusHitsVerbose(bool set = true) { record_ClusHitsVerbose = set; };
   ClusHitsVerbosev1 *mClusHitsVerbose{nullptr};
@@ -81,9 +96,17 @@ class InttClusterizer : public SubsysReco
   bool ladder_are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit *> &lhs, const std::pair<TrkrDefs::hitkey, TrkrHit *> &rhs, const int layer);
   bool ladder_are_adjacent(RawHit *lhs, RawHit *rhs, const int layer);
 
+  //! graph-based hit to cluster assignment
+  std::vector<int> graph_components(const std::vector<std::pair<TrkrDefs::hitkey, TrkrHit *>> &hitvec, const int layer);
+  std::vector<int> graph_components(const std::vector<RawHit *> &hitvec, const int layer);
+
+  //! compare graph-based and sorted hit to cluster assignments
+  void ValidateComponents(TrkrDefs::hitsetkey hitsetkey, const std::vector<int> &graph, const std::vector<int> &sorted);
+
   void CalculateLadderThresholds(PHCompositeNode *topNode);
   void ClusterLadderCells(PHCompositeNode *topNode);
   void ClusterLadderCellsRaw(PHCompositeNode *topNode);
+  void ClusterLadderCellsSorted(PHCompositeNode *topNode);
   void PrintClusters(PHCompositeNode *topNode);
 
   // node tree storage pointers
@@ -100,6 +123,13 @@ class InttClusterizer : public SubsysReco
   std::map<int, bool> _make_e_weights;        // layer->energy_weighting_option
   bool do_hit_assoc = true;
   bool do_read_raw = false;
+  bool do_sorted_clustering = false;
+  bool do_validation = false;
+  bool do_sequential = false;
+
+  // validation counters
+  uint64_t m_validated_hitsets = 0;
+  uint64_t m_mismatched_hitsets = 0;
 };
 
 #endif
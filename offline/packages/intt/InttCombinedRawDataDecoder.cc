@@ -25,11 +25,34 @@
 
 #include <TSystem.h>
 
+#include <algorithm>   // for stable_sort
 #include <cstdlib>     // for exit
 #include <filesystem>  // for filesystem::exist
 #include <iostream>    // for operator<<, endl, bas...
 #include <map>         // for _Rb_tree_iterator
 
+namespace
+{
+  // ranges of the raw channel indices, as in InttBCOMap and InttDacMap
+  constexpr int n_felix_server = 8;
+  constexpr int n_felix_channel = 14;
+  constexpr int n_chip = 26;
+  constexpr int n_channel = 128;
+
+  // index in the hot channel mask, -1 if out of range
+  int hot_channel_index(InttNameSpace::RawData_s const& raw)
+  {
+    if (raw.felix_server < 0 || raw.felix_server >= n_felix_server ||
+        raw.felix_channel < 0 || raw.felix_channel >= n_felix_channel ||
+        raw.chip < 0 || raw.chip >= n_chip ||
+        raw.channel < 0 || raw.channel >= n_channel)
+    {
+      return -1;
+    }
+    return ((raw.felix_server * n_felix_channel + raw.felix_channel) * n_chip + raw.chip) * n_channel + raw.channel;
+  }
+}  // namespace
+
 InttCombinedRawDataDecoder::InttCombinedRawDataDecoder(std::string const& name)
   : SubsysReco(name)
   , m_calibinfoDAC({"INTT_DACMAP", CDB})
@@ -227,8 +250,11 @@ int InttCombinedRawDataDecoder::process_event(PHCompositeNode* topNode)
 
   TrkrDefs::hitsetkey hit_set_key = 0;
   TrkrDefs::hitkey hit_key = 0;
-  TrkrHitSetContainer::Iterator hit_set_container_itr;
-  TrkrHit* hit = nullptr;
+
+  // accepted hits are first buffered, then grouped by hitset,
+  // so that each hitset is looked up only once
+  m_DecodedHits.clear();
+  m_DecodedHits.reserve(inttcont->get_nhits());
 
   InttNameSpace::RawData_s raw;
   InttNameSpace::Offline_s ofl;
@@ -249,7 +275,7 @@ int InttCombinedRawDataDecoder::process_event(PHCompositeNode* topNode)
 
     ////////////////////////
     // bad channel filter
-    if (m_HotChannelSet.find(raw) != m_HotChannelSet.end())
+    if (IsHotChannel(raw))
     {
       // std::cout<<"hotchan removed : "<<raw.felix_server<<" "<<raw.felix_channel<<" "<<raw.chip<<" "<<raw.channel<<std::endl;
       continue;
@@ -284,8 +310,6 @@ int InttCombinedRawDataDecoder::process_event(PHCompositeNode* topNode)
 	  }
       }
     hit_set_key = InttDefs::genHitSetKey(ofl.layer, ofl.ladder_z, ofl.ladder_phi, time_bucket);
-    hit_set_container_itr = trkr_hit_set_container->findOrAddHitSet(hit_set_key);
-    hit = hit_set_container_itr->second->getHit(hit_key);
 
     if(m_outputBcoDiff)
       {
@@ -308,24 +332,68 @@ int InttCombinedRawDataDecoder::process_event(PHCompositeNode* topNode)
 		  << std::endl;
       }
 
-    if (hit)
-    {
-      continue;
-    }
-
     ////////////////////////
     // dac conversion
     int dac = m_dacmap.GetDAC(raw, adc);
 
-    hit = new TrkrHitv2;
+    m_DecodedHits.push_back({hit_set_key, hit_key, dac});
+  }
+
+  // group hits by hitset. The sort is stable, so that for duplicated hits
+  // the first one in the raw hit container is kept, as before
+  std::stable_sort(m_DecodedHits.begin(), m_DecodedHits.end(),
+                   [](const DecodedHit& lhs, const DecodedHit& rhs)
+                   { return lhs.hitsetkey < rhs.hitsetkey; });
+
+  TrkrHitSetContainer::Iterator hit_set_container_itr;
+  for (auto iter = m_DecodedHits.begin(); iter != m_DecodedHits.end(); ++iter)
+  {
+    if (iter == m_DecodedHits.begin() || iter->hitsetkey != hit_set_container_itr->first)
+    {
+      hit_set_container_itr = trkr_hit_set_container->findOrAddHitSet(iter->hitsetkey);
+    }
+
+    TrkrHitSet* hitset = hit_set_container_itr->second;
+    if (hitset->getHit(iter->hitkey))
+    {
+      continue;
+    }
+
+    TrkrHit* hit = new TrkrHitv2;
     //--hit->setAdc(adc);
-    hit->setAdc(dac);
-    hit_set_container_itr->second->addHitSpecificKey(hit_key, hit);
+    hit->setAdc(iter->dac);
+    hitset->addHitSpecificKey(iter->hitkey, hit);
   }
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void InttCombinedRawDataDecoder::BuildHotChannelMask()
+{
+  m_HotChannelMask.assign(n_felix_server * n_felix_channel * n_chip * n_channel, false);
+  for (auto const& raw : m_HotChannelSet)
+  {
+    int index = hot_channel_index(raw);
+    if (index < 0)
+    {
+      std::cout << "InttCombinedRawDataDecoder::BuildHotChannelMask - invalid hot channel: "
+                << raw.felix_server << " " << raw.felix_channel << " " << raw.chip << " " << raw.channel << std::endl;
+      continue;
+    }
+    m_HotChannelMask[index] = true;
+  }
+}
+
+bool InttCombinedRawDataDecoder::IsHotChannel(InttNameSpace::RawData_s const& raw) const
+{
+  if (m_HotChannelMask.empty())
+  {
+    return false;
+  }
+  int index = hot_channel_index(raw);
+  return index >= 0 && m_HotChannelMask[index];
+}
+
 int InttCombinedRawDataDecoder::LoadHotChannelMapLocal(std::string const& filename)
 {
   if (filename.empty())
@@ -366,6 +434,7 @@ int InttCombinedRawDataDecoder::LoadHotChannelMapLocal(std::string const& filena
     //           << "\t" << cdbttree.GetIntValue(n, "chip")
     //           << "\t" << cdbttree.GetIntValue(n, "channel") << std::endl;
   }
+  BuildHotChannelMask();
 
   return 0;
 }
@@ -401,6 +470,7 @@ int InttCombinedRawDataDecoder::LoadHotChannelMapRemote(std::string const& name)
         .chip = cdbttree.GetIntValue(n, "chip"),
         .channel = cdbttree.GetIntValue(n, "channel")});
   }
+  BuildHotChannelMask();
 
   return 0;
 }
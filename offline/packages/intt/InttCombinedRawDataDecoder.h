@@ -5,12 +5,15 @@
 #include "InttDacMap.h"
 #include "InttMapping.h"
 
+#include <trackbase/TrkrDefs.h>
+
 #include <cdbobjects/CDBTTree.h>
 #include <ffamodules/CDBInterface.h>
 #include <fun4all/SubsysReco.h>
 
 #include <set>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 class InttEventInfo;
@@ -51,10 +54,26 @@ class InttCombinedRawDataDecoder : public SubsysReco
   void set_triggeredMode(bool flag) {m_triggeredMode = flag; }
 
  private:
+  //! fill the hot channel mask from the hot channel set
+  void BuildHotChannelMask();
+
+  //! true if the channel is in the hot channel map
+  bool IsHotChannel(InttNameSpace::RawData_s const&) const;
+
+  //! decoded hit, buffered so that the hits can be inserted hitset by hitset
+  struct DecodedHit
+  {
+    TrkrDefs::hitsetkey hitsetkey = 0;
+    TrkrDefs::hitkey hitkey = 0;
+    int dac = 0;
+  };
+
   InttEventInfo* intt_event_header = nullptr;
   std::string m_InttRawNodeName = "INTTRAWHIT";
   typedef std::set<InttNameSpace::RawData_s, InttNameSpace::RawDataComparator> Set_t;
   Set_t m_HotChannelSet;
+  std::vector<bool> m_HotChannelMask;  //[Felix server][Felix channel][chip][channel], copy of m_HotChannelSet
+  std::vector<DecodedHit> m_DecodedHits;  // reused between events
   bool m_runStandAlone = false;
   bool m_writeInttEventHeader = false;
 
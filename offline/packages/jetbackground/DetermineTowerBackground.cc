@@ -8,6 +8,7 @@
 #include <calobase/RawTowerDefs.h>
 #include <calobase/RawTowerGeom.h>
 #include <calobase/RawTowerGeomContainer.h>
+#include <calobase/RawTowerGeomTable.h>
 
 #include <calobase/TowerInfo.h>
 #include <calobase/TowerInfoContainer.h>
@@ -123,6 +124,9 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
 
   RawTowerGeomContainer *geomIH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
   RawTowerGeomContainer *geomOH = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
+  // dense copies of the geometry for the per tower lookups
+  RawTowerGeomTable *geomtableIH = RawTowerGeomTable::GetTable(topNode, "TOWERGEOM_HCALIN");
+  RawTowerGeomTable *geomtableOH = RawTowerGeomTable::GetTable(topNode, "TOWERGEOM_HCALOUT");
 
   // seed type 0 is D > 3 R=0.2 jets run on retowerized CEMC
   if (_seed_type == 0)
@@ -184,9 +188,13 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
             unsigned int towerkey = towerinfosIH3->encode_key(comp.second);
             comp_ieta = towerinfosIH3->getTowerEtaBin(towerkey);
             comp_iphi = towerinfosIH3->getTowerPhiBin(towerkey);
-            const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALIN, comp_ieta, comp_iphi);
-            tower_geom = geomIH->get_tower_geometry(key);
-            comp_ET = towerinfo->get_energy() / cosh(tower_geom->get_eta());
+            const unsigned int itower = geomtableIH->index(comp_ieta, comp_iphi);
+            if (!geomtableIH->has_tower(itower))
+            {
+              // no geometry for this tower
+              continue;
+            }
+            comp_ET = towerinfo->get_energy() / cosh(geomtableIH->get_eta(itower));
             comp_isBad = towerinfo->get_isHot() || towerinfo->get_isNoCalib() || towerinfo->get_isNotInstr() || towerinfo->get_isBadChi2();
           }
           else if (comp.first == 7 || comp.first == 27)
@@ -195,9 +203,13 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
             unsigned int towerkey = towerinfosOH3->encode_key(comp.second);
             comp_ieta = towerinfosOH3->getTowerEtaBin(towerkey);
             comp_iphi = towerinfosOH3->getTowerPhiBin(towerkey);
-            const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALOUT, comp_ieta, comp_iphi);
-            tower_geom = geomOH->get_tower_geometry(key);
-            comp_ET = towerinfo->get_energy() / cosh(tower_geom->get_eta());
+            const unsigned int itower = geomtableOH->index(comp_ieta, comp_iphi);
+            if (!geomtableOH->has_tower(itower))
+            {
+              // no geometry for this tower
+              continue;
+            }
+            comp_ET = towerinfo->get_energy() / cosh(geomtableOH->get_eta(itower));
             comp_isBad = towerinfo->get_isHot() || towerinfo->get_isNoCalib() || towerinfo->get_isNotInstr() || towerinfo->get_isBadChi2();
           }
           else if (comp.first == 13 || comp.first == 28)
@@ -206,9 +218,13 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
             unsigned int towerkey = towerinfosEM3->encode_key(comp.second);
             comp_ieta = towerinfosEM3->getTowerEtaBin(towerkey);
             comp_iphi = towerinfosEM3->getTowerPhiBin(towerkey);
-            const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALIN, comp_ieta, comp_iphi);
-            tower_geom = geomIH->get_tower_geometry(key);
-            comp_ET = towerinfo->get_energy() / cosh(tower_geom->get_eta());
+            const unsigned int itower = geomtableIH->index(comp_ieta, comp_iphi);
+            if (!geomtableIH->has_tower(itower))
+            {
+              // no geometry for this tower
+              continue;
+            }
+            comp_ET = towerinfo->get_energy() / cosh(geomtableIH->get_eta(itower));
             comp_isBad = towerinfo->get_isHot() || towerinfo->get_isNoCalib() || towerinfo->get_isNotInstr() || towerinfo->get_isBadChi2();
           }
         }
@@ -33,6 +33,7 @@
 #include <iostream>
 #include <map>      // for _Rb_tree_iterator
 #include <memory>   // for allocator_traits<>::value_type
+#include <sstream>
 #include <string>   // for operator<<
 #include <utility>  // for pair
 #include <vector>
@@ -116,7 +117,7 @@ fastjet::Selector FastJetAlgo::get_selector()
 }
 
 std::vector<fastjet::PseudoJet> FastJetAlgo::cluster_jets(
-    std::vector<fastjet::PseudoJet>& pseudojets)
+    const std::vector<fastjet::PseudoJet>& pseudojets)
 {
   auto jetdef = get_fastjet_definition();
   m_cluseq = new fastjet::ClusterSequence(pseudojets, jetdef);
@@ -133,7 +134,7 @@ std::vector<fastjet::PseudoJet> FastJetAlgo::cluster_jets(
 }
 
 std::vector<fastjet::PseudoJet> FastJetAlgo::cluster_area_jets(
-    std::vector<fastjet::PseudoJet>& pseudojets)
+    const std::vector<fastjet::PseudoJet>& pseudojets)
 {
   auto jetdef = get_fastjet_definition();
 
@@ -150,7 +151,7 @@ std::vector<fastjet::PseudoJet> FastJetAlgo::cluster_area_jets(
   return fastjet::sorted_by_pt(selector(m_cluseqarea->inclusive_jets()));
 }
 
-float FastJetAlgo::calc_rhomeddens(std::vector<fastjet::PseudoJet>& constituents)
+float FastJetAlgo::calc_rhomeddens(const std::vector<fastjet::PseudoJet>& constituents)
 {
   fastjet::AreaDefinition area_def(
       fastjet::active_area_explicit_ghosts,
@@ -256,6 +257,51 @@ void FastJetAlgo::first_call_init(JetContainer* jetcont)
   jetcont->set_jetpar_R(m_opt.jet_R);
 }
 
+void FastJetAlgo::select_pseudojets(const std::vector<fastjet::PseudoJet>& particles, std::vector<fastjet::PseudoJet>& pseudojets)
+{
+  // same selection as jets_to_pseudojets, the user index of the input is kept.
+  // pseudojets is owned by the caller and keeps its capacity from event to event
+  pseudojets.clear();
+  pseudojets.reserve(particles.size());
+  for (const auto& particle : particles)
+  {
+    if (particle.e() < m_opt.constituent_min_E)
+    {
+      continue;
+    }
+    if (!std::isfinite(particle.px()) ||
+        !std::isfinite(particle.py()) ||
+        !std::isfinite(particle.pz()) ||
+        !std::isfinite(particle.e()))
+    {
+      std::cout << PHWHERE << " invalid particle kinematics:"
+                << " px: " << particle.px()
+                << " py: " << particle.py()
+                << " pz: " << particle.pz()
+                << " e: " << particle.e() << std::endl;
+      gSystem->Exit(1);
+    }
+    if (m_opt.use_constituent_min_pt && particle.perp() < m_opt.constituent_min_pt)
+    {
+      continue;
+    }
+    pseudojets.push_back(particle);
+  }
+}
+
+void FastJetAlgo::insert_components(Jet* jet, const fastjet::PseudoJet& comp, std::vector<Jet*>* particles, const Jet::TYPE_comp_vec* comps)
+{
+  if (particles)
+  {
+    jet->insert_comp((*particles)[comp.user_index()]->get_comp_vec(), true);
+  }
+  else
+  {
+    const Jet::TYPE_comp& id = (*comps)[comp.user_index()];
+    jet->insert_comp(id.first, id.second, true);
+  }
+}
+
 void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* jetcont)
 {
   if (m_first_cluster_call)
@@ -275,54 +321,112 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
 
   // translate input jets to input fastjets
   auto pseudojets = jets_to_pseudojets(particles);
+  if (m_opt.cs_calc_constsub)
+  {
+    subtract_constituents(pseudojets);
+  }
+  fill_jet_container(pseudojets, jetcont, &particles, nullptr);
+}
 
-  // if using constituent subtraction, oberve maximum eta and subtract the constituents
+std::string FastJetAlgo::constituent_key()
+{
+  // everything which goes into select_pseudojets and subtract_constituents
+  std::ostringstream key;
+  key << "FastJetAlgo minE " << m_opt.constituent_min_E;
+  if (m_opt.use_constituent_min_pt)
+  {
+    key << " minpt " << m_opt.constituent_min_pt;
+  }
+  if (m_opt.cs_calc_constsub)
+  {
+    key << " cs " << m_opt.cs_max_eta << " " << m_opt.cs_max_pt << " " << m_opt.cs_max_dist
+        << " " << m_opt.cs_alpha << " " << m_opt.cs_ghost_area;
+  }
+  return key.str();
+}
+
+void FastJetAlgo::prepare_pseudojets(const std::vector<fastjet::PseudoJet>& particles, std::vector<fastjet::PseudoJet>& constituents, JetContainer* jetcont)
+{
+  if (m_first_cluster_call)
+  {
+    first_call_init(jetcont);
+  }
+  if (m_opt.verbosity > 8)
+  {
+    std::cout << "   Verbosity>8 #input particles: " << particles.size() << std::endl;
+  }
+  select_pseudojets(particles, constituents);
   if (m_opt.cs_calc_constsub)
   {
-    if (m_opt.verbosity > 100)
+    subtract_constituents(constituents);
+  }
+}
+
+void FastJetAlgo::cluster_and_fill_pseudojets(const std::vector<fastjet::PseudoJet>& constituents, const Jet::TYPE_comp_vec& comps, JetContainer* jetcont)
+{
+  // the constituents might have been prepared by another algo with the same constituent_key()
+  if (m_first_cluster_call)
+  {
+    first_call_init(jetcont);
+  }
+
+  if (m_opt.verbosity > 1)
+  {
+    std::cout << "   Verbosity>1 FastJetAlgo::process_event -- entered" << std::endl;
+  }
+  fill_jet_container(constituents, jetcont, nullptr, &comps);
+}
+
+void FastJetAlgo::subtract_constituents(std::vector<fastjet::PseudoJet>& pseudojets)
+{
+  // if using constituent subtraction, oberve maximum eta and subtract the constituents
+  if (m_opt.verbosity > 100)
+  {
+    std::cout << " Before Constituent Subtraction: " << std::endl;
+    int i = 0;
+    double sumpt = 0.;
+    for (const auto& c : pseudojets)
     {
-      std::cout << " Before Constituent Subtraction: " << std::endl;
-      int i = 0;
-      double sumpt = 0.;
-      for (const auto& c : pseudojets)
+      sumpt += c.perp();
+      if (i < 100)
       {
-        sumpt += c.perp();
-        if (i < 100)
-        {
-          std::cout << (boost::format(" jet[%2i] %8.4f  sum %8.4f") % i % c.perp() % sumpt).str() << std::endl;
-        }
-        i++;
+        std::cout << (boost::format(" jet[%2i] %8.4f  sum %8.4f") % i % c.perp() % sumpt).str() << std::endl;
       }
-      auto _c = pseudojets.back();
-      std::cout << (boost::format(" jet[%2i] %8.4f  sum %8.4f") % i++ % _c.perp() % sumpt).str() << std::endl
-                << std::endl;
+      i++;
     }
+    auto _c = pseudojets.back();
+    std::cout << (boost::format(" jet[%2i] %8.4f  sum %8.4f") % i++ % _c.perp() % sumpt).str() << std::endl
+              << std::endl;
+  }
 
-    pseudojets = fastjet::SelectorAbsEtaMax(m_opt.cs_max_eta)(pseudojets);
-    cs_bge_rho->set_particles(pseudojets);
-    auto subtracted_pseudojets = cs_subtractor->subtract_event(pseudojets);
-    pseudojets = std::move(subtracted_pseudojets);
+  pseudojets = fastjet::SelectorAbsEtaMax(m_opt.cs_max_eta)(pseudojets);
+  cs_bge_rho->set_particles(pseudojets);
+  auto subtracted_pseudojets = cs_subtractor->subtract_event(pseudojets);
+  pseudojets = std::move(subtracted_pseudojets);
 
-    if (m_opt.verbosity > 100)
+  if (m_opt.verbosity > 100)
+  {
+    std::cout << " After Constituent Subtraction: " << std::endl;
+    int i = 0;
+    double sumpt = 0.;
+    for (const auto& c : pseudojets)
     {
-      std::cout << " After Constituent Subtraction: " << std::endl;
-      int i = 0;
-      double sumpt = 0.;
-      for (const auto& c : pseudojets)
+      sumpt += c.perp();
+      if (i < 100)
       {
-        sumpt += c.perp();
-        if (i < 100)
-        {
-          std::cout << (boost::format(" jet[%2i] %8.4f  sum %8.4f") % i % c.perp() % sumpt).str() << std::endl;
-        }
-        i++;
+        std::cout << (boost::format(" jet[%2i] %8.4f  sum %8.4f") % i % c.perp() % sumpt).str() << std::endl;
       }
-      auto _c = pseudojets.back();
-      std::cout << (boost::format(" jet[%2i] %8.4f  sum %8.4f") % i++ % _c.perp() % sumpt).str() << std::endl
-                << std::endl;
+      i++;
     }
+    auto _c = pseudojets.back();
+    std::cout << (boost::format(" jet[%2i] %8.4f  sum %8.4f") % i++ % _c.perp() % sumpt).str() << std::endl
+              << std::endl;
   }
+}
 
+
+void FastJetAlgo::fill_jet_container(const std::vector<fastjet::PseudoJet>& pseudojets, JetContainer* jetcont, std::vector<Jet*>* particles, const Jet::TYPE_comp_vec* comps)
+{
   if (m_opt.calc_jetmedbkgdens)
   {
     jetcont->set_rho_median(calc_rhomeddens(pseudojets));
@@ -395,7 +499,7 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
         ++n_clustered;
         if (m_opt.save_jet_components)
         {
-          jet->insert_comp(particles[comp.user_index()]->get_comp_vec(), true);
+          insert_components(jet, comp, particles, comps);
         }
       }  // end loop over all constituents
     }
@@ -406,7 +510,7 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
       {
         for (auto& comp : constituents)
         {
-          jet->insert_comp(particles[comp.user_index()]->get_comp_vec(), true);
+          insert_components(jet, comp, particles, comps);
         }
       }
     }
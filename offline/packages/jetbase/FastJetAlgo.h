@@ -11,6 +11,7 @@
 #include <climits>   // for NAN
 #include <cmath>     // for NAN
 #include <iostream>  // for cout, ostream
+#include <string>
 #include <vector>    // for vector
 
 namespace fastjet
@@ -50,6 +51,11 @@ class FastJetAlgo : public JetAlgo
 
   std::vector<Jet*> get_jets(std::vector<Jet*> particles) override;
   void cluster_and_fill(std::vector<Jet*>& part_in, JetContainer* jets_out) override;
+  bool accepts_pseudojet_input() const override { return true; }
+  std::string constituent_key() override;
+  void prepare_pseudojets(const std::vector<fastjet::PseudoJet>& part_in, std::vector<fastjet::PseudoJet>& constituents, JetContainer* jets_out) override;
+  void cluster_and_fill_pseudojets(const std::vector<fastjet::PseudoJet>& constituents, const Jet::TYPE_comp_vec& comps, JetContainer* jets_out) override;
+  bool uses_random_ghosts() const override { return m_opt.calc_area || m_opt.calc_jetmedbkgdens; }
 
  private:
   FastJetOptions m_opt{};
@@ -63,9 +69,13 @@ class FastJetAlgo : public JetAlgo
 
   // Internal processes
   std::vector<fastjet::PseudoJet> jets_to_pseudojets(std::vector<Jet*>& particles);
-  std::vector<fastjet::PseudoJet> cluster_jets(std::vector<fastjet::PseudoJet>& constituents);
-  std::vector<fastjet::PseudoJet> cluster_area_jets(std::vector<fastjet::PseudoJet>& constituents);
-  float calc_rhomeddens(std::vector<fastjet::PseudoJet>& constituents);
+  void select_pseudojets(const std::vector<fastjet::PseudoJet>& particles, std::vector<fastjet::PseudoJet>& pseudojets);
+  void subtract_constituents(std::vector<fastjet::PseudoJet>& pseudojets);
+  void fill_jet_container(const std::vector<fastjet::PseudoJet>& pseudojets, JetContainer* jetcont, std::vector<Jet*>* particles, const Jet::TYPE_comp_vec* comps);
+  void insert_components(Jet* jet, const fastjet::PseudoJet& comp, std::vector<Jet*>* particles, const Jet::TYPE_comp_vec* comps);
+  std::vector<fastjet::PseudoJet> cluster_jets(const std::vector<fastjet::PseudoJet>& constituents);
+  std::vector<fastjet::PseudoJet> cluster_area_jets(const std::vector<fastjet::PseudoJet>& constituents);
+  float calc_rhomeddens(const std::vector<fastjet::PseudoJet>& constituents);
   fastjet::JetDefinition get_fastjet_definition();
   fastjet::Selector get_selector();
   void first_call_init(JetContainer* _ = nullptr);
@@ -4,8 +4,15 @@
 #include "Jet.h"
 
 #include <cmath>
+#include <string>
+#include <vector>
 
 class JetContainer;
+namespace fastjet
+{
+  class PseudoJet;
+}
+
 class JetAlgo
 {
  public:
@@ -30,6 +37,22 @@ class JetAlgo
   {
   }
 
+  // direct version -- the pseudojets made by the JetInputs are first prepared
+  // (constituent selection and subtraction) and then clustered. Their user_index is the
+  // position of the corresponding component in comps. Algos which return the same non empty
+  // constituent_key() prepare identical constituents, so this is done only once for them
+  virtual bool accepts_pseudojet_input() const { return false; }
+  virtual std::string constituent_key() { return std::string(); }
+  virtual void prepare_pseudojets(const std::vector<fastjet::PseudoJet>& /* particles*/, std::vector<fastjet::PseudoJet>& /* constituents*/, JetContainer* /*clones*/)
+  {
+  }
+  virtual void cluster_and_fill_pseudojets(const std::vector<fastjet::PseudoJet>& /* constituents*/, const Jet::TYPE_comp_vec& /* comps*/, JetContainer* /*clones*/)
+  {
+  }
+  // true if the clustering draws random numbers from the fastjet shared generator (ghosts
+  // for jet areas or rho). Such algos are clustered one after the other, in algo order
+  virtual bool uses_random_ghosts() const { return false; }
+
   virtual std::map<Jet::PROPERTY, unsigned int>& property_indices();
 
  protected:
@@ -7,6 +7,10 @@
 #include <vector>
 
 class PHCompositeNode;
+namespace fastjet
+{
+  class PseudoJet;
+}
 
 class JetInput
 {
@@ -24,6 +28,14 @@ class JetInput
   {
     return std::vector<Jet*>();
   }
+
+  // lightweight version -- append the input as pseudojets without creating Jet objects,
+  // the user_index of each pseudojet is the position of its component in comps
+  virtual bool has_pseudojet_input() const { return false; }
+  virtual void get_pseudojets(PHCompositeNode* /*topNode*/, std::vector<fastjet::PseudoJet>& /*pseudojets*/, Jet::TYPE_comp_vec& /*comps*/)
+  {
+  }
+
   virtual int Verbosity() const { return m_Verbosity; }
   virtual void Verbosity(int i) { m_Verbosity = i; }
 
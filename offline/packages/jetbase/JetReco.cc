@@ -22,15 +22,42 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
+#include <TROOT.h>
+
 #include <boost/format.hpp>
 
 // standard includes
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>  // for exit
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>  // for allocator_traits<>::value_type
+#include <thread>
 #include <vector>
 
+namespace
+{
+  // run function f(ithread, nthreads) on nthreads threads, including the calling one, and wait for completion
+  template <class F>
+  void run_parallel(unsigned int nthreads, F &&f)
+  {
+    nthreads = std::max(nthreads, 1U);
+    std::vector<std::thread> threads;
+    threads.reserve(nthreads - 1);
+    for (unsigned int ithread = 1; ithread < nthreads; ++ithread)
+    {
+      threads.emplace_back(f, ithread, nthreads);
+    }
+    f(0, nthreads);
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+  }
+}  // namespace
+
 JetReco::JetReco(const std::string &name, TRANSITION _which)
   : SubsysReco(name)
   , which_fill{_which}
@@ -79,6 +106,48 @@ int JetReco::InitRun(PHCompositeNode *topNode)
     std::cout << "===========================================================================" << std::endl;
   }
 
+  // without a JetMap to fill and if all inputs and algos support it, the inputs go
+  // straight into pseudojets. Algos which share the constituent preparation
+  // (selection, subtraction) get the same prepared constituents
+  m_use_pseudojets = pseudojet_input();
+  m_constituents.clear();
+  m_constituent_index.clear();
+  m_constituent_algo.clear();
+  if (m_use_pseudojets)
+  {
+    std::map<std::string, unsigned int> keys;
+    for (unsigned int ialgo = 0; ialgo < _algos.size(); ++ialgo)
+    {
+      std::string key = _algos[ialgo]->constituent_key();
+      auto iter = keys.find(key);
+      if (key.empty() || iter == keys.end())
+      {
+        if (!key.empty())
+        {
+          keys.insert(std::make_pair(key, m_constituent_algo.size()));
+        }
+        m_constituent_index.push_back(m_constituent_algo.size());
+        m_constituent_algo.push_back(ialgo);
+      }
+      else
+      {
+        m_constituent_index.push_back(iter->second);
+      }
+    }
+    m_constituents.resize(m_constituent_algo.size());
+    if (Verbosity() > 0)
+    {
+      std::cout << "JetReco::InitRun - " << _algos.size() << " algos cluster "
+                << m_constituents.size() << " sets of constituents on "
+                << m_nthreads << " threads" << std::endl;
+    }
+  }
+  if (m_nthreads > 1)
+  {
+    // the jets are created concurrently in the TClonesArrays of the JetContainers
+    ROOT::EnableThreadSafety();
+  }
+
   return CreateNodes(topNode);
 }
 
@@ -94,6 +163,24 @@ int JetReco::process_event(PHCompositeNode *topNode)
   // Get Objects off of the Node Tree
   //------------------------------------------------------------------
 
+  // without a JetMap to fill the inputs can go straight into pseudojets,
+  // which saves creating (and deleting) a Jet object for every input
+  if (m_use_pseudojets)
+  {
+    m_pseudojets.clear();
+    m_pseudojet_comps.clear();
+    for (auto &_input : _inputs)
+    {
+      _input->get_pseudojets(topNode, m_pseudojets, m_pseudojet_comps);
+    }
+    FillJetContainers(topNode);
+    if (Verbosity() > 1)
+    {
+      std::cout << "JetReco::process_event -- exited" << std::endl;
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
   std::vector<Jet *> inputs;  // owns memory
   for (auto &_input : _inputs)
   {
@@ -307,6 +394,101 @@ void JetReco::FillJetContainer(PHCompositeNode *topNode, int ipos, std::vector<J
   return;
 }
 
+void JetReco::FillJetContainers(PHCompositeNode *topNode)
+{
+  std::vector<JetContainer *> jetconns(_algos.size(), nullptr);
+  for (unsigned int ipos = 0; ipos < _algos.size(); ++ipos)
+  {
+    jetconns[ipos] = findNode::getClass<JetContainer>(topNode, JC_name(_outputs[ipos]));
+    if (!jetconns[ipos])
+    {
+      std::cout << PHWHERE << " ERROR: Can't find JetContainer: " << _outputs[ipos] << std::endl;
+      exit(-1);
+    }
+  }
+
+  // every algo only touches its own state and its own JetContainer, so the
+  // preparation of the constituents and the clustering run concurrently.
+  // Each step hands out the next index to whichever thread is free
+  std::atomic<unsigned int> next{0};
+  run_parallel(std::min<size_t>(m_nthreads, m_constituents.size()), [&](unsigned int /*ithread*/, unsigned int /*nthreads*/)
+               {
+    for (unsigned int index = next++; index < m_constituents.size(); index = next++)
+    {
+      unsigned int ipos = m_constituent_algo[index];
+      _algos[ipos]->prepare_pseudojets(m_pseudojets, m_constituents[index], jetconns[ipos]);
+    } });
+
+  if (Verbosity() > 5)
+  {
+    for (unsigned int ipos = 0; ipos < _algos.size(); ++ipos)
+    {
+      std::cout << " Verbosity>5:: filling JetContainter for " << JC_name(_outputs[ipos]) << std::endl;
+    }
+  }
+
+  // algos which draw random ghosts are left out of the concurrent loop and
+  // clustered afterwards in algo order, which keeps the sequence of random
+  // numbers they get from fastjet the same as in a sequential run
+  std::vector<unsigned int> concurrent_algos;
+  std::vector<unsigned int> sequential_algos;
+  for (unsigned int ipos = 0; ipos < _algos.size(); ++ipos)
+  {
+    (_algos[ipos]->uses_random_ghosts() ? sequential_algos : concurrent_algos).push_back(ipos);
+  }
+
+  next = 0;
+  run_parallel(std::min<size_t>(m_nthreads, concurrent_algos.size()), [&](unsigned int /*ithread*/, unsigned int /*nthreads*/)
+               {
+    for (unsigned int index = next++; index < concurrent_algos.size(); index = next++)
+    {
+      unsigned int ipos = concurrent_algos[index];
+      _algos[ipos]->cluster_and_fill_pseudojets(m_constituents[m_constituent_index[ipos]], m_pseudojet_comps, jetconns[ipos]);
+    } });
+
+  for (unsigned int ipos : sequential_algos)
+  {
+    _algos[ipos]->cluster_and_fill_pseudojets(m_constituents[m_constituent_index[ipos]], m_pseudojet_comps, jetconns[ipos]);
+  }
+
+  // bookkeeping and printout in the order of the algos
+  for (unsigned int ipos = 0; ipos < _algos.size(); ++ipos)
+  {
+    for (auto &_input : _inputs)
+    {
+      jetconns[ipos]->insert_src(_input->get_src());
+    }
+    if (Verbosity() > 7)
+    {
+      std::cout << " Verbosity()>7:: jets in container " << _outputs[ipos] << std::endl;
+      jetconns[ipos]->print_jets();
+    }
+  }
+}
+
+bool JetReco::pseudojet_input() const
+{
+  if (!m_use_pseudojet_input || use_jetmap)
+  {
+    return false;
+  }
+  for (auto *_input : _inputs)
+  {
+    if (!_input->has_pseudojet_input())
+    {
+      return false;
+    }
+  }
+  for (auto *_algo : _algos)
+  {
+    if (!_algo->accepts_pseudojet_input())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 JetAlgo *JetReco::get_algo(unsigned int which_algo)
 {
   if (_algos.size() == 0)
@@ -7,15 +7,18 @@
 /// \author Mike McCumber
 //===========================================================
 
+#include "Jet.h"
+
 // PHENIX includes
 #include <fun4all/SubsysReco.h>
 
+#include <fastjet/PseudoJet.hh>
+
 // standard includes
 #include <string>  // for string
 #include <vector>
 
 // forward declarations
-class Jet;
 class JetAlgo;
 class JetInput;
 class PHCompositeNode;
@@ -54,6 +57,15 @@ class JetReco : public SubsysReco
 
   void set_algo_node(const std::string &algonode) { _algonode = algonode; }
   void set_input_node(const std::string &inputnode) { _inputnode = inputnode; }
+  //! hand the inputs directly as pseudojets to the algos if all of them support it (default on)
+  void set_use_pseudojet_input(bool b) { m_use_pseudojet_input = b; }
+  /*!
+    \brief number of threads used to run the algos concurrently (pseudojet input path only).
+    All algos get the same inputs and fill their own JetContainer. Algos computing
+    jet areas or rho draw random ghosts from the fastjet shared generator, they are
+    clustered sequentially in algo order, so the output does not depend on the number of threads
+  */
+  void set_nthreads(unsigned int n) { m_nthreads = n; }
   /* void set_fill_JetContainer(bool b) { _fill_JetContainer = b; } */
 
   JetAlgo *get_algo(unsigned int which_algo = 0);
@@ -62,6 +74,8 @@ class JetReco : public SubsysReco
   int CreateNodes(PHCompositeNode *topNode);
   void FillJetNode(PHCompositeNode *topNode, int ialgo, const std::vector<Jet *> &jets);
   void FillJetContainer(PHCompositeNode *topNode, int ialgo, std::vector<Jet *> &jets);
+  void FillJetContainers(PHCompositeNode *topNode);
+  bool pseudojet_input() const;
 
   std::vector<JetInput *> _inputs;
   std::vector<JetAlgo *> _algos;
@@ -69,6 +83,20 @@ class JetReco : public SubsysReco
   std::string _inputnode;
   std::vector<std::string> _outputs;
 
+  // pseudojet input path, reused from event to event so they only allocate once
+  bool m_use_pseudojet_input{true};
+  bool m_use_pseudojets{false};
+  unsigned int m_nthreads{1};
+  std::vector<fastjet::PseudoJet> m_pseudojets;
+  Jet::TYPE_comp_vec m_pseudojet_comps;
+
+  // prepared constituents, shared by the algos with the same constituent_key()
+  std::vector<std::vector<fastjet::PseudoJet>> m_constituents;
+  // index in m_constituents for each algo
+  std::vector<unsigned int> m_constituent_index;
+  // algo which prepares each entry of m_constituents
+  std::vector<unsigned int> m_constituent_algo;
+
   // transition functions, while moving from JetMap to JetContainer.
   // May be removed after transition is made, depending on state of
   // functions
@@ -8,6 +8,7 @@
 #include <calobase/RawTowerDefs.h>  // for encode_towerid
 #include <calobase/RawTowerGeom.h>
 #include <calobase/RawTowerGeomContainer.h>
+#include <calobase/RawTowerGeomTable.h>
 #include <calobase/TowerInfo.h>
 #include <calobase/TowerInfoContainer.h>
 #include <globalvertex/GlobalVertex.h>
@@ -15,8 +16,10 @@
 
 #include <phool/getClass.h>
 
+#include <fastjet/PseudoJet.hh>
+
 #include <cassert>
-#include <cmath>  // for asinh, atan2, cos, cosh
+#include <cmath>  // for asinh, atan2, cos, cosh, sqrt
 #include <iostream>
 #include <map>      // for _Rb_tree_const_iterator
 #include <utility>  // for pair
@@ -58,30 +61,8 @@ void TowerJetInput::identify(std::ostream &os)
   os << std::endl;
 }
 
-std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
+bool TowerJetInput::find_nodes(PHCompositeNode *topNode, RawTowerContainer *&towers, TowerInfoContainer *&towerinfos, RawTowerGeomContainer *&geom)
 {
-  if (Verbosity() > 0)
-  {
-    std::cout << "TowerJetInput::process_event -- entered" << std::endl;
-  }
-
-  GlobalVertexMap *vertexmap = findNode::getClass<GlobalVertexMap>(topNode, "GlobalVertexMap");
-  if (!vertexmap)
-  {
-    std::cout << "TowerJetInput::get_input - Fatal Error - GlobalVertexMap node is missing. Please turn on the do_global flag in the main macro in order to reconstruct the global vertex." << std::endl;
-    assert(vertexmap);  // force quit
-
-    return std::vector<Jet *>();
-  }
-
-  if (vertexmap->empty())
-  {
-    if (Verbosity() > 0)
-    {
-      std::cout << "TowerJetInput::get_input - Fatal Error - GlobalVertexMap node is empty. Please turn on the do_bbc or tracking reco flags in the main macro in order to reconstruct the global vertex." << std::endl;
-    }
-    return std::vector<Jet *>();
-  }
   m_use_towerinfo = false;
 
   /* std::string name =(m_input == Jet::CEMC_TOWER ? "CEMC_TOWER" */
@@ -107,16 +88,16 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
   /*                        : "NO NAME"); */
   /* std::cout << " TowerJetInput (" << name << ")" << std::endl; */
 
-  RawTowerContainer *towers = nullptr;
-  TowerInfoContainer *towerinfos = nullptr;
-  RawTowerGeomContainer *geom = nullptr;
+  towers = nullptr;
+  towerinfos = nullptr;
+  geom = nullptr;
   if (m_input == Jet::CEMC_TOWER)
   {
     towers = findNode::getClass<RawTowerContainer>(topNode, "TOWER_CALIB_CEMC");
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO)
@@ -128,7 +109,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::CEMC;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO_EMBED)
@@ -140,7 +121,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::CEMC;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO_SIM)
@@ -152,7 +133,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::CEMC;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::EEMC_TOWER)
@@ -161,7 +142,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_EEMC");
     if ((!towers && !towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWER)
@@ -170,7 +151,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWERINFO)
@@ -182,7 +163,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWERINFO_EMBED)
@@ -194,7 +175,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::HCALIN;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWERINFO_SIM)
@@ -206,7 +187,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::HCALIN;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWER)
@@ -215,7 +196,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWERINFO)
@@ -227,7 +208,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWERINFO_EMBED)
@@ -239,7 +220,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::HCALOUT;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWERINFO_SIM)
@@ -251,7 +232,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::HCALOUT;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
 
@@ -261,7 +242,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_FEMC");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::FHCAL_TOWER)
@@ -270,7 +251,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_FHCAL");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWER_RETOWER)
@@ -279,7 +260,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO_RETOWER)
@@ -291,7 +272,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWER_SUB1)
@@ -300,7 +281,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO_SUB1)
@@ -312,7 +293,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWER_SUB1)
@@ -321,7 +302,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWERINFO_SUB1)
@@ -333,7 +314,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWER_SUB1)
@@ -342,7 +323,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWERINFO_SUB1)
@@ -354,7 +335,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWER_SUB1CS)
@@ -363,7 +344,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWER_SUB1CS)
@@ -372,7 +353,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWER_SUB1CS)
@@ -381,24 +362,45 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else
   {
-    return std::vector<Jet *>();
+    return false;
+  }
+  return true;
+}
+
+bool TowerJetInput::get_vertex_z(PHCompositeNode *topNode, float &vtxz)
+{
+  GlobalVertexMap *vertexmap = findNode::getClass<GlobalVertexMap>(topNode, "GlobalVertexMap");
+  if (!vertexmap)
+  {
+    std::cout << "TowerJetInput::get_input - Fatal Error - GlobalVertexMap node is missing. Please turn on the do_global flag in the main macro in order to reconstruct the global vertex." << std::endl;
+    assert(vertexmap);  // force quit
+
+    return false;
+  }
+
+  if (vertexmap->empty())
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << "TowerJetInput::get_input - Fatal Error - GlobalVertexMap node is empty. Please turn on the do_bbc or tracking reco flags in the main macro in order to reconstruct the global vertex." << std::endl;
+    }
+    return false;
   }
 
   // first grab the event vertex or bail
   GlobalVertex *vtx = vertexmap->begin()->second;
-  float vtxz = NAN;
   if (vtx)
   {
     vtxz = vtx->get_z();
   }
   else
   {
-    return std::vector<Jet *>();
+    return false;
   }
 
   if (std::isnan(vtxz))
@@ -411,7 +413,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
       std::cout << "TowerJetInput::get_input - WARNING - vertex is NAN. Drop all tower inputs (further NAN-vertex warning will be suppressed)." << std::endl;
     }
 
-    return std::vector<Jet *>();
+    return false;
   }
 
   if (std::abs(vtxz) > 1e3)  // code crashes with very large z vertex, so skip these events
@@ -424,6 +426,24 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
       std::cout << "TowerJetInput::get_input - WARNING - vertex is " << vtxz << ". Drop all tower inputs (further vertex warning will be suppressed)." << std::endl;
     }
 
+    return false;
+  }
+  return true;
+}
+
+std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
+{
+  if (Verbosity() > 0)
+  {
+    std::cout << "TowerJetInput::process_event -- entered" << std::endl;
+  }
+
+  float vtxz = NAN;
+  RawTowerContainer *towers = nullptr;
+  TowerInfoContainer *towerinfos = nullptr;
+  RawTowerGeomContainer *geom = nullptr;
+  if (!get_vertex_z(topNode, vtxz) || !find_nodes(topNode, towers, towerinfos, geom))
+  {
     return std::vector<Jet *>();
   }
 
@@ -435,16 +455,15 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
       return std::vector<Jet *>();
     }
 
+    RawTowerGeomTable *geomtable = RawTowerGeomTable::GetTable(topNode, "TOWERGEOM_" + RawTowerDefs::convert_caloid_to_name(geocaloid));
+    assert(geomtable);
+    geomtable->map_channels(towerinfos);
     unsigned int nchannels = towerinfos->size();
     for (unsigned int channel = 0; channel < nchannels; channel++)
     {
       TowerInfo *tower = towerinfos->get_tower_at_channel(channel);
       assert(tower);
 
-      unsigned int calokey = towerinfos->encode_key(channel);
-      int ieta = towerinfos->getTowerEtaBin(calokey);
-      int iphi = towerinfos->getTowerPhiBin(calokey);
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(geocaloid, ieta, iphi);
       // skip masked towers
       if (tower->get_isHot() || tower->get_isNoCalib() || tower->get_isNotInstr() || tower->get_isBadChi2())
       {
@@ -454,12 +473,12 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
       {
         continue;
       }
-      RawTowerGeom *tower_geom = geom->get_tower_geometry(key);
-      assert(tower_geom);
+      unsigned int itower = geomtable->index_of_channel(channel);
+      assert(geomtable->has_tower(itower));
 
-      double r = tower_geom->get_center_radius();
-      double phi = atan2(tower_geom->get_center_y(), tower_geom->get_center_x());
-      double z0 = tower_geom->get_center_z();
+      double r = geomtable->get_center_radius(itower);
+      double phi = atan2(geomtable->get_center_y(itower), geomtable->get_center_x(itower));
+      double z0 = geomtable->get_center_z(itower);
       double z = z0 - vtxz;
       double eta = asinh(z / r);  // eta after shift from vertex
       double pt = tower->get_energy() / cosh(eta);
@@ -513,3 +532,93 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
   }
   return pseudojets;
 }
+
+void TowerJetInput::get_pseudojets(PHCompositeNode *topNode, std::vector<fastjet::PseudoJet> &pseudojets, Jet::TYPE_comp_vec &comps)
+{
+  if (Verbosity() > 0)
+  {
+    std::cout << "TowerJetInput::get_pseudojets -- entered" << std::endl;
+  }
+
+  float vtxz = NAN;
+  RawTowerContainer *towers = nullptr;
+  TowerInfoContainer *towerinfos = nullptr;
+  RawTowerGeomContainer *geom = nullptr;
+  if (!get_vertex_z(topNode, vtxz) || !find_nodes(topNode, towers, towerinfos, geom))
+  {
+    return;
+  }
+
+  // same kinematics as get_input, written without the asinh/cosh/sinh round trip:
+  // pt = E r / |(r, z)| and pz = E z / |(r, z)|
+  if (m_use_towerinfo)
+  {
+    if (!towerinfos)
+    {
+      return;
+    }
+    RawTowerGeomTable *geomtable = RawTowerGeomTable::GetTable(topNode, "TOWERGEOM_" + RawTowerDefs::convert_caloid_to_name(geocaloid));
+    assert(geomtable);
+    geomtable->map_channels(towerinfos);
+    unsigned int nchannels = towerinfos->size();
+    pseudojets.reserve(pseudojets.size() + nchannels);
+    comps.reserve(comps.size() + nchannels);
+    for (unsigned int channel = 0; channel < nchannels; channel++)
+    {
+      TowerInfo *tower = towerinfos->get_tower_at_channel(channel);
+      assert(tower);
+
+      // skip masked towers
+      if (tower->get_isHot() || tower->get_isNoCalib() || tower->get_isNotInstr() || tower->get_isBadChi2())
+      {
+        continue;
+      }
+      double e = tower->get_energy();
+      if (std::isnan(e))
+      {
+        continue;
+      }
+      unsigned int itower = geomtable->index_of_channel(channel);
+      assert(geomtable->has_tower(itower));
+
+      // the direction in the transverse plane comes straight from the tower center
+      double x = geomtable->get_center_x(itower);
+      double y = geomtable->get_center_y(itower);
+      double r = geomtable->get_center_radius(itower);
+      double z = geomtable->get_center_z(itower) - vtxz;
+      double norm = e / std::sqrt((r * r) + (z * z));
+      double pt = norm * r;
+      double rxy = std::sqrt((x * x) + (y * y));
+
+      pseudojets.emplace_back(pt * x / rxy, pt * y / rxy, norm * z, e);
+      pseudojets.back().set_user_index(comps.size());
+      comps.emplace_back(m_input, channel);
+    }
+  }
+  else
+  {
+    RawTowerContainer::ConstRange begin_end = towers->getTowers();
+    for (RawTowerContainer::ConstIterator rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
+    {
+      RawTower *tower = rtiter->second;
+
+      RawTowerGeom *tower_geom = geom->get_tower_geometry(tower->get_key());
+      assert(tower_geom);
+
+      double r = tower_geom->get_center_radius();
+      double phi = atan2(tower_geom->get_center_y(), tower_geom->get_center_x());
+      double z = tower_geom->get_center_z() - vtxz;
+      double e = tower->get_energy();
+      double norm = e / std::sqrt((r * r) + (z * z));
+      double pt = norm * r;
+
+      pseudojets.emplace_back(pt * cos(phi), pt * sin(phi), norm * z, e);
+      pseudojets.back().set_user_index(comps.size());
+      comps.emplace_back(m_input, tower->get_id());
+    }
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << "TowerJetInput::get_pseudojets -- exited" << std::endl;
+  }
+}
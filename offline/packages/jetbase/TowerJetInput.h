@@ -11,6 +11,10 @@
 #include <vector>
 // forward declarations
 class PHCompositeNode;
+class RawTowerContainer;
+class RawTowerGeomContainer;
+class TowerInfoContainer;
+
 class TowerJetInput : public JetInput
 {
  public:
@@ -23,7 +27,13 @@ class TowerJetInput : public JetInput
 
   std::vector<Jet*> get_input(PHCompositeNode* topNode) override;
 
+  bool has_pseudojet_input() const override { return true; }
+  void get_pseudojets(PHCompositeNode* topNode, std::vector<fastjet::PseudoJet>& pseudojets, Jet::TYPE_comp_vec& comps) override;
+
  private:
+  bool find_nodes(PHCompositeNode* topNode, RawTowerContainer*& towers, TowerInfoContainer*& towerinfos, RawTowerGeomContainer*& geom);
+  bool get_vertex_z(PHCompositeNode* topNode, float& vtxz);
+
   Jet::SRC m_input;
   RawTowerDefs::CalorimeterId geocaloid{RawTowerDefs::CalorimeterId::NONE};
   bool m_use_towerinfo {false};
@@ -25,9 +25,11 @@
 #include <TSystem.h>
 #include <TDirectory.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <thread>
 
 MbdEvent::MbdEvent(const int cal_pass) :
   _calpass(cal_pass)
@@ -46,6 +48,10 @@ MbdEvent::MbdEvent(const int cal_pass) :
   {
     do_templatefit = 1;
   }
+  if (rc->FlagExist("MBD_NTHREADS"))
+  {
+    _nthreads = rc->get_IntFlag("MBD_NTHREADS");
+  }
 #else
   do_templatefit = 0;
   _is_online = 1;
@@ -148,6 +154,7 @@ int MbdEvent::InitRun()
   for (int ifeech = 0; ifeech < MbdDefs::BBC_N_FEECH; ifeech++)
   {
     _mbdsig[ifeech].SetCalib(_mbdcal);
+    _mbdsig[ifeech].SetFastFit( do_templatefit == 2 );
 
     // Do evt-by-evt pedestal using sample range below
     if ( _calpass==1 || _is_online || _no_sampmax>0 )
@@ -316,6 +323,23 @@ int MbdEvent::End()
     orig_dir->cd();
   }
 
+  if ( do_templatefit == 3 )
+  {
+    // summary of fast vs TF1 template fits
+    std::cout << "MbdEvent::End(), fast vs TF1 template fits: " << m_fitcmp_n << " fits compared, "
+              << m_fitcmp_nmismatch << " with only one fit above threshold" << std::endl;
+    if ( m_fitcmp_n > 0 )
+    {
+      const double meandt = m_fitcmp_sumdt/m_fitcmp_n;
+      const double meanda = m_fitcmp_sumda/m_fitcmp_n;
+      std::cout << "  time diff (samples) mean " << meandt
+                << " rms " << std::sqrt( std::max(m_fitcmp_sumdt2/m_fitcmp_n - meandt*meandt, 0.) )
+                << " max " << m_fitcmp_maxdt << std::endl;
+      std::cout << "  relative ampl diff mean " << meanda
+                << " rms " << std::sqrt( std::max(m_fitcmp_sumda2/m_fitcmp_n - meanda*meanda, 0.) ) << std::endl;
+    }
+  }
+
   return 1;
 }
 
@@ -584,6 +608,12 @@ int MbdEvent::ProcessRawPackets(MbdPmtContainer *bbcpmts)
   std::array<Double_t,MbdDefs::MBD_N_FEECH> tdc{0.};
   tdc.fill( 0. );
 
+  // fast template fits of all charge channels, done upfront so that they can run in parallel
+  if ( do_templatefit >= 2 )
+  {
+    FitTemplatesFast();
+  }
+
   for (int ifeech = 0; ifeech < MbdDefs::BBC_N_FEECH; ifeech++)
   {
     int pmtch = _mbdgeom->get_pmt(ifeech);
@@ -617,7 +647,7 @@ int MbdEvent::ProcessRawPackets(MbdPmtContainer *bbcpmts)
       Double_t threshold = 0.5;
       m_pmttq[pmtch] = _mbdsig[ifeech].dCFD(threshold);
       m_ampl[ifeech] = _mbdsig[ifeech].GetAmpl(); // in adc units
-      if (do_templatefit)
+      if (do_templatefit == 1 || do_templatefit == 3)
       {
         //std::cout << "fittemplate" << std::endl;
         _mbdsig[ifeech].FitTemplate( _mbdcal->get_sampmax(ifeech) );
@@ -628,6 +658,16 @@ int MbdEvent::ProcessRawPackets(MbdPmtContainer *bbcpmts)
         }
         m_pmttq[pmtch] = _mbdsig[ifeech].GetTime(); // in units of sample number
         m_ampl[ifeech] = _mbdsig[ifeech].GetAmpl(); // in units of adc
+
+        if ( do_templatefit == 3 )
+        {
+          CompareTemplateFits(ifeech);
+        }
+      }
+      else if (do_templatefit == 2)
+      {
+        m_pmttq[pmtch] = m_fittime[ifeech]; // in units of sample number
+        m_ampl[ifeech] = m_fitampl[ifeech]; // in units of adc
       }
 
       // calpass 2, uncal_mbd. template fit. make sure qgain = 1, tq_t0 = 0
@@ -731,6 +771,86 @@ int MbdEvent::ProcessRawPackets(MbdPmtContainer *bbcpmts)
   return m_evt;
 }
 
+// Run the fast template fit on all charge channels, split over _nthreads threads
+void MbdEvent::FitTemplatesFast()
+{
+  std::vector<int> chgch;
+  chgch.reserve(MbdDefs::MBD_N_FEECH);
+  for (int ifeech = 0; ifeech < MbdDefs::BBC_N_FEECH; ifeech++)
+  {
+    if ( _mbdgeom->get_type(ifeech) == 1 )
+    {
+      chgch.push_back(ifeech);
+    }
+  }
+
+  // each thread fits every nthreads'th channel
+  auto fit_channels = [this, &chgch](const unsigned int ithread, const unsigned int nthreads)
+  {
+    for (size_t ich = ithread; ich < chgch.size(); ich += nthreads)
+    {
+      const int ifeech = chgch[ich];
+      _mbdsig[ifeech].FitTemplateFast( _mbdcal->get_sampmax(ifeech) );
+      m_fitampl[ifeech] = _mbdsig[ifeech].GetAmpl();
+      m_fittime[ifeech] = _mbdsig[ifeech].GetTime();
+    }
+  };
+
+  const unsigned int nthreads = std::max(_nthreads, 1);
+  if ( nthreads == 1 )
+  {
+    fit_channels(0, 1);
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  threads.reserve(nthreads - 1);
+  for (unsigned int ithread = 1; ithread < nthreads; ithread++)
+  {
+    threads.emplace_back(fit_channels, ithread, nthreads);
+  }
+  fit_channels(0, nthreads);
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+}
+
+// Compare fast template fit to the TF1 fit, both must have been done for this channel
+void MbdEvent::CompareTemplateFits(const int ifeech)
+{
+  const Double_t ampl = _mbdsig[ifeech].GetAmpl();
+  const Double_t time = _mbdsig[ifeech].GetTime();
+  const bool good = !std::isnan(time) && ampl > 0.;
+  const bool fastgood = !std::isnan(m_fittime[ifeech]) && m_fitampl[ifeech] > 0.;
+
+  if ( good != fastgood )
+  {
+    m_fitcmp_nmismatch++;
+    return;
+  }
+  if ( !good )
+  {
+    return;
+  }
+
+  const double dtime = m_fittime[ifeech] - time;
+  const double dampl = (m_fitampl[ifeech] - ampl)/ampl;
+  m_fitcmp_n++;
+  m_fitcmp_sumdt += dtime;
+  m_fitcmp_sumdt2 += dtime*dtime;
+  m_fitcmp_sumda += dampl;
+  m_fitcmp_sumda2 += dampl*dampl;
+  m_fitcmp_maxdt = std::max( m_fitcmp_maxdt, std::fabs(dtime) );
+
+  if ( _verbose )
+  {
+    std::cout << "fitcmp " << m_evt << "\t" << ifeech << "\t" << ampl << "\t" << m_fitampl[ifeech]
+              << "\t" << time << "\t" << m_fittime[ifeech] << std::endl;
+  }
+}
+
 ///
 int MbdEvent::Calculate(MbdPmtContainer *bbcpmts, MbdOut *bbcout)
 {
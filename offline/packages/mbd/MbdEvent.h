@@ -75,6 +75,13 @@ class MbdEvent
   int  Verbosity() { return _verbose; }
   void Verbosity(const int v) { _verbose = v; }
 
+  /** template fit mode: 0 = no fit, 1 = TF1 fit, 2 = fast fit, 3 = both, and compare.
+   *  Default is set by the MBD_TEMPLATEFIT flag */
+  void SetTemplateFit(const int t) { do_templatefit = t; }
+
+  /** number of threads for fast template fits. Default is set by the MBD_NTHREADS flag */
+  void SetNThreads(const int n) { _nthreads = n; }
+
  private:
   static const int NCHPERPKT = 128;
 
@@ -124,6 +131,20 @@ class MbdEvent
   Float_t m_pmttq[MbdDefs::MBD_N_PMT]{};  // time in each arm
 
   int do_templatefit{1};
+  int _nthreads{1};
+
+  // fast template fits (do_templatefit >= 2)
+  void FitTemplatesFast();
+  void CompareTemplateFits(const int ifeech);
+  Double_t m_fitampl[MbdDefs::MBD_N_FEECH]{};  // fast fit amplitude
+  Double_t m_fittime[MbdDefs::MBD_N_FEECH]{};  // fast fit time
+  unsigned long m_fitcmp_n{0};                 // number of compared fits
+  unsigned long m_fitcmp_nmismatch{0};         // number of fits with only one above threshold
+  double m_fitcmp_sumdt{0.};
+  double m_fitcmp_sumdt2{0.};
+  double m_fitcmp_sumda{0.};
+  double m_fitcmp_sumda2{0.};
+  double m_fitcmp_maxdt{0.};
 
   // output data
   Short_t m_bbcn[2]{};                                            // num hits for each arm (north and south)
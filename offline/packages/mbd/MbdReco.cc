@@ -59,6 +59,16 @@ int MbdReco::InitRun(PHCompositeNode *topNode)
   m_mbdevent->SetSim(_simflag);
   m_mbdevent->InitRun();
 
+  // lets Fun4AllServer run this module concurrently with modules using other nodes.
+  // decoding from the Event object is not known to be thread safe,
+  // declaring it as output serializes all modules reading it
+  DeclareOutputNode("PRDF");
+  DeclareInputNode("MBDPackets");
+  DeclareInputNode("GL1Packet");
+  DeclareOutputNode("MbdPmtContainer");
+  DeclareOutputNode("MbdOut");
+  DeclareOutputNode("MbdVertexMap");
+
   return ret;
 }
 
@@ -13,6 +13,9 @@
 #include <TSpline.h>
 #include <TTree.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <limits>
@@ -473,32 +476,76 @@ void MbdSig::CalcEventPed0_PreSamp(const int presample, const int nsamps)
     rms = 5.0;
   }
 
-  ped_fcn->SetRange(minsamp-0.1,maxsamp+0.1);
-  ped_fcn->SetParameter(0,1500.);
-  if ( _verbose )
+  double pedfit_mean = 0.;
+  double chi2 = 0.;
+  double ndf = 0.;
+  if ( _fastfit && !_verbose )
   {
-    gRawPulse->Fit( ped_fcn, "RQ" );
+    // closed-form fit of a constant: error weighted mean of the samples in range
+    Int_t n = gRawPulse->GetN();
+    Double_t *x = gRawPulse->GetX();
+    Double_t *y = gRawPulse->GetY();
+    Double_t *ey = gRawPulse->GetEY();
+    double sumw = 0.;
+    double sumwy = 0.;
+    int npts = 0;
+    for (int isamp = 0; isamp < n; isamp++)
+    {
+      if ( x[isamp] < minsamp-0.1 || x[isamp] > maxsamp+0.1 )
+      {
+        continue;
+      }
+      double w = ( ey[isamp] > 0. ) ? 1.0/(ey[isamp]*ey[isamp]) : 1.0;
+      sumw += w;
+      sumwy += w*y[isamp];
+      npts++;
+    }
 
-    double chi2ndf = ped_fcn->GetChisquare()/ped_fcn->GetNDF();
-    if ( chi2ndf > 4.0 )
+    if ( npts > 0 )
     {
-      gRawPulse->Draw("ap");
-      ped_fcn->Draw("same");
-      PadUpdate();
+      pedfit_mean = sumwy/sumw;
+      for (int isamp = 0; isamp < n; isamp++)
+      {
+        if ( x[isamp] < minsamp-0.1 || x[isamp] > maxsamp+0.1 )
+        {
+          continue;
+        }
+        double w = ( ey[isamp] > 0. ) ? 1.0/(ey[isamp]*ey[isamp]) : 1.0;
+        chi2 += w*(y[isamp]-pedfit_mean)*(y[isamp]-pedfit_mean);
+      }
+      ndf = npts - 1;
     }
   }
   else
   {
-    //std::cout << PHWHERE << std::endl;
-    gRawPulse->Fit( ped_fcn, "RNQ" );
-  }
+    ped_fcn->SetRange(minsamp-0.1,maxsamp+0.1);
+    ped_fcn->SetParameter(0,1500.);
+    if ( _verbose )
+    {
+      gRawPulse->Fit( ped_fcn, "RQ" );
 
-  double chi2 = ped_fcn->GetChisquare();
-  double ndf = ped_fcn->GetNDF();
+      double chi2ndf = ped_fcn->GetChisquare()/ped_fcn->GetNDF();
+      if ( chi2ndf > 4.0 )
+      {
+        gRawPulse->Draw("ap");
+        ped_fcn->Draw("same");
+        PadUpdate();
+      }
+    }
+    else
+    {
+      //std::cout << PHWHERE << std::endl;
+      gRawPulse->Fit( ped_fcn, "RNQ" );
+    }
+
+    pedfit_mean = ped_fcn->GetParameter(0);
+    chi2 = ped_fcn->GetChisquare();
+    ndf = ped_fcn->GetNDF();
+  }
 
   if ( chi2/ndf < 4.0 )
   {
-    mean = ped_fcn->GetParameter(0);
+    mean = pedfit_mean;
 
     Double_t x, y;
 
@@ -1074,6 +1121,228 @@ int MbdSig::FitTemplate( const Int_t sampmax )
   return 1;
 }
 
+// Same as FitTemplate, without TF1.
+// The template is linearly interpolated from the precomputed table, and the amplitude
+// and time are obtained from a Gauss-Newton least squares fit on the samples.
+// Points rejected in TemplateFcn (outside template, bad template rms, ADC saturation)
+// are also excluded here.
+int MbdSig::FitTemplateFast( const Int_t sampmax )
+{
+  if (_verbose > 0)
+  {
+    cout << "Fast fitting ch " << _ch << endl;
+  }
+
+  const int n = std::min( gSubPulse->GetN(), MbdDefs::MAX_SAMPLES );
+
+  // Check if channel is empty
+  if (n == 0)
+  {
+    f_ampl = 0.;
+    f_time = std::numeric_limits<Float_t>::quiet_NaN();
+    cout << "ERROR, gSubPulse empty" << endl;
+    return 1;
+  }
+
+  // copy samples to fixed size arrays
+  std::array<Double_t, MbdDefs::MAX_SAMPLES> x{};
+  std::array<Double_t, MbdDefs::MAX_SAMPLES> y{};
+  std::array<bool, MbdDefs::MAX_SAMPLES> reject{};
+  const Double_t *gx = gSubPulse->GetX();
+  const Double_t *gy = gSubPulse->GetY();
+  const Double_t *rawy = gRawPulse->GetY();
+  const int nraw = gRawPulse->GetN();
+  for (int isamp = 0; isamp < n; isamp++)
+  {
+    x[isamp] = gx[isamp];
+    y[isamp] = gy[isamp];
+
+    // Reject points where ADC saturates
+    const int samp_point = static_cast<int>(gx[isamp]);
+    reject[isamp] = ( samp_point >= 0 && samp_point < nraw && rawy[samp_point] > 16370 );
+  }
+
+  // Get x and y of maximum
+  Double_t x_at_max{-1.};
+  Double_t ymax{0.};
+  if ( sampmax>=0 )
+  {
+    if ( sampmax < n )
+    {
+      x_at_max = x[sampmax] - 2.0;
+      ymax = y[sampmax];
+    }
+  }
+  else
+  {
+    ymax = TMath::MaxElement( n, y.data() );
+    x_at_max = TMath::LocMax( n, y.data() );
+  }
+
+  // Threshold cut
+  if ( ymax < 20. )
+  {
+    f_ampl = 0.;
+    f_time = std::numeric_limits<Float_t>::quiet_NaN();
+    return 1;
+  }
+
+  Double_t ampl = ymax;
+  Double_t time = x_at_max;
+  FitTemplateGN( x.data(), y.data(), reject.data(), n, 0., _nsamples, ampl, time );
+  if ( time<0. || time>_nsamples )
+  {
+    time = _nsamples*0.5;  // bad fit last time
+  }
+
+  // refit with new range to exclude after-pulses
+  FitTemplateGN( x.data(), y.data(), reject.data(), n, 0., time+4.0, ampl, time );
+
+  f_ampl = ampl;
+  f_time = time;
+
+  if (_verbose > 0)
+  {
+    cout << "FitTemplateFast " << _ch << "\t" << f_ampl << "\t" << f_time << endl;
+  }
+
+  return 1;
+}
+
+void MbdSig::FitTemplateGN(const Double_t *x, const Double_t *y, const bool *reject, const int n,
+                           const Double_t xmin, const Double_t xmax, Double_t &ampl, Double_t &time) const
+{
+  static const int max_iterations = 50;
+  for (int iter = 0; iter < max_iterations; iter++)
+  {
+    // normal equations for model ampl*T(x-time)
+    // d/dampl = T, d/dtime = -ampl*T'
+    Double_t stt{0.};
+    Double_t sts{0.};
+    Double_t sss{0.};
+    Double_t str{0.};
+    Double_t ssr{0.};
+    int npts = 0;
+    for (int isamp = 0; isamp < n; isamp++)
+    {
+      if ( reject[isamp] || x[isamp] < xmin || x[isamp] > xmax )
+      {
+        continue;
+      }
+
+      Double_t tval{0.};
+      Double_t tslope{0.};
+      if ( !TemplateValue( x[isamp] - time, tval, tslope ) )
+      {
+        continue;
+      }
+
+      const Double_t resid = y[isamp] - ampl*tval;
+      stt += tval*tval;
+      sts += tval*tslope;
+      sss += tslope*tslope;
+      str += tval*resid;
+      ssr += tslope*resid;
+      npts++;
+    }
+
+    if ( npts < 2 || stt <= 0. )
+    {
+      return;
+    }
+
+    // solve 2x2 system for the steps in ampl and time
+    const Double_t a11 = stt;
+    const Double_t a12 = -ampl*sts;
+    const Double_t a22 = ampl*ampl*sss;
+    const Double_t b1 = str;
+    const Double_t b2 = -ampl*ssr;
+    const Double_t det = a11*a22 - a12*a12;
+
+    Double_t dampl{0.};
+    Double_t dtime{0.};
+    if ( std::fabs(det) > 1e-12*a11*std::max(a22,1e-12) )
+    {
+      dampl = (a22*b1 - a12*b2)/det;
+      dtime = (a11*b2 - a12*b1)/det;
+    }
+    else
+    {
+      // time is not constrained, only solve for amplitude (closed form)
+      dampl = b1/a11;
+    }
+
+    // limit time step to one sample, the template is only piecewise linear
+    dtime = std::clamp( dtime, -1.0, 1.0 );
+
+    ampl += dampl;
+    time += dtime;
+
+    if ( std::isnan(ampl) || std::isnan(time) )
+    {
+      return;
+    }
+
+    if ( std::fabs(dtime) < 1e-5 && std::fabs(dampl) <= 1e-6*std::fabs(ampl) )
+    {
+      return;
+    }
+  }
+}
+
+bool MbdSig::TemplateValue(const Double_t xx, Double_t &value, Double_t &slope) const
+{
+  // When fit is out of limits of good part of spline, point is rejected
+  if (xx < template_begintime || xx > template_endtime || std::isnan(xx) || template_slope.empty())
+  {
+    return false;
+  }
+
+  // find the index in the vector which is closest to xx
+  const Double_t step = (template_endtime - template_begintime) / (template_npointsx - 1);
+  const Double_t index = (xx - template_begintime) / step;
+
+  int ilow = TMath::FloorNint(index);
+  int ihigh = TMath::CeilNint(index);
+  ilow = std::clamp( ilow, 0, template_npointsx - 1 );
+  ihigh = std::clamp( ihigh, 0, template_npointsx - 1 );
+
+  // reject points with very bad rms in shape
+  if ( !template_good[ilow] || !template_good[ihigh] )
+  {
+    return false;
+  }
+
+  const int islope = std::min( ilow, template_npointsx - 2 );
+  slope = template_slope[islope];
+  value = template_y[ilow] + slope * (xx - (template_begintime + ilow * step));
+
+  return true;
+}
+
+void MbdSig::FillTemplateTable()
+{
+  template_slope.clear();
+  template_good.clear();
+  if ( template_npointsx < 2 || (int)template_y.size() < template_npointsx || (int)template_yrms.size() < template_npointsx )
+  {
+    return;
+  }
+
+  const Double_t step = (template_endtime - template_begintime) / (template_npointsx - 1);
+  template_slope.resize(template_npointsx - 1);
+  for (int i = 0; i < template_npointsx - 1; i++)
+  {
+    template_slope[i] = (template_y[i + 1] - template_y[i]) / step;
+  }
+
+  template_good.resize(template_npointsx);
+  for (int i = 0; i < template_npointsx; i++)
+  {
+    template_good[i] = ( template_yrms[i] < 1.0 );
+  }
+}
+
 int MbdSig::SetTemplate(const std::vector<float>& shape, const std::vector<float>& sherr)
 {
   template_y = shape;
@@ -1114,5 +1383,7 @@ int MbdSig::SetTemplate(const std::vector<float>& shape, const std::vector<float
     }
   }
 
+  FillTemplateTable();
+
   return 1;
 }
@@ -1,6 +1,7 @@
 #ifndef __MBDSIG_H__
 #define __MBDSIG_H__
 
+#include "MbdDefs.h"
 #include "MbdRunningStats.h"
 
 #include <TH1.h>
@@ -102,6 +103,13 @@ class MbdSig
 
   /** Use template fit to get ampl and time */
   Int_t FitTemplate(const Int_t sampmax = -1);
+
+  /** Same as FitTemplate, using a Gauss-Newton fit on the precomputed template table instead of TF1.
+   *  Does not use any shared ROOT state, so different channels can be fit concurrently */
+  Int_t FitTemplateFast(const Int_t sampmax = -1);
+
+  /** Use closed-form pedestal fit instead of TF1 in CalcEventPed0_PreSamp */
+  void SetFastFit(const int f) { _fastfit = f; }
   // Double_t Ampl() { return f_ampl; }
   // Double_t Time() { return f_time; }
 
@@ -124,6 +132,16 @@ class MbdSig
  private:
   void Init();
 
+  /** Fill template_slope and template_good from template_y and template_yrms */
+  void FillTemplateTable();
+
+  /** Linear interpolation of template at xx, returns false for points rejected by TemplateFcn */
+  bool TemplateValue(const Double_t xx, Double_t &value, Double_t &slope) const;
+
+  /** Gauss-Newton fit of ampl*template(x-time) to samples with xmin <= x <= xmax */
+  void FitTemplateGN(const Double_t *x, const Double_t *y, const bool *reject, const int n,
+                     const Double_t xmin, const Double_t xmax, Double_t &ampl, Double_t &time) const;
+
   int _ch;
   int _nsamples;
   int _status{0};
@@ -184,10 +202,13 @@ class MbdSig
   // Double_t template_max_xrange{0.};             //! for template, in original units of waveform data
   std::vector<float> template_y;
   std::vector<float> template_yrms;
+  std::vector<Double_t> template_slope;  //! slope of template between consecutive points, for FitTemplateFast
+  std::vector<char> template_good;       //! whether template point rms is good, for FitTemplateFast
   TF1 *template_fcn{nullptr};
   Double_t fit_min_time{};  //! min time for fit, in original units of waveform data
   Double_t fit_max_time{};  //! max time for fit, in original units of waveform data
 
+  int _fastfit{0};
   int _verbose{0};
 };
 
@@ -114,9 +114,75 @@ int MicromegasCombinedDataDecoder::InitRun(PHCompositeNode* topNode)
     std::cout << PHWHERE << "Removing TPOT unpacker, no raw hit container" << std::endl;
   }
 
+  // build channel table
+  build_channel_table();
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+//___________________________________________________________________________
+void MicromegasCombinedDataDecoder::build_channel_table()
+{
+  m_channel_table.clear();
+
+  const auto fee_id_list = m_mapping.get_fee_id_list();
+  if (fee_id_list.empty())
+  {
+    return;
+  }
+
+  const int nfee = *std::max_element(fee_id_list.begin(), fee_id_list.end()) + 1;
+  m_channel_table.resize(nfee * MicromegasDefs::m_nchannels_fee);
+
+  for (const auto& fee : fee_id_list)
+  {
+    const TrkrDefs::hitsetkey hitsetkey = m_mapping.get_hitsetkey(fee);
+    if (!hitsetkey)
+    {
+      continue;
+    }
+
+    const int layer = int(TrkrDefs::getLayer(hitsetkey));
+    const int tile = int(MicromegasDefs::getTileId(hitsetkey));
+    for (int channel = 0; channel < MicromegasDefs::m_nchannels_fee; ++channel)
+    {
+      // check if channel is permanently masked
+      if (channel_is_permanently_masked(fee, channel))
+      {
+        continue;
+      }
+
+      // physical strip
+      const int strip = m_mapping.get_physical_strip(fee, channel);
+      if (strip < 0)
+      {
+        continue;
+      }
+
+      // check agains hot channels
+      if (m_hot_channels.is_hot_channel(layer, tile, strip))
+      {
+        continue;
+      }
+
+      // get channel rms and pedestal from calibration data
+      const double pedestal = m_calibration_data.get_pedestal(fee, channel);
+      const double rms = m_calibration_data.get_rms(fee, channel);
+
+      // a rms of zero means the calibration has failed. the data is unusable
+      if (rms <= 0)
+      {
+        continue;
+      }
+
+      auto& info = m_channel_table[fee * MicromegasDefs::m_nchannels_fee + channel];
+      info.m_hitsetkey = hitsetkey;
+      info.m_strip = strip;
+      info.m_threshold = std::max(m_min_adc, pedestal + m_n_sigma * rms);
+    }
+  }
+}
+
 //___________________________________________________________________________
 int MicromegasCombinedDataDecoder::process_event(PHCompositeNode* topNode)
 {
@@ -140,6 +206,13 @@ int MicromegasCombinedDataDecoder::process_event(PHCompositeNode* topNode)
   bool first = true;
   uint64_t first_lvl1_bco = 0;
 
+  // raw hits come grouped by packet and fee.
+  // keep the last validated packet and the last hitset, to avoid repeating the lookups
+  bool has_packet_id = false;
+  unsigned int last_packet_id = 0;
+  TrkrHitSetContainer::Iterator hitset_it;
+  bool has_hitset = false;
+
   for (unsigned int ihit = 0; ihit < rawhitcontainer->get_nhits(); ++ihit)
   {
     const auto rawhit = rawhitcontainer->get_hit(ihit);
@@ -152,10 +225,15 @@ int MicromegasCombinedDataDecoder::process_event(PHCompositeNode* topNode)
     }
 
     // make sure packet is valid
-    if (std::find(std::begin(MicromegasDefs::m_packet_ids), std::end(MicromegasDefs::m_packet_ids), packet_id) == std::end(MicromegasDefs::m_packet_ids))
+    if (!(has_packet_id && packet_id == last_packet_id))
     {
-      std::cout << "MicromegasCombinedDataDecoder::process_event - invalid packet: " << packet_id << std::endl;
-      continue;
+      if (std::find(std::begin(MicromegasDefs::m_packet_ids), std::end(MicromegasDefs::m_packet_ids), packet_id) == std::end(MicromegasDefs::m_packet_ids))
+      {
+        std::cout << "MicromegasCombinedDataDecoder::process_event - invalid packet: " << packet_id << std::endl;
+        continue;
+      }
+      has_packet_id = true;
+      last_packet_id = packet_id;
     }
 
     // get fee id, apply mapping to current fiber set, for backward compatibility
@@ -163,73 +241,45 @@ int MicromegasCombinedDataDecoder::process_event(PHCompositeNode* topNode)
     const auto channel = rawhit->get_channel();
     const int samples = rawhit->get_samples();
 
-    // check if channel is permanently masked
-    if( channel_is_permanently_masked(fee, channel ))
+    // get channel information: physical hitsetid, physical strip and threshold
+    // masked channels (permanently masked, hot, uncalibrated) have a zero hitset key
+    const int index = fee * MicromegasDefs::m_nchannels_fee + channel;
+    if (fee < 0 || channel >= MicromegasDefs::m_nchannels_fee || index >= int(m_channel_table.size()))
     {
+      std::cout << "MicromegasCombinedDataDecoder::process_event - invalid fee_id: " << fee << " channel: " << channel << std::endl;
       continue;
     }
 
-    // map fee and channel to physical hitsetid and physical strip
-    // get hitset key matching this fee
-    const TrkrDefs::hitsetkey hitsetkey = m_mapping.get_hitsetkey(fee);
+    const auto& info = m_channel_table[index];
+    const TrkrDefs::hitsetkey hitsetkey = info.m_hitsetkey;
     if (!hitsetkey)
     {
       continue;
     }
 
-    // get matching layer, tile, physical strip
-    int layer = int(TrkrDefs::getLayer(hitsetkey));
-    int tile = int(MicromegasDefs::getTileId(hitsetkey));
-    int strip = m_mapping.get_physical_strip(fee, channel);
-    if (strip < 0)
-    {
-      continue;
-    }
-
-    // check agains hot channels
-    if (m_hot_channels.is_hot_channel(layer, tile, strip))
-    {
-      continue;
-    }
-
-    // get channel rms and pedestal from calibration data
-    const double pedestal = m_calibration_data.get_pedestal(fee, channel);
-    const double rms = m_calibration_data.get_rms(fee, channel);
-
-    // a rms of zero means the calibration has failed. the data is unusable
-    if (rms <= 0)
-    {
-      continue;
-    }
+    const int strip = info.m_strip;
 
     // loop over samples find maximum
-    std::vector<uint16_t> adc_list;
+    /* TODO: use more advanced signal processing */
+    bool has_adc = false;
+    uint16_t max_adc = 0;
     for (int is = std::max(m_sample_min, 0); is < std::min(m_sample_max, samples); ++is)
     {
       const uint16_t adc = rawhit->get_adc(is);
-      if (adc != MicromegasDefs::m_adc_invalid)
+      if (adc != MicromegasDefs::m_adc_invalid && (!has_adc || adc > max_adc))
       {
-        adc_list.push_back(adc);
+        has_adc = true;
+        max_adc = adc;
       }
     }
 
-    if (adc_list.empty())
-    {
-      continue;
-    }
-
-    // get max adc value in range
-    /* TODO: use more advanced signal processing */
-    auto max_adc = *std::max_element(adc_list.begin(), adc_list.end());
-
-    // compare to hard min_adc value
-    if (max_adc < m_min_adc)
+    if (!has_adc)
     {
       continue;
     }
 
-    // compare to threshold
-    if (max_adc < pedestal + m_n_sigma * rms)
+    // compare to hard min_adc value and to threshold
+    if (max_adc < info.m_threshold)
     {
       continue;
     }
@@ -239,8 +289,8 @@ int MicromegasCombinedDataDecoder::process_event(PHCompositeNode* topNode)
       const auto bco = rawhit->get_gtm_bco();
       std::cout << "MicromegasCombinedDataDecoder::process_event -"
                 << " bco: " << bco
-                << " layer: " << layer
-                << " tile: " << tile
+                << " layer: " << int(TrkrDefs::getLayer(hitsetkey))
+                << " tile: " << int(MicromegasDefs::getTileId(hitsetkey))
                 << " channel: " << channel
                 << " strip: " << strip
                 << " adc: " << max_adc
@@ -248,7 +298,11 @@ int MicromegasCombinedDataDecoder::process_event(PHCompositeNode* topNode)
     }
 
     // get matching hitset
-    const auto hitset_it = trkrhitsetcontainer->findOrAddHitSet(hitsetkey);
+    if (!(has_hitset && hitset_it->first == hitsetkey))
+    {
+      hitset_it = trkrhitsetcontainer->findOrAddHitSet(hitsetkey);
+      has_hitset = true;
+    }
 
     // generate hit key
     const TrkrDefs::hitkey hitkey = MicromegasDefs::genHitKey(strip);
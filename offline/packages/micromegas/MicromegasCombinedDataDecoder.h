@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 
@@ -87,6 +88,25 @@ class MicromegasCombinedDataDecoder : public SubsysReco
   /// max sample for signal
   int m_sample_max = 100;
 
+  //! fill the channel table from mapping, calibrations and hot channels
+  void build_channel_table();
+
+  //! per channel decoding information, filled in InitRun
+  struct channel_info_t
+  {
+    //! matching hitset key, 0 if the channel is masked (permanently masked, hot, not mapped or not calibrated)
+    TrkrDefs::hitsetkey m_hitsetkey = 0;
+
+    //! physical strip
+    int m_strip = -1;
+
+    //! minimum max adc for a signal hit: largest of m_min_adc and pedestal + m_n_sigma*rms
+    double m_threshold = 0;
+  };
+
+  //! channel table, indexed by fee*MicromegasDefs::m_nchannels_fee + channel
+  std::vector<channel_info_t> m_channel_table;
+
   /// keep track of number of hits per hitsetid
   using hitcountmap_t = std::map<TrkrDefs::hitsetkey, int>;
   hitcountmap_t m_hitcounts;
@@ -11,6 +11,7 @@
 #include <g4detectors/PHG4CylinderGeomContainer.h>
 
 #include <trackbase/ClusHitsVerbosev1.h>
+#include <trackbase/ClusterizerTools.h>
 #include <trackbase/MvtxDefs.h>
 #include <trackbase/TrkrClusterContainerv4.h>
 #include <trackbase/TrkrClusterHitAssocv3.h>
@@ -42,23 +43,14 @@
 #include <TMatrixTUtils.h>  // for TMatrixTRow
 #include <TVector3.h>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-#include <boost/graph/adjacency_list.hpp>
-#pragma GCC diagnostic pop
-
-#include <boost/graph/connected_components.hpp>
-
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>  // for exit
 #include <iostream>
-#include <map>  // for multimap<>::iterator
-#include <set>  // for set, set<>::iterator
 #include <string>
 #include <vector>  // for vector
 
-using namespace boost;
 using namespace std;
 
 namespace
@@ -70,65 +62,307 @@ namespace
   {
     return x * x;
   }
-}  // namespace
 
-bool MvtxClusterizer::are_adjacent(
-    const std::pair<TrkrDefs::hitkey, TrkrHit *> &lhs,
-    const std::pair<TrkrDefs::hitkey, TrkrHit *> &rhs)
-{
-  if (GetZClustering())
+  /// pixel coordinates and payload, as used by the clustering sweep
+  struct pixel_hit
+  {
+    uint16_t col = 0;
+    uint16_t row = 0;
+    TrkrDefs::hitkey hitkey = 0;
+    unsigned int adc = 0;
+  };
+
+  using vec_dVerbose = std::vector<std::vector<std::pair<int, int>>>;
+
+  /// input, output and scratch buffers for all the chips of a given stave
+  struct thread_data
+  {
+    CylinderGeom_Mvtx *layergeom = nullptr;
+    unsigned int layer = 0;
+    unsigned int stave = 0;
+    std::vector<TrkrHitSet *> hitsets;
+    std::vector<RawHitSet *> rawhitsets;
+    bool make_z_clustering = true;
+    bool do_assoc = true;
+    bool fillClusHitsVerbose = false;
+    int verbosity = 0;
+
+    // output, copied to the node tree once the thread is joined
+    std::vector<std::pair<TrkrDefs::cluskey, TrkrCluster *>> cluster_vector;
+    std::vector<std::pair<TrkrDefs::cluskey, TrkrDefs::hitkey>> association_vector;
+    std::vector<TrkrDefs::cluskey> cluskey_ClusHitsVerbose;  // only fill if fillClusHitsVerbose
+    vec_dVerbose phivec_ClusHitsVerbose;                     // only fill if fillClusHitsVerbose
+    vec_dVerbose zvec_ClusHitsVerbose;                       // only fill if fillClusHitsVerbose
+
+    // scratch buffers, reused for all the chips handled by this thread
+    std::vector<pixel_hit> hits;
+    ClusterizerTools::ComponentBuffers components;
+    std::vector<std::pair<int, int>> phibins;
+    std::vector<std::pair<int, int>> zbins;
+  };
+
+  /// build clusters from the hits of a chip, and store them in thread output
+  void make_clusters(thread_data &my_data, TrkrDefs::hitsetkey hitsetkey)
   {
-    // column is first, row is second
-    if (fabs(MvtxDefs::getCol(lhs.first) - MvtxDefs::getCol(rhs.first)) <= 1)
+    const auto &hits = my_data.hits;
+    const unsigned int ncomponents = ClusterizerTools::find_components(
+        hits.size(), [&hits](unsigned int i)
+        { return (uint32_t(hits[i].col) << 16U) | hits[i].row; },
+        my_data.make_z_clustering, my_data.components);
+
+    auto layergeom = my_data.layergeom;
+    const double pitch = layergeom->get_pixel_x();
+    const double length = layergeom->get_pixel_z();
+
+    for (unsigned int clusid = 0; clusid < ncomponents; ++clusid)
     {
-      if (fabs(MvtxDefs::getRow(lhs.first) - MvtxDefs::getRow(rhs.first)) <=
-          1)
+      const auto ckey = TrkrDefs::genClusKey(hitsetkey, clusid);
+
+      // determine the size of the cluster in phi and z
+      auto &phibins = my_data.phibins;
+      auto &zbins = my_data.zbins;
+      phibins.clear();
+      zbins.clear();
+
+      // determine the cluster position...
+      double locxsum = 0.;
+      double loczsum = 0.;
+      const unsigned int nhits = my_data.components.offsets[clusid + 1] - my_data.components.offsets[clusid];
+
+      for (unsigned int index = my_data.components.offsets[clusid]; index < my_data.components.offsets[clusid + 1]; ++index)
+      {
+        const auto &hit = my_data.hits[my_data.components.members[index]];
+
+        // size
+        zbins.emplace_back(hit.col, hit.adc);
+        phibins.emplace_back(hit.row, hit.adc);
+
+        // get local coordinates, in stae reference frame, for hit
+        auto local_coords = layergeom->get_local_coords_from_pixel(hit.row, hit.col);
+
+        /*
+          manually offset position along y (thickness of the sensor),
+          to account for effective hit position in the sensor, resulting from
+          diffusion.
+          Effective position corresponds to 1um above the middle of the sensor
+        */
+        local_coords.SetY(1e-4);
+
+        // update cluster position
+        locxsum += local_coords.X();
+        loczsum += local_coords.Z();
+
+        // add the association between this cluster key and this hitkey to the
+        // table
+        if (my_data.do_assoc)
+        {
+          my_data.association_vector.emplace_back(ckey, hit.hitkey);
+        }
+      }
+
+      ClusterizerTools::merge_bins(phibins);
+      ClusterizerTools::merge_bins(zbins);
+
+      if (my_data.fillClusHitsVerbose)
+      {
+        if (my_data.verbosity > 10)
+        {
+          for (auto &hit : phibins)
+          {
+            std::cout << " m_phi(" << hit.first << " : " << hit.second << ") "
+                      << std::endl;
+          }
+        }
+        my_data.cluskey_ClusHitsVerbose.push_back(ckey);
+        my_data.phivec_ClusHitsVerbose.push_back(phibins);
+        my_data.zvec_ClusHitsVerbose.push_back(zbins);
+      }
+
+      // This is the local position
+      const double locclusx = locxsum / nhits;
+      const double locclusz = loczsum / nhits;
+
+      const double phisize = phibins.size() * pitch;
+      const double zsize = zbins.size() * length;
+
+      static const double invsqrt12 = 1. / std::sqrt(12);
+
+      // scale factors (phi direction)
+      /*
+        they corresponds to clusters of size (2,2), (2,3), (3,2) and (3,3) in
+        phi and z
+        other clusters, which are very few and pathological, get a scale factor
+        of 1
+        These scale factors are applied to produce cluster pulls with width
+        unity
+      */
+
+      double phierror = pitch * invsqrt12;
+
+      static constexpr std::array<double, 7> scalefactors_phi = {
+          {0.36, 0.6, 0.37, 0.49, 0.4, 0.37, 0.33}};
+
+      if ((phibins.size() == 1 && zbins.size() == 1) ||
+          (phibins.size() == 2 && zbins.size() == 2))
+      {
+        phierror *= scalefactors_phi[0];
+      }
+      else if ((phibins.size() == 2 && zbins.size() == 1) ||
+               (phibins.size() == 2 && zbins.size() == 3))
+      {
+        phierror *= scalefactors_phi[1];
+      }
+      else if ((phibins.size() == 1 && zbins.size() == 2) ||
+               (phibins.size() == 3 && zbins.size() == 2))
+      {
+        phierror *= scalefactors_phi[2];
+      }
+      else if (phibins.size() == 3 && zbins.size() == 3)
+      {
+        phierror *= scalefactors_phi[3];
+      }
+
+      // scale factors (z direction)
+      /*
+        they corresponds to clusters of size (2,2), (2,3), (3,2) and (3,3) in z
+        and phi
+        other clusters, which are very few and pathological, get a scale factor
+        of 1
+      */
+      static constexpr std::array<double, 4> scalefactors_z = {
+          {0.47, 0.48, 0.71, 0.55}};
+      double zerror = length * invsqrt12;
+      if (zbins.size() == 2 && phibins.size() == 2)
+      {
+        zerror *= scalefactors_z[0];
+      }
+      else if (zbins.size() == 2 && phibins.size() == 3)
+      {
+        zerror *= scalefactors_z[1];
+      }
+      else if (zbins.size() == 3 && phibins.size() == 2)
+      {
+        zerror *= scalefactors_z[2];
+      }
+      else if (zbins.size() == 3 && phibins.size() == 3)
+      {
+        zerror *= scalefactors_z[3];
+      }
+
+      if (my_data.verbosity > 0)
+      {
+        std::cout << " MvtxClusterizer: cluskey " << ckey << " layer " << TrkrDefs::getLayer(ckey)
+                  << " rad " << layergeom->get_radius() << " phibins "
+                  << phibins.size() << " pitch " << pitch << " phisize " << phisize
+                  << " zbins " << zbins.size() << " length " << length << " zsize "
+                  << zsize << " local x " << locclusx << " local y " << locclusz
+                  << std::endl;
+      }
+
+      if (zbins.size() > 127)
       {
-        return true;
+        continue;
       }
+
+      auto clus = new TrkrClusterv5;
+      clus->setAdc(nhits);
+      clus->setMaxAdc(1);
+      clus->setLocalX(locclusx);
+      clus->setLocalY(locclusz);
+      clus->setPhiError(phierror);
+      clus->setZError(zerror);
+      clus->setPhiSize(phibins.size());
+      clus->setZSize(zbins.size());
+      // All silicon surfaces have a 1-1 map to hitsetkey.
+      // So set subsurface key to 0
+      clus->setSubSurfKey(0);
+
+      if (my_data.verbosity > 2)
+      {
+        clus->identify();
+      }
+
+      my_data.cluster_vector.emplace_back(ckey, clus);
     }
   }
-  else
+
+  /// cluster all chips (hitsets) of a given stave
+  void ProcessStaveData(thread_data *my_data)
   {
-    if (fabs(MvtxDefs::getCol(lhs.first) - MvtxDefs::getCol(rhs.first)) == 0)
+    for (const auto &hitset : my_data->hitsets)
     {
-      if (fabs(MvtxDefs::getRow(lhs.first) - MvtxDefs::getRow(rhs.first)) <=
-          1)
+      my_data->hits.clear();
+      TrkrHitSet::ConstRange hitrangei = hitset->getHits();
+      for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
+           hitr != hitrangei.second; ++hitr)
       {
-        return true;
+        pixel_hit &hit = my_data->hits.emplace_back();
+        hit.col = MvtxDefs::getCol(hitr->first);
+        hit.row = MvtxDefs::getRow(hitr->first);
+        hit.hitkey = hitr->first;
+        hit.adc = hitr->second->getAdc();
       }
-    }
-  }
 
-  return false;
-}
+      if (my_data->verbosity > 2)
+      {
+        std::cout << "hitvec.size(): " << my_data->hits.size() << std::endl;
+      }
 
-bool MvtxClusterizer::are_adjacent(RawHit *lhs, RawHit *rhs)
-{
-  if (GetZClustering())
-  {
-    // column is first, row is second
-    if (fabs(lhs->getPhiBin() - rhs->getPhiBin()) <= 1)  // col
+      make_clusters(*my_data, hitset->getHitSetKey());
+    }
+
+    for (const auto &hitset : my_data->rawhitsets)
     {
-      if (fabs(lhs->getTBin() - rhs->getTBin()) <= 1)  // Row
+      my_data->hits.clear();
+      RawHitSet::ConstRange hitrangei = hitset->getHits();
+      for (RawHitSet::ConstIterator hitr = hitrangei.first;
+           hitr != hitrangei.second; ++hitr)
       {
-        return true;
+        pixel_hit &hit = my_data->hits.emplace_back();
+        hit.col = (*hitr)->getPhiBin();
+        hit.row = (*hitr)->getTBin();
       }
+
+      if (my_data->verbosity > 2)
+      {
+        std::cout << "hitvec.size(): " << my_data->hits.size() << std::endl;
+      }
+
+      make_clusters(*my_data, hitset->getHitSetKey());
     }
   }
-  else
+
+  /// copy thread output to the node tree
+  void copy_output(const thread_data &data, TrkrClusterContainer *clusterlist, TrkrClusterHitAssoc *clusterhitassoc, ClusHitsVerbose *clushitsverbose)
   {
-    if (fabs(lhs->getPhiBin() - rhs->getPhiBin()) == 0)
+    for (const auto &[ckey, cluster] : data.cluster_vector)
     {
-      if (fabs(lhs->getTBin() - rhs->getTBin()) <= 1)
+      clusterlist->addClusterSpecifyKey(ckey, cluster);
+    }
+
+    for (const auto &[ckey, hkey] : data.association_vector)
+    {
+      clusterhitassoc->addAssoc(ckey, hkey);
+    }
+
+    if (clushitsverbose)
+    {
+      for (unsigned int index = 0; index < data.cluskey_ClusHitsVerbose.size(); ++index)
       {
-        return true;
+        for (const auto &hit : data.phivec_ClusHitsVerbose[index])
+        {
+          clushitsverbose->addPhiHit(hit.first, hit.second);
+        }
+        for (const auto &hit : data.zvec_ClusHitsVerbose[index])
+        {
+          clushitsverbose->addZHit(hit.first, hit.second);
+        }
+        clushitsverbose->push_hits(data.cluskey_ClusHitsVerbose[index]);
       }
     }
   }
 
-  return false;
-}
+}  // namespace
 
 MvtxClusterizer::MvtxClusterizer(const string &name)
   : SubsysReco(name)
@@ -229,6 +463,20 @@ int MvtxClusterizer::InitRun(PHCompositeNode *topNode)
     }
   }
 
+  //----------------
+  // Declare Nodes
+  //----------------
+
+  // lets Fun4AllServer run this module concurrently with modules using other nodes
+  DeclareInputNode(do_read_raw ? "TRKR_RAWHITSET" : "TRKR_HITSET");
+  DeclareInputNode("CYLINDERGEOM_MVTX");
+  DeclareOutputNode("TRKR_CLUSTER");
+  DeclareOutputNode("TRKR_CLUSTERHITASSOC");
+  if (record_ClusHitsVerbose)
+  {
+    DeclareOutputNode("Trkr_SvtxClusHitsVerbose");
+  }
+
   //----------------
   // Report Settings
   //----------------
@@ -324,18 +572,20 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
   // Clustering
   //-----------
 
-  // loop over each MvtxHitSet object (chip)
+  // group MvtxHitSet objects (chips) per stave.
+  // hitsets are sorted by layer, then stave, so that chips of a given stave are contiguous
+  std::vector<thread_data> staves;
   TrkrHitSetContainer::ConstRange hitsetrange =
       m_hits->getHitSets(TrkrDefs::TrkrId::mvtxId);
   for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
        hitsetitr != hitsetrange.second; ++hitsetitr)
   {
     TrkrHitSet *hitset = hitsetitr->second;
+    unsigned int layer = TrkrDefs::getLayer(hitsetitr->first);
+    unsigned int stave = MvtxDefs::getStaveId(hitsetitr->first);
 
     if (Verbosity() > 0)
     {
-      unsigned int layer = TrkrDefs::getLayer(hitsetitr->first);
-      unsigned int stave = MvtxDefs::getStaveId(hitsetitr->first);
       unsigned int chip = MvtxDefs::getChipId(hitsetitr->first);
       unsigned int strobe = MvtxDefs::getStrobeId(hitsetitr->first);
       cout << "MvtxClusterizer found hitsetkey " << hitsetitr->first
@@ -348,98 +598,9 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
       hitset->identify();
     }
 
-    // fill a vector of hits to make things easier
-    std::vector<std::pair<TrkrDefs::hitkey, TrkrHit *> > hitvec;
-
-    TrkrHitSet::ConstRange hitrangei = hitset->getHits();
-    for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
-         hitr != hitrangei.second; ++hitr)
-    {
-      hitvec.emplace_back(hitr->first, hitr->second);
-    }
-    if (Verbosity() > 2)
-    {
-      cout << "hitvec.size(): " << hitvec.size() << endl;
-    }
-
-    if (Verbosity() > 0)
-    {
-      for (auto &hit : hitvec)
-      {
-        auto hitkey = hit.first;
-        auto row = MvtxDefs::getRow(hitkey);
-        auto col = MvtxDefs::getCol(hitkey);
-        std::cout << "      hitkey " << hitkey << " row " << row << " col "
-                  << col << std::endl;
-      }
-    }
-
-    // do the clustering
-    using Graph = adjacency_list<vecS, vecS, undirectedS>;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
-    {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-        {
-          add_edge(i, j, G);
-        }
-      }
-    }
-
-    // Find the connections between the vertices of the graph (vertices are the
-    // rawhits,
-    // connections are made when they are adjacent to one another)
-    vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
-
-    // Loop over the components(hits) compiling a list of the
-    // unique connected groups (ie. clusters).
-    set<int> cluster_ids;  // unique components
-    // multimap<int, pixel> clusters;
-    multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit *> > clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
+    if (staves.empty() || staves.back().layer != layer || staves.back().stave != stave)
     {
-      cluster_ids.insert(component[i]);
-      clusters.insert(make_pair(component[i], hitvec[i]));
-    }
-    int total_clusters = 0;
-    for (set<int>::iterator clusiter = cluster_ids.begin();
-         clusiter != cluster_ids.end(); ++clusiter)
-    {
-      int clusid = *clusiter;
-      auto clusrange = clusters.equal_range(clusid);
-
-      if (Verbosity() > 2)
-      {
-        cout << "Filling cluster id " << clusid << " of "
-             << std::distance(cluster_ids.begin(), clusiter) << endl;
-      }
-      ++total_clusters;
-      auto ckey = TrkrDefs::genClusKey(hitset->getHitSetKey(), clusid);
-
-      // determine the size of the cluster in phi and z
-      set<int> phibins;
-      set<int> zbins;
-      std::map<int, unsigned int> m_phi,
-          m_z;  // Note, there are no "cut" bins for Svtx Clusters
-
-      // determine the cluster position...
-      double locxsum = 0.;
-      double loczsum = 0.;
-      const unsigned int nhits =
-          std::distance(clusrange.first, clusrange.second);
-
-      double locclusx = NAN;
-      double locclusz = NAN;
-
       // we need the geometry object for this layer to get the global positions
-      int layer = TrkrDefs::getLayer(ckey);
       auto layergeom = dynamic_cast<CylinderGeom_Mvtx *>(
           geom_container->GetLayerGeom(layer));
       if (!layergeom)
@@ -447,180 +608,27 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
         exit(1);
       }
 
-      for (auto mapiter = clusrange.first; mapiter != clusrange.second;
-           ++mapiter)
-      {
-        // size
-        const auto energy = (mapiter->second).second->getAdc();
-        int col = MvtxDefs::getCol((mapiter->second).first);
-        int row = MvtxDefs::getRow((mapiter->second).first);
-        zbins.insert(col);
-        phibins.insert(row);
-
-        if (mClusHitsVerbose)
-        {
-          auto pnew = m_phi.try_emplace(row, energy);
-          if (!pnew.second)
-          {
-            pnew.first->second += energy;
-          }
-
-          pnew = m_z.try_emplace(col, energy);
-          if (!pnew.second)
-          {
-            pnew.first->second += energy;
-          }
-        }
-
-        // get local coordinates, in stae reference frame, for hit
-        auto local_coords = layergeom->get_local_coords_from_pixel(row, col);
-
-        /*
-          manually offset position along y (thickness of the sensor),
-          to account for effective hit position in the sensor, resulting from
-          diffusion.
-          Effective position corresponds to 1um above the middle of the sensor
-        */
-        local_coords.SetY(1e-4);
-
-        // update cluster position
-        locxsum += local_coords.X();
-        loczsum += local_coords.Z();
-        // add the association between this cluster key and this hitkey to the
-        // table
-        m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
-
-      }  // mapiter
-
-      if (mClusHitsVerbose)
-      {
-        if (Verbosity() > 10)
-        {
-          for (auto &hit : m_phi)
-          {
-            std::cout << " m_phi(" << hit.first << " : " << hit.second << ") "
-                      << std::endl;
-          }
-        }
-        for (auto &hit : m_phi)
-        {
-          mClusHitsVerbose->addPhiHit(hit.first, (float) hit.second);
-        }
-        for (auto &hit : m_z)
-        {
-          mClusHitsVerbose->addZHit(hit.first, (float) hit.second);
-        }
-        mClusHitsVerbose->push_hits(ckey);
-      }
-
-      // This is the local position
-      locclusx = locxsum / nhits;
-      locclusz = loczsum / nhits;
-
-      const double pitch = layergeom->get_pixel_x();
-      const double length = layergeom->get_pixel_z();
-      const double phisize = phibins.size() * pitch;
-      const double zsize = zbins.size() * length;
-
-      static const double invsqrt12 = 1. / std::sqrt(12);
-
-      // scale factors (phi direction)
-      /*
-        they corresponds to clusters of size (2,2), (2,3), (3,2) and (3,3) in
-        phi and z
-        other clusters, which are very few and pathological, get a scale factor
-        of 1
-        These scale factors are applied to produce cluster pulls with width
-        unity
-      */
-
-      double phierror = pitch * invsqrt12;
-
-      static constexpr std::array<double, 7> scalefactors_phi = {
-          {0.36, 0.6, 0.37, 0.49, 0.4, 0.37, 0.33}};
-
-      if ((phibins.size() == 1 && zbins.size() == 1) ||
-          (phibins.size() == 2 && zbins.size() == 2))
-      {
-        phierror *= scalefactors_phi[0];
-      }
-      else if ((phibins.size() == 2 && zbins.size() == 1) ||
-               (phibins.size() == 2 && zbins.size() == 3))
-      {
-        phierror *= scalefactors_phi[1];
-      }
-      else if ((phibins.size() == 1 && zbins.size() == 2) ||
-               (phibins.size() == 3 && zbins.size() == 2))
-      {
-        phierror *= scalefactors_phi[2];
-      }
-      else if (phibins.size() == 3 && zbins.size() == 3)
-      {
-        phierror *= scalefactors_phi[3];
-      }
-
-      // scale factors (z direction)
-      /*
-        they corresponds to clusters of size (2,2), (2,3), (3,2) and (3,3) in z
-        and phi
-        other clusters, which are very few and pathological, get a scale factor
-        of 1
-      */
-      static constexpr std::array<double, 4> scalefactors_z = {
-          {0.47, 0.48, 0.71, 0.55}};
-      double zerror = length * invsqrt12;
-      if (zbins.size() == 2 && phibins.size() == 2)
-      {
-        zerror *= scalefactors_z[0];
-      }
-      else if (zbins.size() == 2 && phibins.size() == 3)
-      {
-        zerror *= scalefactors_z[1];
-      }
-      else if (zbins.size() == 3 && phibins.size() == 2)
-      {
-        zerror *= scalefactors_z[2];
-      }
-      else if (zbins.size() == 3 && phibins.size() == 3)
-      {
-        zerror *= scalefactors_z[3];
-      }
-
-      if (Verbosity() > 0)
-      {
-        cout << " MvtxClusterizer: cluskey " << ckey << " layer " << layer
-             << " rad " << layergeom->get_radius() << " phibins "
-             << phibins.size() << " pitch " << pitch << " phisize " << phisize
-             << " zbins " << zbins.size() << " length " << length << " zsize "
-             << zsize << " local x " << locclusx << " local y " << locclusz
-             << endl;
-      }
-
-      auto clus = std::make_unique<TrkrClusterv5>();
-      clus->setAdc(nhits);
-      clus->setMaxAdc(1);
-      clus->setLocalX(locclusx);
-      clus->setLocalY(locclusz);
-      clus->setPhiError(phierror);
-      clus->setZError(zerror);
-      clus->setPhiSize(phibins.size());
-      clus->setZSize(zbins.size());
-      // All silicon surfaces have a 1-1 map to hitsetkey.
-      // So set subsurface key to 0
-      clus->setSubSurfKey(0);
+      auto &data = staves.emplace_back();
+      data.layergeom = layergeom;
+      data.layer = layer;
+      data.stave = stave;
+      data.make_z_clustering = m_makeZClustering;
+      data.do_assoc = true;
+      data.fillClusHitsVerbose = (mClusHitsVerbose != nullptr);
+      data.verbosity = Verbosity();
+    }
 
-      if (Verbosity() > 2)
-      {
-        clus->identify();
-      }
+    staves.back().hitsets.push_back(hitset);
+  }
 
-      if (zbins.size() <= 127)
-      {
-        m_clusterlist->addClusterSpecifyKey(ckey, clus.release());
-      }
+  // do the clustering
+  ClusterizerTools::process_modules(staves, ProcessStaveData, do_sequential);
 
-    }  // clusitr loop
-  }    // loop over hitsets
+  // copy clusters and associations to the node tree, in hitset order
+  for (const auto &data : staves)
+  {
+    copy_output(data, m_clusterlist, m_clusterhitassoc, mClusHitsVerbose);
+  }
 
   if (Verbosity() > 1)
   {
@@ -650,18 +658,20 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
   // Clustering
   //-----------
 
-  // loop over each MvtxHitSet object (chip)
+  // group MvtxHitSet objects (chips) per stave.
+  // hitsets are sorted by layer, then stave, so that chips of a given stave are contiguous
+  std::vector<thread_data> staves;
   RawHitSetContainer::ConstRange hitsetrange =
       m_rawhits->getHitSets(TrkrDefs::TrkrId::mvtxId);
   for (RawHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
        hitsetitr != hitsetrange.second; ++hitsetitr)
   {
     RawHitSet *hitset = hitsetitr->second;
+    unsigned int layer = TrkrDefs::getLayer(hitsetitr->first);
+    unsigned int stave = MvtxDefs::getStaveId(hitsetitr->first);
 
     if (Verbosity() > 0)
     {
-      unsigned int layer = TrkrDefs::getLayer(hitsetitr->first);
-      unsigned int stave = MvtxDefs::getStaveId(hitsetitr->first);
       unsigned int chip = MvtxDefs::getChipId(hitsetitr->first);
       unsigned int strobe = MvtxDefs::getStrobeId(hitsetitr->first);
       cout << "MvtxClusterizer found hitsetkey " << hitsetitr->first
@@ -674,87 +684,9 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
       hitset->identify();
     }
 
-    // fill a vector of hits to make things easier
-    std::vector<RawHit *> hitvec;
-
-    RawHitSet::ConstRange hitrangei = hitset->getHits();
-    for (RawHitSet::ConstIterator hitr = hitrangei.first;
-         hitr != hitrangei.second; ++hitr)
-    {
-      hitvec.push_back((*hitr));
-    }
-    if (Verbosity() > 2)
-    {
-      cout << "hitvec.size(): " << hitvec.size() << endl;
-    }
-
-    // do the clustering
-    using Graph = adjacency_list<vecS, vecS, undirectedS>;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    if (staves.empty() || staves.back().layer != layer || staves.back().stave != stave)
     {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-        {
-          add_edge(i, j, G);
-        }
-      }
-    }
-
-    // Find the connections between the vertices of the graph (vertices are the
-    // rawhits,
-    // connections are made when they are adjacent to one another)
-    vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
-
-    // Loop over the components(hits) compiling a list of the
-    // unique connected groups (ie. clusters).
-    set<int> cluster_ids;  // unique components
-    // multimap<int, pixel> clusters;
-
-    multimap<int, RawHit *> clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
-    {
-      cluster_ids.insert(component[i]);
-      clusters.insert(make_pair(component[i], hitvec[i]));
-    }
-    //    cout << "found cluster #: "<< clusters.size()<< endl;
-    // loop over the componenets and make clusters
-    for (set<int>::iterator clusiter = cluster_ids.begin();
-         clusiter != cluster_ids.end(); ++clusiter)
-    {
-      int clusid = *clusiter;
-      auto clusrange = clusters.equal_range(clusid);
-
-      if (Verbosity() > 2)
-      {
-        cout << "Filling cluster id " << clusid << " of "
-             << std::distance(cluster_ids.begin(), clusiter) << endl;
-      }
-
-      // make the cluster directly in the node tree
-      auto ckey = TrkrDefs::genClusKey(hitset->getHitSetKey(), clusid);
-
-      // determine the size of the cluster in phi and z
-      set<int> phibins;
-      set<int> zbins;
-
-      // determine the cluster position...
-      double locxsum = 0.;
-      double loczsum = 0.;
-      const unsigned int nhits =
-          std::distance(clusrange.first, clusrange.second);
-
-      double locclusx = NAN;
-      double locclusz = NAN;
-
       // we need the geometry object for this layer to get the global positions
-      int layer = TrkrDefs::getLayer(ckey);
       auto layergeom = dynamic_cast<CylinderGeom_Mvtx *>(
           geom_container->GetLayerGeom(layer));
       if (!layergeom)
@@ -762,144 +694,27 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
         exit(1);
       }
 
-      for (auto mapiter = clusrange.first; mapiter != clusrange.second;
-           ++mapiter)
-      {
-        // size
-        int col = (mapiter->second)->getPhiBin();
-        int row = (mapiter->second)->getTBin();
-        zbins.insert(col);
-        phibins.insert(row);
-
-        // get local coordinates, in stae reference frame, for hit
-        auto local_coords = layergeom->get_local_coords_from_pixel(row, col);
-
-        /*
-          manually offset position along y (thickness of the sensor),
-          to account for effective hit position in the sensor, resulting from
-          diffusion.
-          Effective position corresponds to 1um above the middle of the sensor
-        */
-        local_coords.SetY(1e-4);
-
-        // update cluster position
-        locxsum += local_coords.X();
-        loczsum += local_coords.Z();
-        // add the association between this cluster key and this hitkey to the
-        // table
-        //	      m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
-
-      }  // mapiter
-
-      // This is the local position
-      locclusx = locxsum / nhits;
-      locclusz = loczsum / nhits;
-
-      const double pitch = layergeom->get_pixel_x();
-      //	std::cout << " pitch: " <<  pitch << std::endl;
-      const double length = layergeom->get_pixel_z();
-      //	std::cout << " length: " << length << std::endl;
-      const double phisize = phibins.size() * pitch;
-      const double zsize = zbins.size() * length;
-
-      static const double invsqrt12 = 1. / std::sqrt(12);
-
-      // scale factors (phi direction)
-      /*
-        they corresponds to clusters of size (2,2), (2,3), (3,2) and (3,3) in
-        phi and z
-        other clusters, which are very few and pathological, get a scale factor
-        of 1
-        These scale factors are applied to produce cluster pulls with width
-        unity
-      */
-
-      double phierror = pitch * invsqrt12;
-
-      static constexpr std::array<double, 7> scalefactors_phi = {
-          {0.36, 0.6, 0.37, 0.49, 0.4, 0.37, 0.33}};
-      if ((phibins.size() == 1 && zbins.size() == 1) ||
-          (phibins.size() == 2 && zbins.size() == 2))
-      {
-        phierror *= scalefactors_phi[0];
-      }
-      else if ((phibins.size() == 2 && zbins.size() == 1) ||
-               (phibins.size() == 2 && zbins.size() == 3))
-      {
-        phierror *= scalefactors_phi[1];
-      }
-      else if ((phibins.size() == 1 && zbins.size() == 2) ||
-               (phibins.size() == 3 && zbins.size() == 2))
-      {
-        phierror *= scalefactors_phi[2];
-      }
-      else if (phibins.size() == 3 && zbins.size() == 3)
-      {
-        phierror *= scalefactors_phi[3];
-      }
-
-      // scale factors (z direction)
-      /*
-        they corresponds to clusters of size (2,2), (2,3), (3,2) and (3,3) in z
-        and phi
-        other clusters, which are very few and pathological, get a scale factor
-        of 1
-      */
-      static constexpr std::array<double, 4> scalefactors_z = {
-          {0.47, 0.48, 0.71, 0.55}};
-      double zerror = length * invsqrt12;
-
-      if (zbins.size() == 2 && phibins.size() == 2)
-      {
-        zerror *= scalefactors_z[0];
-      }
-      else if (zbins.size() == 2 && phibins.size() == 3)
-      {
-        zerror *= scalefactors_z[1];
-      }
-      else if (zbins.size() == 3 && phibins.size() == 2)
-      {
-        zerror *= scalefactors_z[2];
-      }
-      else if (zbins.size() == 3 && phibins.size() == 3)
-      {
-        zerror *= scalefactors_z[3];
-      }
-
-      if (Verbosity() > 0)
-      {
-        cout << " MvtxClusterizer: cluskey " << ckey << " layer " << layer
-             << " rad " << layergeom->get_radius() << " phibins "
-             << phibins.size() << " pitch " << pitch << " phisize " << phisize
-             << " zbins " << zbins.size() << " length " << length << " zsize "
-             << zsize << " local x " << locclusx << " local y " << locclusz
-             << endl;
-      }
+      auto &data = staves.emplace_back();
+      data.layergeom = layergeom;
+      data.layer = layer;
+      data.stave = stave;
+      data.make_z_clustering = m_makeZClustering;
+      data.do_assoc = false;
+      data.fillClusHitsVerbose = false;
+      data.verbosity = Verbosity();
+    }
 
-      auto clus = std::make_unique<TrkrClusterv5>();
-      clus->setAdc(nhits);
-      clus->setMaxAdc(1);
-      clus->setLocalX(locclusx);
-      clus->setLocalY(locclusz);
-      clus->setPhiError(phierror);
-      clus->setZError(zerror);
-      clus->setPhiSize(phibins.size());
-      clus->setZSize(zbins.size());
-      // All silicon surfaces have a 1-1 map to hitsetkey.
-      // So set subsurface key to 0
-      clus->setSubSurfKey(0);
+    staves.back().rawhitsets.push_back(hitset);
+  }
 
-      if (Verbosity() > 2)
-      {
-        clus->identify();
-      }
+  // do the clustering
+  ClusterizerTools::process_modules(staves, ProcessStaveData, do_sequential);
 
-      if (zbins.size() <= 127)
-      {
-        m_clusterlist->addClusterSpecifyKey(ckey, clus.release());
-      }
-    }  // clusitr loop
-  }    // loop over hitsets
+  // copy clusters to the node tree, in hitset order
+  for (const auto &data : staves)
+  {
+    copy_output(data, m_clusterlist, m_clusterhitassoc, nullptr);
+  }
 
   if (Verbosity() > 1)
   {
@@ -60,13 +60,13 @@ class MvtxClusterizer : public SubsysReco
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
   void set_read_raw(bool read_raw) { do_read_raw = read_raw; }
   void set_ClusHitsVerbose(bool set = true) { record_ClusHitsVerbose = set; };
+
+  //! process staves sequentially instead of one thread per stave
+  void set_do_sequential(bool do_seq) { do_sequential = do_seq; }
   ClusHitsVerbose *mClusHitsVerbose{nullptr};
 
  private:
-  // bool are_adjacent(const pixel lhs, const pixel rhs);
   bool record_ClusHitsVerbose{false};
-  bool are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit *> &lhs, const std::pair<TrkrDefs::hitkey, TrkrHit *> &rhs);
-  bool are_adjacent(RawHit *lhs, RawHit *rhs);
 
   void ClusterMvtx(PHCompositeNode *topNode);
   void ClusterMvtxRaw(PHCompositeNode *topNode);
@@ -83,6 +83,7 @@ class MvtxClusterizer : public SubsysReco
   bool m_makeZClustering;  // z_clustering_option
   bool do_hit_assoc = true;
   bool do_read_raw = false;
+  bool do_sequential = false;
 };
 
 #endif  // MVTX_MVTXCLUSTERIZER_H
@@ -9,8 +9,8 @@
 #include <calobase/RawCluster.h>
 #include <calobase/RawClusterContainer.h>
 #include <calobase/RawClusterUtility.h>
-#include <calobase/RawTowerGeom.h>
 #include <calobase/RawTowerGeomContainer.h>
+#include <calobase/RawTowerGeomTable.h>
 
 #include <trackbase_historic/SvtxTrack.h>
 #include <trackbase_historic/SvtxTrackMap.h>
@@ -103,6 +103,11 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
     return Fun4AllReturnCodes::ABORTEVENT;
   }
 
+  // dense copies of the geometry for the per tower lookups
+  RawTowerGeomTable *geomtableEM = RawTowerGeomTable::GetTable(topNode, "TOWERGEOM_CEMC");
+  RawTowerGeomTable *geomtableIH = RawTowerGeomTable::GetTable(topNode, "TOWERGEOM_HCALIN");
+  RawTowerGeomTable *geomtableOH = RawTowerGeomTable::GetTable(topNode, "TOWERGEOM_HCALOUT");
+
   // read in clusters
   RawClusterContainer *clustersEM = findNode::getClass<RawClusterContainer>(topNode, "TOPOCLUSTER_EMCAL");
   RawClusterContainer *clustersHAD = findNode::getClass<RawClusterContainer>(topNode, "TOPOCLUSTER_HCAL");
@@ -271,10 +276,15 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
       {
         if (RawTowerDefs::decode_caloid(iter->first) == RawTowerDefs::CalorimeterId::CEMC)
         {
-          RawTowerGeom *tower_geom = geomEM->get_tower_geometry(iter->first);
+          const unsigned int itower = geomtableEM->index_of_key(iter->first);
+          if (!geomtableEM->has_tower(itower))
+          {
+            // no geometry for this tower
+            continue;
+          }
 
-          this_cluster_tower_phi.push_back(tower_geom->get_phi());
-          this_cluster_tower_eta.push_back(tower_geom->get_eta());
+          this_cluster_tower_phi.push_back(geomtableEM->get_phi(itower));
+          this_cluster_tower_eta.push_back(geomtableEM->get_eta(itower));
         }
         else
         {
@@ -332,18 +342,28 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
       {
         if (RawTowerDefs::decode_caloid(iter->first) == RawTowerDefs::CalorimeterId::HCALIN)
         {
-          RawTowerGeom *tower_geom = geomIH->get_tower_geometry(iter->first);
+          const unsigned int itower = geomtableIH->index_of_key(iter->first);
+          if (!geomtableIH->has_tower(itower))
+          {
+            // no geometry for this tower
+            continue;
+          }
 
-          this_cluster_tower_phi.push_back(tower_geom->get_phi());
-          this_cluster_tower_eta.push_back(tower_geom->get_eta());
+          this_cluster_tower_phi.push_back(geomtableIH->get_phi(itower));
+          this_cluster_tower_eta.push_back(geomtableIH->get_eta(itower));
         }
 
         else if (RawTowerDefs::decode_caloid(iter->first) == RawTowerDefs::CalorimeterId::HCALOUT)
         {
-          RawTowerGeom *tower_geom = geomOH->get_tower_geometry(iter->first);
+          const unsigned int itower = geomtableOH->index_of_key(iter->first);
+          if (!geomtableOH->has_tower(itower))
+          {
+            // no geometry for this tower
+            continue;
+          }
 
-          this_cluster_tower_phi.push_back(tower_geom->get_phi());
-          this_cluster_tower_eta.push_back(tower_geom->get_eta());
+          this_cluster_tower_phi.push_back(geomtableOH->get_phi(itower));
+          this_cluster_tower_eta.push_back(geomtableOH->get_eta(itower));
         }
         else
         {
@@ -1164,6 +1164,18 @@ int TpcClusterizer::InitRun(PHCompositeNode *topNode)
     }
   }
 
+  // lets Fun4AllServer run this module concurrently with modules using other nodes
+  DeclareInputNode(do_read_raw ? "TRKR_RAWHITSET" : "TRKR_HITSET");
+  DeclareInputNode("CYLINDERCELLGEOM_SVTX");
+  DeclareInputNode("ActsGeometry");
+  DeclareOutputNode("TRKR_CLUSTER");
+  DeclareOutputNode("TRKR_CLUSTERHITASSOC");
+  DeclareOutputNode("TRAINING_HITSET");
+  if (record_ClusHitsVerbose)
+  {
+    DeclareOutputNode("Trkr_SvtxClusHitsVerbose");
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -34,15 +34,94 @@
 #include <TNtuple.h>
 #include <TSystem.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>   // for exit
 #include <cstdlib>   // for exit
 #include <iostream>  // for operator<<, endl, bas...
+#include <limits>
 #include <map>       // for _Rb_tree_iterator
 #include <utility>
 
 #define dEBUG
 
+namespace
+{
+  /*
+   * pedestal and width of one waveform, same result as filling all non zero samples
+   * into a 251 bin histogram from -2 to 1002 and taking mean and rms of the bin centers
+   * within +-3 bins of the most populated bin, but without creating a TH1 for every waveform.
+   * Bins outside the histogram range are clamped to under/overflow like TH1::GetBinContent does
+   */
+  class PedestalEstimator
+  {
+   public:
+    void estimate(TpcRawHit* tpchit, uint16_t nsamples, float& pedestal, float& width)
+    {
+      m_counts.fill(0);
+      int nentries = 0;
+      uint16_t adcmin = std::numeric_limits<uint16_t>::max();
+      uint16_t adcmax = 0;
+      for (uint16_t s = 0; s < nsamples; s++)
+      {
+        uint16_t adc = tpchit->get_adc(s);
+        if (adc == 0)
+        {
+          continue;
+        }
+        nentries++;
+        int bin = std::min<int>(((adc + 2) / 4) + 1, nbins + 1);
+        m_counts[bin]++;
+        if (bin <= nbins)
+        {
+          adcmin = std::min(adcmin, adc);
+          adcmax = std::max(adcmax, adc);
+        }
+      }
+
+      int hmax = 0;
+      int hmaxbin = 0;
+      for (int nbin = 1; nbin <= nbins; nbin++)
+      {
+        if (m_counts[nbin] > hmax)
+        {
+          hmaxbin = nbin;
+          hmax = m_counts[nbin];
+        }
+      }
+
+      // the rms of the in range samples is zero if they all have the same value
+      if (adcmin >= adcmax || nentries == 0)
+      {
+        pedestal = center(std::max(hmaxbin, 1));
+        width = 999;
+        return;
+      }
+
+      double adc_sum = 0.0;
+      double ibin_sum = 0.0;
+      double ibin2_sum = 0.0;
+      for (int isum = -3; isum <= 3; isum++)
+      {
+        float val = m_counts[std::clamp(hmaxbin + isum, 0, nbins + 1)];
+        float bincenter = center(hmaxbin + isum);
+        ibin_sum += bincenter * val;
+        ibin2_sum += bincenter * bincenter * val;
+        adc_sum += val;
+      }
+      pedestal = ibin_sum / adc_sum;
+      width = sqrt(ibin2_sum / adc_sum - (pedestal * pedestal));
+    }
+
+   private:
+    static constexpr int nbins = 251;
+    static float center(int bin) { return (4 * bin) - 4; }
+
+    std::array<int, nbins + 2> m_counts{};  // 0: underflow, nbins + 1: overflow
+  };
+}  // namespace
+
 TpcCombinedRawDataUnpacker::TpcCombinedRawDataUnpacker(std::string const& name, std::string const& outF)
   : SubsysReco(name)
   , outfile_name(outF)
@@ -165,9 +244,54 @@ int TpcCombinedRawDataUnpacker::InitRun(PHCompositeNode* topNode)
     m_presampleShift = 0;
   }
 
+  // the geometry might change between runs
+  m_pad_table.clear();
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void TpcCombinedRawDataUnpacker::build_pad_table(PHG4TpcCylinderGeomContainer* geom_container)
+{
+  m_pad_table.assign(m_nsectors * m_nfees * m_nchannels, pad_info());
+  for (unsigned int fee = 0; fee < m_nfees; fee++)
+  {
+    int feeM = FEE_map[fee];
+    if (FEE_R[fee] == 2)
+    {
+      feeM += 6;
+    }
+    if (FEE_R[fee] == 3)
+    {
+      feeM += 14;
+    }
+    for (unsigned int channel = 0; channel < m_nchannels; channel++)
+    {
+      unsigned int key = 256 * (feeM) + channel;
+      int layer = m_cdbttree->GetIntValue(key, "layer", 0);  // not all channels are mapped
+      // antenna pads will be in 0 layer
+      if (layer <= 0)
+      {
+        continue;
+      }
+      double chanphi = m_cdbttree->GetDoubleValue(key, "phi");
+      PHG4TpcCylinderGeom* layergeom = geom_container->GetLayerCellGeom(layer);
+      for (unsigned int sector = 0; sector < m_nsectors; sector++)
+      {
+        int side = (sector > 11) ? 0 : 1;
+        double phi = -1 * pow(-1, side) * chanphi + (sector % 12) * M_PI / 6;
+        pad_info& pad = m_pad_table[(sector * m_nfees + fee) * m_nchannels + channel];
+        pad.layer = layer;
+        pad.phibin = layergeom->get_phibin(phi);
+        pad.hitsetkey = TpcDefs::genHitSetKey(layer, (mc_sectors[sector % 12]), side);
+      }
+    }
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << "TpcCombinedRawDataUnpacker::build_pad_table - filled " << m_pad_table.size() << " channels" << std::endl;
+  }
+}
+
 int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
 {
   if (_ievent < startevt || _ievent > endevt)
@@ -180,7 +304,7 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::DISCARDEVENT;
   }
   _ievent++;
-  TH1F pedhist("pedhist", "pedhist", 251, -2.0, 1002);
+  PedestalEstimator pedestal_estimator;
 
   TrkrHitSetContainer* trkr_hit_set_container = findNode::getClass<TrkrHitSetContainer>(topNode, "TRKR_HITSET");
   if (!trkr_hit_set_container)
@@ -215,6 +339,11 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
+  if (m_pad_table.empty())
+  {
+    build_pad_table(geom_container);
+  }
+
   TrkrDefs::hitsetkey hit_set_key = 0;
   TrkrDefs::hitkey hit_key = 0;
   TrkrHitSetContainer::Iterator hit_set_container_itr;
@@ -244,15 +373,6 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
 
     int fee = tpchit->get_fee();
     int channel = tpchit->get_channel();
-    int feeM = FEE_map[fee];
-    if (FEE_R[fee] == 2)
-    {
-      feeM += 6;
-    }
-    if (FEE_R[fee] == 3)
-    {
-      feeM += 14;
-    }
 
     int side = 1;
     int32_t packet_id = tpchit->get_packetid();
@@ -263,9 +383,13 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
       side = 0;
     }
 
-    unsigned int key = 256 * (feeM) + channel;
-    std::string varname = "layer";
-    int layer = m_cdbttree->GetIntValue(key, varname);
+    // the pad only depends on sector, fee and channel
+    if (sector < 0 || sector >= (int) m_nsectors || fee < 0 || fee >= (int) m_nfees || channel < 0 || channel >= (int) m_nchannels)
+    {
+      continue;
+    }
+    const pad_info& pad = m_pad_table[(sector * m_nfees + fee) * m_nchannels + channel];
+    int layer = pad.layer;
     // antenna pads will be in 0 layer
     if (layer <= 0)
     {
@@ -276,10 +400,7 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     uint16_t sampch = tpchit->get_sampachannel();
     uint16_t sam = tpchit->get_samples();
     max_time_range = sam;
-    varname = "phi";  // + std::to_string(key);
-    double phi = -1 * pow(-1, side) * m_cdbttree->GetDoubleValue(key, varname) + (sector % 12) * M_PI / 6;
-    PHG4TpcCylinderGeom* layergeom = geom_container->GetLayerCellGeom(layer);
-    unsigned int phibin = layergeom->get_phibin(phi);
+    unsigned int phibin = pad.phibin;
     if (m_writeTree)
     {
       float fX[12];
@@ -299,12 +420,11 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
       m_ntup->Fill(fX);
     }
 
-    hit_set_key = TpcDefs::genHitSetKey(layer, (mc_sectors[sector % 12]), side);
+    hit_set_key = pad.hitsetkey;
     hit_set_container_itr = trkr_hit_set_container->findOrAddHitSet(hit_set_key);
 
     float hpedestal = 0;
     float hpedwidth = 0;
-    pedhist.Reset();
 
     if (!m_do_zerosup)
     {
@@ -337,52 +457,7 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
       }
       TH2I* feehist = nullptr;
       if(!m_do_zs_emulation){
-	for (uint16_t sampleNum = 0; sampleNum < sam; sampleNum++)
-	  {
-	    uint16_t adc = tpchit->get_adc(sampleNum);
-	    if (adc > 0)
-	      {
-		pedhist.Fill(adc);
-	      }
-	  }
-	int hmax = 0;
-	int hmaxbin = 0;
-	for (int nbin = 1; nbin <= pedhist.GetNbinsX(); nbin++)
-	  {
-	    float val = pedhist.GetBinContent(nbin);
-	    if (val > hmax)
-	      {
-		hmaxbin = nbin;
-		hmax = val;
-	      }
-	  }
-	
-	// calculate pedestal mean and sigma
-	
-	if (pedhist.GetStdDev() == 0 || pedhist.GetEntries() == 0)
-	  {
-	    hpedestal = pedhist.GetBinCenter(pedhist.GetMaximumBin());
-	    hpedwidth = 999;
-	  }
-	else
-	  {
-	    // calc peak position
-	    double adc_sum = 0.0;
-	    double ibin_sum = 0.0;
-	    double ibin2_sum = 0.0;
-	    
-	    for (int isum = -3; isum <= 3; isum++)
-	      {
-		float val = pedhist.GetBinContent(hmaxbin + isum);
-		float center = pedhist.GetBinCenter(hmaxbin + isum);
-		ibin_sum += center * val;
-		ibin2_sum += center * center * val;
-		adc_sum += val;
-	      }
-	    
-	    hpedestal = ibin_sum / adc_sum;
-	    hpedwidth = sqrt(ibin2_sum / adc_sum - (hpedestal * hpedestal));
-	  }
+	pedestal_estimator.estimate(tpchit, sam, hpedestal, hpedwidth);
 	if (m_do_baseline_corr)
 	  {
 	    unsigned int pad_key = create_pad_key(side, layer, phibin);
@@ -5,12 +5,15 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <trackbase/TrkrDefs.h>
+
 #include <limits>
 #include <map>
 #include <string>
 #include <vector>
 
 class PHCompositeNode;
+class PHG4TpcCylinderGeomContainer;
 class CDBTTree;
 class CDBInterface;
 class TH2I;
@@ -89,6 +92,21 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
   }
 
  private:
+  //! pad of one FEE channel, from the CDB channel map and the TPC geometry
+  struct pad_info
+  {
+    int layer = 0;  // 0 for antenna pads and unmapped channels
+    unsigned int phibin = 0;
+    TrkrDefs::hitsetkey hitsetkey = 0;
+  };
+
+  static constexpr unsigned int m_nsectors = 24;
+  static constexpr unsigned int m_nfees = 26;
+  static constexpr unsigned int m_nchannels = 256;
+
+  //! fill the pad table for all (sector, fee, channel)
+  void build_pad_table(PHG4TpcCylinderGeomContainer *geom_container);
+
   TNtuple *m_ntup{nullptr};
   TNtuple *m_ntup_hits = nullptr;
   TNtuple *m_ntup_hits_corr = nullptr;
@@ -115,6 +133,7 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
   int m_zs_threshold{30};
   std::string m_TpcRawNodeName{"TPCRAWHIT"};
   std::string outfile_name;
+  std::vector<pad_info> m_pad_table;                           // (sector, fee, channel), built on the first event of a run
   std::map<unsigned int, chan_info> chan_map;                  // stays in place
   std::map<unsigned int, TH2I *> feeadc_map;                   // histos reset after each event
   std::map<unsigned int, std::vector<float>> feebaseline_map;  // cleared after each event
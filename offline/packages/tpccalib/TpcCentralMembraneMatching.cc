@@ -34,10 +34,13 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
+#include <numeric>
 #include <set>
 #include <string>
+#include <tuple>
 
 namespace
 {
@@ -77,35 +80,6 @@ namespace
     return out;
   }
 
-  /// normalize distortions based on the number of entries in each cell, as recorded in the m_hentries histogram
-  [[maybe_unused]] void normalize_distortions(TpcDistortionCorrectionContainer* dcc)
-  {
-    // loop over side
-    for (unsigned int i = 0; i < 2; ++i)
-    {
-      // loop over bins in entries
-      for (int ip = 0; ip < dcc->m_hentries[i]->GetNbinsX(); ++ip)
-      {
-        for (int ir = 0; ir < dcc->m_hentries[i]->GetNbinsY(); ++ir)
-        {
-          // count number of times a given cell was filled
-          const auto entries = dcc->m_hentries[i]->GetBinContent(ip + 1, ir + 1);
-          if (entries <= 1)
-          {
-            continue;
-          }
-
-          // normalize histograms
-          for (const auto& h : {dcc->m_hDRint[i], dcc->m_hDPint[i], dcc->m_hDZint[i]})
-          {
-            h->SetBinContent(ip + 1, ir + 1, h->GetBinContent(ip + 1, ir + 1) / entries);
-            h->SetBinError(ip + 1, ir + 1, h->GetBinError(ip + 1, ir + 1) / entries);
-          }
-        }
-      }
-    }
-  }
-
   /// fill distortion correction histograms' guarding bins, to allow ::Interpolate to work over the full acceptance
   [[maybe_unused]] void fill_guarding_bins(TpcDistortionCorrectionContainer* dcc)
   {
@@ -1251,6 +1225,10 @@ for (int j = 0; j < nRadii; ++j)
   }
 }
 
+// bucket index of the truth positions, per side
+m_truth_buckets[0].build(m_truth_pos, false);
+m_truth_buckets[1].build(m_truth_pos, true);
+
 int ret = GetNodes(topNode);
 return ret;
 }
@@ -1314,6 +1292,11 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
     }
   }
 
+  for (auto& sums : m_event_sums)
+  {
+    sums.reset(m_dcc_out->m_hentries[0]->GetNcells());
+  }
+
   reco_r_phi[0]->Reset();
   reco_r_phi[1]->Reset();
 
@@ -1705,6 +1688,7 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
   } //end fancy
   else
   {
+    std::vector<int> candidates;
     int reco_index = 0;
     for (const auto& reco : reco_pos)
     {
@@ -1712,43 +1696,37 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
       double rPhi = reco.Phi();
       bool side = reco_side[reco_index];
 
-      truth_index = 0;
+      // truth positions on the same side, within the (r, phi) window
+      candidates.clear();
+      m_truth_buckets[side ? 1 : 0].find(rR, rPhi, 5.0, 0.05, candidates);
+
       double minNNDist = 100000.0;
       int match_localTruth = -1;
-      for (const auto& truth : m_truth_pos)
+      for (const int candidate : candidates)
       {
-	//std::cout << "reco_index " << reco_index << "   truth_index " << truth_index << std::endl;
-	double tR = get_r(truth.X(), truth.Y());
+        const auto& truth = m_truth_pos[candidate];
+        double tR = get_r(truth.X(), truth.Y());
         double tPhi = truth.Phi();
-        double tZ = truth.Z();
-
-        if ((!side && tZ > 0) || (side && tZ < 0))
-        {
-          truth_index++;
-          continue;
-        }
 
         auto dR = fabs(tR - rR);
         if (dR > 5.0)
         {
-          truth_index++;
           continue;
         }
 
         auto dphi = delta_phi(tPhi - rPhi);
         if (fabs(dphi) > 0.05)
         {
-          truth_index++;
           continue;
         }
 
+        // candidates are not ordered, ties go to the lowest truth index
         double dist = sqrt(pow(truth.X() - reco.X(),2) + pow(truth.Y() - reco.Y(),2));
-        if (dist < minNNDist)
+        if (dist < minNNDist || (dist == minNNDist && candidate < match_localTruth))
         {
           minNNDist = dist;
-          match_localTruth = truth_index;
+          match_localTruth = candidate;
         }
-	truth_index++;
       } // end truth loop
 
       if(match_localTruth == -1)
@@ -1943,23 +1921,34 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
     const double rdphi = reco_pos[reco_index].Perp() * dphi;
     const double dz = reco_pos[reco_index].z() - m_truth_pos[i].z();
 
-    // fill distortion correction histograms
+    // accumulate distortions in the event and run sums, copied to the distortion correction histograms afterwards
     /*
      * TODO:
      * - we might need to only fill the histograms for cm clusters that have 2 clusters only
      * - we might need a smoothing procedure to fill the bins that have no entries using neighbors
      */
-    for (const auto& dcc : {m_dcc_out, m_dcc_out_aggregated.get()})
+    const int bin = m_dcc_out->m_hentries[side]->FindBin(clus_phi, clus_r);
+    for (auto sums : {&m_event_sums[side], &m_aggregated_sums[side]})
     {
-      static_cast<TH2*>(dcc->m_hDRint[side])->Fill(clus_phi, clus_r, dr);
-      static_cast<TH2*>(dcc->m_hDPint[side])->Fill(clus_phi, clus_r, rdphi);
-      static_cast<TH2*>(dcc->m_hDZint[side])->Fill(clus_phi, clus_r, dz);
-      static_cast<TH2*>(dcc->m_hentries[side])->Fill(clus_phi, clus_r);
+      sums->dr[bin] += dr;
+      sums->dr2[bin] += square(dr);
+      sums->dp[bin] += rdphi;
+      sums->dp2[bin] += square(rdphi);
+      sums->dz[bin] += dz;
+      sums->dz2[bin] += square(dz);
+      ++sums->entries[bin];
+      ++sums->nfills;
     }
 
     ckey++;
   }
 
+  // per-event distortion correction histograms, normalized
+  for (int side = 0; side < 2; ++side)
+  {
+    copy_distortion_sums(m_event_sums[side], m_dcc_out, side, true);
+  }
+
   if (Verbosity())
   {
     std::cout << "TpcCentralMembraneMatching::process_events - cmclusters: " << m_corrected_CMcluster_map->size() << std::endl;
@@ -1968,8 +1957,7 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
     std::cout << "TpcCentralMembraneMatching::process_events - entries: " << m_dcc_out->m_hentries[0]->GetEntries() << ", " << m_dcc_out->m_hentries[1]->GetEntries() << std::endl;
   }
 
-  // normalize per-event distortion correction histograms and fill guarding bins
-  normalize_distortions(m_dcc_out);
+  // fill guarding bins of the per-event distortion correction histograms
   fill_guarding_bins(m_dcc_out);
 
   if (Verbosity() > 2)
@@ -2005,10 +1993,10 @@ int TpcCentralMembraneMatching::End(PHCompositeNode* /*topNode*/)
   // write distortion corrections
   if (m_dcc_out_aggregated)
   {
-    // normalize aggregated distortion correction histograms and fill guarding bins
-    if(m_doHadd)
+    // copy aggregated distortions to histograms, normalize and fill guarding bins
+    for (int side = 0; side < 2; ++side)
     {
-      normalize_distortions(m_dcc_out_aggregated.get());
+      copy_distortion_sums(m_aggregated_sums[side], m_dcc_out_aggregated.get(), side, m_doHadd);
     }
     fill_guarding_bins(m_dcc_out_aggregated.get());
 
@@ -2270,6 +2258,17 @@ int TpcCentralMembraneMatching::GetNodes(PHCompositeNode* topNode)
     }
   }
 
+  // dense distortion sums, same cells as the histograms
+  const auto ncells = m_dcc_out->m_hentries[0]->GetNcells();
+  for (auto& sums : m_event_sums)
+  {
+    sums.reset(ncells);
+  }
+  for (auto& sums : m_aggregated_sums)
+  {
+    sums.reset(ncells);
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -2343,3 +2342,133 @@ void TpcCentralMembraneMatching::CalculateCenters(
     nGoodStripes[j] = i_out;
   }
 }
+
+//_____________________________________________________________
+void TpcCentralMembraneMatching::TruthBuckets::build(const std::vector<TVector3>& positions, bool positive_z)
+{
+  double rmax = 0;
+  for (const auto& pos : positions)
+  {
+    rmax = std::max(rmax, pos.Perp());
+  }
+  m_nr = static_cast<int>(rmax / m_rstep) + 1;
+  m_nphi = static_cast<int>(std::ceil(2. * M_PI / m_phistep_max));
+  m_phistep = 2. * M_PI / m_nphi;
+
+  auto get_bucket = [this](const TVector3& pos)
+  {
+    const int ir = static_cast<int>(pos.Perp() / m_rstep);
+    const int iphi = std::min(static_cast<int>((pos.Phi() + M_PI) / m_phistep), m_nphi - 1);
+    return ir * m_nphi + iphi;
+  };
+
+  // counting sort, keeps the truth indices ordered inside each bucket
+  m_offsets.assign(m_nr * m_nphi + 1, 0);
+  for (const auto& pos : positions)
+  {
+    if ((pos.Z() > 0) == positive_z)
+    {
+      ++m_offsets[get_bucket(pos) + 1];
+    }
+  }
+  std::partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+
+  m_indices.assign(m_offsets.back(), -1);
+  std::vector<unsigned int> next(m_offsets.begin(), m_offsets.end() - 1);
+  for (int i = 0; i < (int) positions.size(); ++i)
+  {
+    if ((positions[i].Z() > 0) == positive_z)
+    {
+      m_indices[next[get_bucket(positions[i])]++] = i;
+    }
+  }
+}
+
+//_____________________________________________________________
+void TpcCentralMembraneMatching::TruthBuckets::find(double r0, double phi0, double dr, double dphi, std::vector<int>& indices) const
+{
+  if (m_nr == 0)
+  {
+    return;
+  }
+
+  const int irmin = std::max(0, static_cast<int>(std::floor((r0 - dr) / m_rstep)));
+  const int irmax = std::min(m_nr - 1, static_cast<int>(std::floor((r0 + dr) / m_rstep)));
+
+  // phi buckets wrap around
+  const int iphimin = static_cast<int>(std::floor((phi0 - dphi + M_PI) / m_phistep));
+  const int iphimax = static_cast<int>(std::floor((phi0 + dphi + M_PI) / m_phistep));
+  const int nphi = std::min(iphimax - iphimin + 1, m_nphi);
+
+  for (int ir = irmin; ir <= irmax; ++ir)
+  {
+    for (int i = 0; i < nphi; ++i)
+    {
+      const int iphi = ((iphimin + i) % m_nphi + m_nphi) % m_nphi;
+      const int bucket = ir * m_nphi + iphi;
+      indices.insert(indices.end(), m_indices.begin() + m_offsets[bucket], m_indices.begin() + m_offsets[bucket + 1]);
+    }
+  }
+}
+
+//_____________________________________________________________
+void TpcCentralMembraneMatching::DistortionSums::reset(size_t ncells)
+{
+  for (auto v : {&dr, &dr2, &dp, &dp2, &dz, &dz2})
+  {
+    v->assign(ncells, 0);
+  }
+  entries.assign(ncells, 0);
+  nfills = 0;
+}
+
+//_____________________________________________________________
+void TpcCentralMembraneMatching::copy_distortion_sums(const DistortionSums& sums, TpcDistortionCorrectionContainer* dcc, int side, bool normalize) const
+{
+  TH1* hentries = dcc->m_hentries[side];
+  hentries->Reset();
+
+  // distortion histograms and their sums of values and squared values
+  const std::array<std::tuple<TH1*, const std::vector<double>*, const std::vector<double>*>, 3> histograms = {{
+    {dcc->m_hDRint[side], &sums.dr, &sums.dr2},
+    {dcc->m_hDPint[side], &sums.dp, &sums.dp2},
+    {dcc->m_hDZint[side], &sums.dz, &sums.dz2}
+  }};
+  for (const auto& entry : histograms)
+  {
+    TH1* h = std::get<0>(entry);
+    h->Reset();
+    if (h->GetSumw2N() == 0)
+    {
+      h->Sumw2();
+    }
+  }
+
+  const int ncells = std::min<int>(hentries->GetNcells(), sums.entries.size());
+  for (int bin = 0; bin < ncells; ++bin)
+  {
+    const auto entries = sums.entries[bin];
+    if (entries == 0)
+    {
+      continue;
+    }
+
+    hentries->SetBinContent(bin, entries);
+
+    // normalize cells filled more than once, same as weighted TH2::Fill followed by a division by the number of entries.
+    // Under and overflow cells are left as filled
+    const bool inside = !(hentries->IsBinUnderflow(bin) || hentries->IsBinOverflow(bin));
+    const double scale = (normalize && inside && entries > 1) ? 1. / entries : 1.;
+    for (const auto& [h, sum, sum2] : histograms)
+    {
+      h->SetBinContent(bin, (*sum)[bin] * scale);
+      h->SetBinError(bin, std::sqrt((*sum2)[bin]) * scale);
+    }
+  }
+
+  hentries->SetEntries(sums.nfills);
+  for (const auto& entry : histograms)
+  {
+    std::get<0>(entry)->SetEntries(sums.nfills);
+  }
+}
@@ -19,8 +19,10 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <array>
 #include <memory>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 // class CMFlashClusterContainer;
@@ -318,6 +320,55 @@ class TpcCentralMembraneMatching : public SubsysReco
   std::vector<TVector3> m_truth_pos;
   std::vector<int> m_truth_index;
 
+  /// (r, phi) bucket index of the truth positions of one side
+  /**
+   * built once in InitRun from m_truth_pos. Buckets are stored contiguously (CSR layout),
+   * each bucket lists its truth indices in increasing order
+   */
+  class TruthBuckets
+  {
+   public:
+    /// fill from the truth positions with z of the given sign
+    void build(const std::vector<TVector3> &positions, bool positive_z);
+
+    /// append indices of the truth positions with |r - r0| <= dr and |phi - phi0| <= dphi, possibly with some more
+    void find(double r0, double phi0, double dr, double dphi, std::vector<int> &indices) const;
+
+   private:
+    static constexpr double m_rstep = 1.0;         // cm
+    static constexpr double m_phistep_max = 0.05;  // rad, rounded down to divide 2pi
+    double m_phistep = m_phistep_max;
+    int m_nr = 0;
+    int m_nphi = 0;
+    std::vector<unsigned int> m_offsets;
+    std::vector<int> m_indices;
+  };
+
+  std::array<TruthBuckets, 2> m_truth_buckets;
+
+  /// dense per cell sums of the distortions of one side, indexed by the global bin of the distortion histograms
+  struct DistortionSums
+  {
+    std::vector<double> dr;
+    std::vector<double> dr2;
+    std::vector<double> dp;
+    std::vector<double> dp2;
+    std::vector<double> dz;
+    std::vector<double> dz2;
+    std::vector<unsigned int> entries;
+    unsigned int nfills = 0;
+
+    /// resize and clear
+    void reset(size_t ncells);
+  };
+
+  /// distortion sums for the current event and for the whole run, per side
+  std::array<DistortionSums, 2> m_event_sums;
+  std::array<DistortionSums, 2> m_aggregated_sums;
+
+  /// copy the distortion sums of one side to a distortion container. Cells with more than one entry are normalized if requested
+  void copy_distortion_sums(const DistortionSums &sums, TpcDistortionCorrectionContainer *dcc, int side, bool normalize) const;
+
   std::vector<double> m_truth_RPeaks{22.709, 23.841, 24.973, 26.1049, 27.2369, 28.3689, 29.5009, 30.6328, 31.7648, 32.8968, 34.0288, 35.1607, 36.2927, 37.4247, 38.5566, 39.6886, 42.1706, 44.2119, 46.2533, 48.2947, 50.3361, 52.3774, 54.4188, 56.4602, 59.4605, 61.6546, 63.8487, 66.0428, 68.2369, 70.431, 72.6251, 74.8192};
 
   //@}
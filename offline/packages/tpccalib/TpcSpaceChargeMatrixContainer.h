@@ -94,6 +94,11 @@ class TpcSpaceChargeMatrixContainer : public PHObject
   virtual bool add( const TpcSpaceChargeMatrixContainer& /*other*/ )
   { return false; }
 
+  /// add content from other container, for cells in [first_cell, last_cell[ only, returns true on success
+  /** this allows to split the merging of large containers between several threads */
+  virtual bool add( const TpcSpaceChargeMatrixContainer& /*other*/, int /*first_cell*/, int /*last_cell*/ )
+  { return false; }
+
   //@}
 
   private:
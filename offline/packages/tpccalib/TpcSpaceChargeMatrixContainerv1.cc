@@ -8,6 +8,8 @@
 
 #include "TpcSpaceChargeMatrixContainerv1.h"
 
+#include <algorithm>
+
 //___________________________________________________________
 TpcSpaceChargeMatrixContainerv1::TpcSpaceChargeMatrixContainerv1()
 {
@@ -139,6 +141,12 @@ void TpcSpaceChargeMatrixContainerv1::add_to_rhs(int cell_index, int i, float va
 
 //___________________________________________________________
 bool TpcSpaceChargeMatrixContainerv1::add(const TpcSpaceChargeMatrixContainer& other)
+{
+  return add(other, 0, m_lhs.size());
+}
+
+//___________________________________________________________
+bool TpcSpaceChargeMatrixContainerv1::add(const TpcSpaceChargeMatrixContainer& other, int first_cell, int last_cell)
 {
   // check dimensions
   int phibins = 0;
@@ -151,14 +159,42 @@ bool TpcSpaceChargeMatrixContainerv1::add(const TpcSpaceChargeMatrixContainer& o
     return false;
   }
 
+  // check cell range
+  first_cell = std::max(first_cell, 0);
+  last_cell = std::min<int>(last_cell, m_lhs.size());
+
+  // when other container has the same type, access its arrays directly
+  if (const auto other_v1 = dynamic_cast<const TpcSpaceChargeMatrixContainerv1*>(&other))
+  {
+    for (int cell_index = first_cell; cell_index < last_cell; ++cell_index)
+    {
+      m_entries[cell_index] += other_v1->m_entries[cell_index];
+
+      auto& lhs = m_lhs[cell_index];
+      const auto& other_lhs = other_v1->m_lhs[cell_index];
+      for (size_t i = 0; i < lhs.size(); ++i)
+      {
+        lhs[i] += other_lhs[i];
+      }
+
+      auto& rhs = m_rhs[cell_index];
+      const auto& other_rhs = other_v1->m_rhs[cell_index];
+      for (size_t i = 0; i < rhs.size(); ++i)
+      {
+        rhs[i] += other_rhs[i];
+      }
+    }
+    return true;
+  }
+
   // increment cell entries
-  for (size_t cell_index = 0; cell_index < m_lhs.size(); ++cell_index)
+  for (int cell_index = first_cell; cell_index < last_cell; ++cell_index)
   {
     add_to_entries(cell_index, other.get_entries(cell_index));
   }
 
   // increment left hand side matrices
-  for (size_t cell_index = 0; cell_index < m_lhs.size(); ++cell_index)
+  for (int cell_index = first_cell; cell_index < last_cell; ++cell_index)
   {
     for (int i = 0; i < m_ncoord; ++i)
     {
@@ -170,7 +206,7 @@ bool TpcSpaceChargeMatrixContainerv1::add(const TpcSpaceChargeMatrixContainer& o
   }
 
   // increment right hand side matrices
-  for (size_t cell_index = 0; cell_index < m_lhs.size(); ++cell_index)
+  for (int cell_index = first_cell; cell_index < last_cell; ++cell_index)
   {
     for (int i = 0; i < m_ncoord; ++i)
     {
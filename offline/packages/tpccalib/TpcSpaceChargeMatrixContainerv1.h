@@ -81,6 +81,9 @@ class TpcSpaceChargeMatrixContainerv1 : public TpcSpaceChargeMatrixContainer
   /// add content from other container
   bool add(const TpcSpaceChargeMatrixContainer& other) override;
 
+  /// add content from other container, for cells in [first_cell, last_cell[ only
+  bool add(const TpcSpaceChargeMatrixContainer& other, int first_cell, int last_cell) override;
+
   //@}
 
  private:
@@ -14,11 +14,14 @@
 #include <TFile.h>
 #include <TH2.h>
 #include <TH3.h>
+#include <TROOT.h>
 
 #include <Eigen/Core>
 #include <Eigen/Dense>
 
+#include <algorithm>
 #include <memory>
+#include <thread>
 
 namespace
 {
@@ -34,6 +37,25 @@ namespace
   // z range
   static constexpr float m_zmin = -105.5;
   static constexpr float m_zmax = 105.5;
+
+  // run function f(ithread, nthreads) on nthreads threads, including the calling one, and wait for completion
+  template <class F>
+  void run_parallel(unsigned int nthreads, F&& f)
+  {
+    nthreads = std::max(nthreads, 1U);
+    std::vector<std::thread> threads;
+    threads.reserve(nthreads - 1);
+    for (unsigned int ithread = 1; ithread < nthreads; ++ithread)
+    {
+      threads.emplace_back(f, ithread, nthreads);
+    }
+    f(0, nthreads);
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+  }
+
 }  // namespace
 
 //_____________________________________________________________________
@@ -119,24 +141,131 @@ bool TpcSpaceChargeMatrixInversion::add_from_file(const std::string& shortfilena
   FROG frog;
   const auto filename = frog.location(shortfilename);
 
+  // load object from input file
+  const auto source = load_from_file(filename, objectname);
+  if (!source)
+  {
+    return false;
+  }
+
+  // add object
+  return add(*source.get());
+}
+
+//_____________________________________________________________________
+bool TpcSpaceChargeMatrixInversion::add_from_files(const std::vector<std::string>& shortfilenames, const std::string& objectname)
+{
+  // get filenames from frog. This is done upfront, since frog is not thread safe
+  std::vector<std::string> filenames;
+  filenames.reserve(shortfilenames.size());
+  FROG frog;
+  for (const auto& shortfilename : shortfilenames)
+  {
+    filenames.emplace_back(frog.location(shortfilename));
+  }
+
+  // needed for reading TFiles concurrently
+  if (m_nthreads > 1)
+  {
+    ROOT::EnableThreadSafety();
+  }
+
+  /*
+   * files are loaded in batches, to limit memory usage.
+   * Each thread reads every m_nthreads'th file of the batch
+   */
+  const size_t batch_size = 4 * std::max(m_nthreads, 1U);
+  bool success = true;
+  for (size_t first = 0; first < filenames.size(); first += batch_size)
+  {
+    const size_t last = std::min(first + batch_size, filenames.size());
+    std::vector<std::unique_ptr<TpcSpaceChargeMatrixContainer>> sources(last - first);
+    run_parallel(m_nthreads, [&](unsigned int ithread, unsigned int nthreads)
+                 {
+                   for (size_t i = ithread; i < sources.size(); i += nthreads)
+                   {
+                     sources[i] = load_from_file(filenames[first + i], objectname);
+                   } });
+
+    // create internal container if necessary, and check grid dimensions
+    for (auto& source : sources)
+    {
+      if (!source)
+      {
+        success = false;
+        continue;
+      }
+
+      // get grid dimensions from source
+      int phibins = 0;
+      int rbins = 0;
+      int zbins = 0;
+      source->get_grid_dimensions(phibins, rbins, zbins);
+
+      if (!m_matrix_container)
+      {
+        m_matrix_container.reset(new TpcSpaceChargeMatrixContainerv1);
+        m_matrix_container->set_grid_dimensions(phibins, rbins, zbins);
+      }
+
+      // compare to internal container
+      int phibins_ref = 0;
+      int rbins_ref = 0;
+      int zbins_ref = 0;
+      m_matrix_container->get_grid_dimensions(phibins_ref, rbins_ref, zbins_ref);
+      if ((phibins != phibins_ref) || (rbins != rbins_ref) || (zbins != zbins_ref))
+      {
+        std::cout << "TpcSpaceChargeMatrixInversion::add_from_files - inconsistent grid sizes" << std::endl;
+        source.reset();
+        success = false;
+      }
+    }
+
+    if (!m_matrix_container)
+    {
+      continue;
+    }
+
+    /*
+     * add sources, in file order, splitting the cells between threads.
+     * Each cell is thus summed in the same order as when adding files one by one
+     */
+    const int ncells = m_matrix_container->get_grid_size();
+    run_parallel(m_nthreads, [&](unsigned int ithread, unsigned int nthreads)
+                 {
+                   const int first_cell = ncells * ithread / nthreads;
+                   const int last_cell = ncells * (ithread + 1) / nthreads;
+                   for (const auto& source : sources)
+                   {
+                     if (source)
+                     {
+                       m_matrix_container->add(*source.get(), first_cell, last_cell);
+                     }
+                   } });
+  }
+
+  return success;
+}
+
+//_____________________________________________________________________
+std::unique_ptr<TpcSpaceChargeMatrixContainer> TpcSpaceChargeMatrixInversion::load_from_file(const std::string& filename, const std::string& objectname) const
+{
   // open TFile
-  std::unique_ptr<TFile> inputfile(TFile::Open(filename));
+  std::unique_ptr<TFile> inputfile(TFile::Open(filename.c_str()));
   if (!inputfile)
   {
-    std::cout << "TpcSpaceChargeMatrixInversion::add_from_file - could not open file " << filename << std::endl;
-    return false;
+    std::cout << "TpcSpaceChargeMatrixInversion::load_from_file - could not open file " << filename << std::endl;
+    return nullptr;
   }
 
   // load object from input file
   std::unique_ptr<TpcSpaceChargeMatrixContainer> source(dynamic_cast<TpcSpaceChargeMatrixContainer*>(inputfile->Get(objectname.c_str())));
   if (!source)
   {
-    std::cout << "TpcSpaceChargeMatrixInversion::add_from_file - could not find object name " << objectname << " in file " << filename << std::endl;
-    return false;
+    std::cout << "TpcSpaceChargeMatrixInversion::load_from_file - could not find object name " << objectname << " in file " << filename << std::endl;
   }
 
-  // add object
-  return add(*source.get());
+  return source;
 }
 
 //_____________________________________________________________________
@@ -190,77 +319,114 @@ void TpcSpaceChargeMatrixInversion::calculate_distortion_corrections()
   using matrix_t = Eigen::Matrix<float, ncoord, ncoord>;
   using column_t = Eigen::Matrix<float, ncoord, 1>;
 
-  // loop over bins
-  for (int iphi = 0; iphi < phibins; ++iphi)
+  // inversion result for a given cell
+  struct cell_result_t
   {
-    for (int ir = 0; ir < rbins; ++ir)
+    bool valid = false;
+    int entries = 0;
+    column_t result;
+    column_t error;
+  };
+
+  // loop over bins, in the same order as histogram filling. Cells are split between threads
+  const int ncells = phibins * rbins * zbins;
+  std::vector<cell_result_t> cell_results(ncells);
+  const unsigned int nthreads = Verbosity() ? 1 : m_nthreads;
+  run_parallel(nthreads, [&](unsigned int ithread, unsigned int nthreads_local)
+               {
+    const int first = ncells * ithread / nthreads_local;
+    const int last = ncells * (ithread + 1) / nthreads_local;
+    for (int index = first; index < last; ++index)
     {
-      for (int iz = 0; iz < zbins; ++iz)
+      const int iz = index % zbins;
+      const int ir = (index / zbins) % rbins;
+      const int iphi = index / (zbins * rbins);
+
+      // get cell index
+      const auto icell = m_matrix_container->get_cell_index(iphi, ir, iz);
+
+      // minimum number of entries per bin
+      static constexpr int min_cluster_count = 2;
+      const auto cell_entries = m_matrix_container->get_entries(icell);
+      if (cell_entries < min_cluster_count)
       {
-        // get cell index
-        const auto icell = m_matrix_container->get_cell_index(iphi, ir, iz);
+        continue;
+      }
 
-        // minimum number of entries per bin
-        static constexpr int min_cluster_count = 2;
-        const auto cell_entries = m_matrix_container->get_entries(icell);
-        if (cell_entries < min_cluster_count)
+      // build eigen matrices from container
+      matrix_t lhs;
+      for (int i = 0; i < ncoord; ++i)
+      {
+        for (int j = 0; j < ncoord; ++j)
         {
-          continue;
+          lhs(i, j) = m_matrix_container->get_lhs(icell, i, j);
         }
+      }
 
-        // build eigen matrices from container
-        matrix_t lhs;
-        for (int i = 0; i < ncoord; ++i)
-        {
-          for (int j = 0; j < ncoord; ++j)
-          {
-            lhs(i, j) = m_matrix_container->get_lhs(icell, i, j);
-          }
-        }
+      column_t rhs;
+      for (int i = 0; i < ncoord; ++i)
+      {
+        rhs(i) = m_matrix_container->get_rhs(icell, i);
+      }
 
-        column_t rhs;
-        for (int i = 0; i < ncoord; ++i)
-        {
-          rhs(i) = m_matrix_container->get_rhs(icell, i);
-        }
+      if (Verbosity())
+      {
+        // print matrices and entries
+        std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - inverting bin " << iz << ", " << ir << ", " << iphi << std::endl;
+        std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - entries: " << cell_entries << std::endl;
+        std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - lhs: \n"
+                  << lhs << std::endl;
+        std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - rhs: \n"
+                  << rhs << std::endl;
+      }
 
-        if (Verbosity())
-        {
-          // print matrices and entries
-          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - inverting bin " << iz << ", " << ir << ", " << iphi << std::endl;
-          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - entries: " << cell_entries << std::endl;
-          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - lhs: \n"
-                    << lhs << std::endl;
-          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - rhs: \n"
-                    << rhs << std::endl;
-        }
+      // calculate result using linear solving
+      const auto cov = lhs.inverse();
+      auto partialLu = lhs.partialPivLu();
+      const auto result = partialLu.solve(rhs);
 
-        // calculate result using linear solving
-        const auto cov = lhs.inverse();
-        auto partialLu = lhs.partialPivLu();
-        const auto result = partialLu.solve(rhs);
+      // store
+      auto& cell_result = cell_results[index];
+      cell_result.valid = true;
+      cell_result.entries = cell_entries;
+      for (int i = 0; i < ncoord; ++i)
+      {
+        cell_result.result(i) = result(i);
+        cell_result.error(i) = std::sqrt(cov(i, i));
+      }
 
-        // fill histograms
-        hentries->SetBinContent(iphi + 1, ir + 1, iz + 1, cell_entries);
+      if (Verbosity())
+      {
+        std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - drphi: " << result(0) << " +/- " << std::sqrt(cov(0, 0)) << std::endl;
+        std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dz: " << result(1) << " +/- " << std::sqrt(cov(1, 1)) << std::endl;
+        std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dr: " << result(2) << " +/- " << std::sqrt(cov(2, 2)) << std::endl;
+        std::cout << std::endl;
+      }
+    } });
 
-        hphi->SetBinContent(iphi + 1, ir + 1, iz + 1, result(0));
-        hphi->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov(0, 0)));
+  // fill histograms. This is done sequentially since histograms are not thread safe
+  for (int index = 0; index < ncells; ++index)
+  {
+    const auto& cell_result = cell_results[index];
+    if (!cell_result.valid)
+    {
+      continue;
+    }
 
-        hz->SetBinContent(iphi + 1, ir + 1, iz + 1, result(1));
-        hz->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov(1, 1)));
+    const int iz = index % zbins;
+    const int ir = (index / zbins) % rbins;
+    const int iphi = index / (zbins * rbins);
 
-        hr->SetBinContent(iphi + 1, ir + 1, iz + 1, result(2));
-        hr->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov(2, 2)));
+    hentries->SetBinContent(iphi + 1, ir + 1, iz + 1, cell_result.entries);
 
-        if (Verbosity())
-        {
-          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - drphi: " << result(0) << " +/- " << std::sqrt(cov(0, 0)) << std::endl;
-          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dz: " << result(1) << " +/- " << std::sqrt(cov(1, 1)) << std::endl;
-          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dr: " << result(2) << " +/- " << std::sqrt(cov(2, 2)) << std::endl;
-          std::cout << std::endl;
-        }
-      }
-    }
+    hphi->SetBinContent(iphi + 1, ir + 1, iz + 1, cell_result.result(0));
+    hphi->SetBinError(iphi + 1, ir + 1, iz + 1, cell_result.error(0));
+
+    hz->SetBinContent(iphi + 1, ir + 1, iz + 1, cell_result.result(1));
+    hz->SetBinError(iphi + 1, ir + 1, iz + 1, cell_result.error(1));
+
+    hr->SetBinContent(iphi + 1, ir + 1, iz + 1, cell_result.result(2));
+    hr->SetBinError(iphi + 1, ir + 1, iz + 1, cell_result.error(2));
   }
 
   // split histograms in two along z axis and write
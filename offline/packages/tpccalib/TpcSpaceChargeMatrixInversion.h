@@ -12,6 +12,8 @@
 #include <tpc/TpcDistortionCorrectionContainer.h>
 
 #include <memory>
+#include <string>
+#include <vector>
 
 /**
  * \class TpcSpaceChargeMatrixInversion
@@ -39,6 +41,20 @@ class TpcSpaceChargeMatrixInversion : public Fun4AllBase
   /// add space charge correction matrix, loaded from file, to current. Returns true on success
   bool add_from_file(const std::string& /*filename*/, const std::string& /*objectname*/ = "TpcSpaceChargeMatrixContainer");
 
+  /// add space charge correction matrices, loaded from files, to current. Returns true if all files were successfully added
+  /**
+   * files are read concurrently, in batches, using m_nthreads threads.
+   * Matrices are then summed in file order, with the cells split between threads,
+   * so that the result is identical to calling add_from_file on each file
+   */
+  bool add_from_files(const std::vector<std::string>& /*filenames*/, const std::string& /*objectname*/ = "TpcSpaceChargeMatrixContainer");
+
+  /// number of threads used to read, merge and invert matrices
+  void set_nthreads(unsigned int value)
+  {
+    m_nthreads = value;
+  }
+
   /// calculate distortions by inverting stored matrices, and save relevant histograms
   void calculate_distortion_corrections();
 
@@ -51,6 +67,12 @@ class TpcSpaceChargeMatrixInversion : public Fun4AllBase
   //@}
 
  private:
+  /// load space charge correction matrix from file. Returns nullptr on failure
+  std::unique_ptr<TpcSpaceChargeMatrixContainer> load_from_file(const std::string& /*filename*/, const std::string& /*objectname*/) const;
+
+  /// number of threads
+  unsigned int m_nthreads = 1;
+
   /// matrix container
   std::unique_ptr<TpcSpaceChargeMatrixContainer> m_matrix_container;
 
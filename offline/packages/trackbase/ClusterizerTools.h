@@ -0,0 +1,255 @@
+#ifndef TRACKBASE_CLUSTERIZERTOOLS_H
+#define TRACKBASE_CLUSTERIZERTOOLS_H
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+/*!
+ * helpers shared by the silicon clusterizers (MvtxClusterizer, InttClusterizer):
+ * connected component search of hits on a (major, minor) grid,
+ * and the driver which clusters each detector module in its own thread
+ */
+namespace ClusterizerTools
+{
+  /// scratch buffers of find_components, reused between calls
+  struct ComponentBuffers
+  {
+    std::vector<unsigned int> order;
+    std::vector<uint32_t> keys;
+    std::vector<unsigned int> parent;
+
+    /// group id of each hit
+    std::vector<int> component;
+
+    /// hits of group c are members[offsets[c]] to members[offsets[c+1]-1], in hit order
+    std::vector<unsigned int> offsets;
+    std::vector<unsigned int> members;
+  };
+
+  /// union-find root lookup, with path halving
+  inline unsigned int find_root(std::vector<unsigned int>& parent, unsigned int i)
+  {
+    while (parent[i] != i)
+    {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  }
+
+  /// union-find merge. The smallest index is kept as root
+  inline void merge_roots(std::vector<unsigned int>& parent, unsigned int i, unsigned int j)
+  {
+    i = find_root(parent, i);
+    j = find_root(parent, j);
+    if (i < j)
+    {
+      parent[j] = i;
+    }
+    else if (j < i)
+    {
+      parent[i] = j;
+    }
+  }
+
+  /// sort (bin, adc) pairs by bin and merge duplicated bins, summing their adc
+  inline void merge_bins(std::vector<std::pair<int, int>>& bins)
+  {
+    std::sort(bins.begin(), bins.end(), [](const std::pair<int, int>& lhs, const std::pair<int, int>& rhs)
+              { return lhs.first < rhs.first; });
+    unsigned int size = 0;
+    for (const auto& bin : bins)
+    {
+      if (size > 0 && bins[size - 1].first == bin.first)
+      {
+        bins[size - 1].second += bin.second;
+      }
+      else
+      {
+        bins[size++] = bin;
+      }
+    }
+    bins.resize(size);
+  }
+
+  /*!
+    find connected groups of nhits hits. hit_key(i) returns (major << 16) | minor for hit i.
+    Hits are sorted by major then minor coordinate, and each hit is merged with its already visited neighbors:
+    previous minor coordinate with the same major coordinate and, if merge_major is set,
+    minor -1 to +1 in the previous major coordinate.
+    Group ids are assigned in order of first hit, which matches boost::connected_components numbering.
+    Returns the number of groups, the groups are stored in buffers
+  */
+  template <class KeyFunction>
+  unsigned int find_components(const unsigned int nhits, KeyFunction hit_key, const bool merge_major, ComponentBuffers& buffers)
+  {
+    // sort hits. Hits from TrkrHitSet come already sorted
+    auto& order = buffers.order;
+    order.resize(nhits);
+    std::iota(order.begin(), order.end(), 0);
+    auto key_less = [&hit_key](unsigned int lhs, unsigned int rhs)
+    { return hit_key(lhs) < hit_key(rhs); };
+    if (!std::is_sorted(order.begin(), order.end(), key_less))
+    {
+      std::sort(order.begin(), order.end(), key_less);
+    }
+
+    auto& keys = buffers.keys;
+    keys.resize(nhits);
+    for (unsigned int k = 0; k < nhits; ++k)
+    {
+      keys[k] = hit_key(order[k]);
+    }
+
+    auto& parent = buffers.parent;
+    parent.resize(nhits);
+    std::iota(parent.begin(), parent.end(), 0);
+
+    // first hit in the previous major coordinate that can still be adjacent to the current hit
+    unsigned int prev = 0;
+    for (unsigned int k = 0; k < nhits; ++k)
+    {
+      const uint32_t key = keys[k];
+      const uint32_t major = key >> 16U;
+      const uint32_t minor = key & 0xFFFFU;
+
+      // same hit, or previous minor coordinate with the same major coordinate
+      if (k > 0 && (keys[k - 1] == key || (minor > 0 && keys[k - 1] == key - 1)))
+      {
+        merge_roots(parent, order[k - 1], order[k]);
+      }
+
+      if (!merge_major || major == 0)
+      {
+        continue;
+      }
+
+      // minor -1 to +1 in the previous major coordinate. Both bounds are below key, so the loops stop before k
+      const uint32_t first = ((major - 1) << 16U) + (minor > 0 ? minor - 1 : 0);
+      const uint32_t last = ((major - 1) << 16U) + minor + 1;
+      while (keys[prev] < first)
+      {
+        ++prev;
+      }
+      for (unsigned int q = prev; keys[q] <= last; ++q)
+      {
+        merge_roots(parent, order[q], order[k]);
+      }
+    }
+
+    // assign group ids in order of first hit
+    auto& component = buffers.component;
+    component.assign(nhits, -1);
+    unsigned int ncomponents = 0;
+    for (unsigned int i = 0; i < nhits; ++i)
+    {
+      const auto root = find_root(parent, i);
+      if (component[root] < 0)
+      {
+        component[root] = ncomponents++;
+      }
+      component[i] = component[root];
+    }
+
+    // group hit indices per component, preserving the hit order within each component
+    auto& offsets = buffers.offsets;
+    offsets.assign(ncomponents + 1, 0);
+    for (unsigned int i = 0; i < nhits; ++i)
+    {
+      ++offsets[component[i] + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    auto& members = buffers.members;
+    members.resize(nhits);
+    for (unsigned int i = 0; i < nhits; ++i)
+    {
+      members[offsets[component[i]]++] = i;
+    }
+
+    // restore offsets to the start of each component
+    for (unsigned int c = ncomponents; c > 0; --c)
+    {
+      offsets[c] = offsets[c - 1];
+    }
+    offsets[0] = 0;
+
+    return ncomponents;
+  }
+
+  /// function and data of one module, as passed to the thread
+  template <class T, class Function>
+  struct ModuleJob
+  {
+    Function function;
+    T* data = nullptr;
+  };
+
+  template <class T, class Function>
+  void* process_module_thread(void* threadarg)
+  {
+    auto job = static_cast<ModuleJob<T, Function>*>(threadarg);
+    job->function(job->data);
+    pthread_exit(nullptr);
+  }
+
+  /// call function(&module) for all modules, either sequentially or with one thread per module
+  template <class T, class Function>
+  void process_modules(std::vector<T>& modules, Function function, const bool do_sequential)
+  {
+    if (do_sequential)
+    {
+      for (auto& data : modules)
+      {
+        function(&data);
+      }
+      return;
+    }
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+
+    std::vector<ModuleJob<T, Function>> jobs(modules.size(), ModuleJob<T, Function>{function});
+    std::vector<pthread_t> threads(modules.size());
+    std::vector<bool> started(modules.size(), false);
+    for (unsigned int i = 0; i < modules.size(); ++i)
+    {
+      jobs[i].data = &modules[i];
+      int rc = pthread_create(&threads[i], &attr, process_module_thread<T, Function>, (void*) &jobs[i]);
+      if (rc)
+      {
+        std::cout << "Error:unable to create thread," << rc << std::endl;
+
+        // process in the current thread instead
+        function(&modules[i]);
+        continue;
+      }
+      started[i] = true;
+    }
+    pthread_attr_destroy(&attr);
+
+    // wait for completion of all threads
+    for (unsigned int i = 0; i < modules.size(); ++i)
+    {
+      if (!started[i])
+      {
+        continue;
+      }
+      int rc2 = pthread_join(threads[i], nullptr);
+      if (rc2)
+      {
+        std::cout << "Error:unable to join," << rc2 << std::endl;
+      }
+    }
+  }
+
+}  // namespace ClusterizerTools
+
+#endif
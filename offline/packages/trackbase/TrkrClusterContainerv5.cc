@@ -0,0 +1,471 @@
+/**
+ * @file trackbase/TrkrClusterContainerv5.cc
+ * @brief Implementation of TrkrClusterContainerv5
+ */
+#include "TrkrClusterContainerv5.h"
+#include "TrkrCluster.h"
+#include "TrkrClusterv5.h"
+#include "TrkrDefs.h"
+
+#include <TBuffer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>  // for exit
+#include <cstring>  // for memcpy
+#include <typeinfo>
+
+namespace
+{
+  TrkrClusterContainer::Map dummy_map;
+
+  // store value as multiple of step, or its bit pattern if step is zero
+  int quantize(float value, float step)
+  {
+    if (step > 0)
+    {
+      return std::lround(value / step);
+    }
+    int out;
+    std::memcpy(&out, &value, sizeof(float));
+    return out;
+  }
+
+  // same as quantize, but a non zero error is never stored as zero
+  int quantize_error(float value, float step)
+  {
+    const int out = quantize(value, step);
+    if (step > 0 && out == 0 && value != 0)
+    {
+      return value > 0 ? 1 : -1;
+    }
+    return out;
+  }
+
+  // only the TrkrClusterv5 content is written, any other cluster type would lose information
+  bool is_supported(const TrkrCluster* cluster)
+  {
+    return typeid(*cluster) == typeid(TrkrClusterv5);
+  }
+
+  float unquantize(int value, float step)
+  {
+    if (step > 0)
+    {
+      return value * step;
+    }
+    float out;
+    std::memcpy(&out, &value, sizeof(float));
+    return out;
+  }
+}  // namespace
+
+//_________________________________________________________________
+TrkrClusterContainerv5::~TrkrClusterContainerv5()
+{
+  TrkrClusterContainerv5::Reset();
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::Reset()
+{
+  // delete all clusters
+  for (auto&& [key, clus_vector] : m_clusmap)
+  {
+    for (auto&& cluster : clus_vector)
+    {
+      delete cluster;
+    }
+  }
+
+  // clear the maps
+  /* using swap ensures that the memory is properly de-allocated */
+  {
+    std::map<TrkrDefs::hitsetkey, Vector> empty;
+    m_clusmap.swap(empty);
+  }
+
+  // also clear temporary map
+  {
+    Map empty;
+    m_tmpmap.swap(empty);
+  }
+
+  clear_columns();
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::identify(std::ostream& os) const
+{
+  os << "-----TrkrClusterContainerv5-----" << std::endl;
+  os << "Number of clusters: " << size() << std::endl;
+  os << "position step: " << m_position_step << " error step: " << m_error_step << std::endl;
+
+  for (const auto& [hitsetkey, clus_vector] : m_clusmap)
+  {
+    const unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+    os << "layer: " << layer << " hitsetkey: " << hitsetkey << std::endl;
+
+    for (const auto& cluster : clus_vector)
+    {
+      if (cluster)
+      {
+        cluster->identify(os);
+      }
+    }
+  }
+
+  os << "------------------------------" << std::endl;
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::removeCluster(TrkrDefs::cluskey key)
+{
+  // get hitset key from cluster
+  const TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(key);
+
+  // find relevant cluster map if any and remove corresponding cluster
+  auto iter = m_clusmap.find(hitsetkey);
+  if (iter != m_clusmap.end())
+  {
+    // local reference to the vector
+    auto& clus_vector = iter->second;
+
+    // cluster index in vector
+    const auto index = TrkrDefs::getClusIndex(key);
+
+    // compare to vector size
+    if (index < clus_vector.size())
+    {
+      // delete corresponding element and set to null
+      delete clus_vector[index];
+      clus_vector[index] = nullptr;
+    }
+  }
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::addClusterSpecifyKey(const TrkrDefs::cluskey key, TrkrCluster* newclus)
+{
+  if (!newclus || !is_supported(newclus))
+  {
+    std::cout << "TrkrClusterContainerv5::AddClusterSpecifyKey: key: " << key
+              << " unsupported cluster type " << (newclus ? newclus->ClassName() : "null")
+              << ", only TrkrClusterv5 can be stored. exiting now" << std::endl;
+    exit(1);
+  }
+
+  // get hitsetkey from cluster
+  const TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(key);
+
+  // find relevant vector or create one if not found
+  auto& clus_vector = m_clusmap[hitsetkey];
+
+  // get cluster index in vector
+  const auto index = TrkrDefs::getClusIndex(key);
+
+  // compare index to vector size
+  if (index < clus_vector.size())
+  {
+    /*
+     * if index is already contained in vector, check corresponding element
+     * and assign newclus if null
+     * print error message and exit otherwise
+     */
+    if (!clus_vector[index])
+    {
+      clus_vector[index] = newclus;
+    }
+    else
+    {
+      std::cout << "TrkrClusterContainerv5::AddClusterSpecifyKey: duplicate key: " << key << " exiting now" << std::endl;
+      exit(1);
+    }
+  }
+  else if (index == clus_vector.size())
+  {
+    // if index matches the vector size, just push back the new cluster
+    clus_vector.push_back(newclus);
+  }
+  else
+  {
+    // if index exceeds the vector size, resize cluster to the right size with nullptr, and assign
+    clus_vector.resize(index + 1, nullptr);
+    clus_vector[index] = newclus;
+  }
+}
+
+TrkrClusterContainerv5::ConstRange
+TrkrClusterContainerv5::getClusters() const
+{
+  std::cout << "deprecated function in TrkrClusterContainerv5, user getClusters(TrkrDefs:hitsetkey)"
+            << std::endl;
+  return std::make_pair(dummy_map.begin(), dummy_map.begin());
+}
+
+//_________________________________________________________________
+TrkrClusterContainerv5::ConstRange
+TrkrClusterContainerv5::getClusters(TrkrDefs::hitsetkey hitsetkey)
+{
+  // clear temporary map
+  {
+    Map empty;
+    m_tmpmap.swap(empty);
+  }
+
+  // find relevant vector
+  const auto iter = m_clusmap.find(hitsetkey);
+  if (iter != m_clusmap.end())
+  {
+    // copy content in temporary map
+    const auto& clusters = iter->second;
+    for (size_t index = 0; index < clusters.size(); ++index)
+    {
+      const auto& cluster = clusters[index];
+      if (cluster)
+      {
+        // generate cluster key from hitset and index
+        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+
+        // insert in map
+        m_tmpmap.insert(m_tmpmap.end(), std::make_pair(ckey, cluster));
+      }
+    }
+  }
+
+  // return temporary map range
+  return std::make_pair(m_tmpmap.cbegin(), m_tmpmap.cend());
+}
+
+//_________________________________________________________________
+TrkrCluster* TrkrClusterContainerv5::findCluster(TrkrDefs::cluskey key) const
+{
+  // get hitsetkey from cluster
+  const TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(key);
+
+  const auto map_iter = m_clusmap.find(hitsetkey);
+  if (map_iter != m_clusmap.end())
+  {
+    // local reference to vector
+    const auto& clus_vector = map_iter->second;
+
+    // get cluster position in vector
+    const auto index = TrkrDefs::getClusIndex(key);
+
+    // compare to vector size
+    if (index < clus_vector.size())
+    {
+      return clus_vector[index];
+    }
+    else
+    {
+      return nullptr;
+    }
+  }
+  else
+  {
+    return nullptr;
+  }
+}
+
+//_________________________________________________________________
+TrkrClusterContainer::HitSetKeyList TrkrClusterContainerv5::getHitSetKeys() const
+{
+  HitSetKeyList out;
+  out.reserve(m_clusmap.size());
+  std::transform(
+      m_clusmap.begin(), m_clusmap.end(), std::back_inserter(out),
+      [](const std::pair<TrkrDefs::hitsetkey, Vector>& pair)
+      { return pair.first; });
+  return out;
+}
+
+//_________________________________________________________________
+TrkrClusterContainer::HitSetKeyList TrkrClusterContainerv5::getHitSetKeys(const TrkrDefs::TrkrId trackerid) const
+{
+  /* copy the logic from TrkrHitSetContainerv1::getHitSets */
+  const TrkrDefs::hitsetkey keylo = TrkrDefs::getHitSetKeyLo(trackerid);
+  const TrkrDefs::hitsetkey keyhi = TrkrDefs::getHitSetKeyHi(trackerid);
+
+  // get relevant range in map
+  const auto begin = m_clusmap.lower_bound(keylo);
+  const auto end = m_clusmap.upper_bound(keyhi);
+
+  // transform to a vector
+  HitSetKeyList out;
+  out.reserve(m_clusmap.size());
+  std::transform(
+      begin, end, std::back_inserter(out),
+      [](const std::pair<TrkrDefs::hitsetkey, Vector>& pair)
+      { return pair.first; });
+  return out;
+}
+
+//_________________________________________________________________
+TrkrClusterContainer::HitSetKeyList TrkrClusterContainerv5::getHitSetKeys(const TrkrDefs::TrkrId trackerid, const uint8_t layer) const
+{
+  /* copy the logic from TrkrHitSetContainerv1::getHitSets */
+  TrkrDefs::hitsetkey keylo = TrkrDefs::getHitSetKeyLo(trackerid, layer);
+  TrkrDefs::hitsetkey keyhi = TrkrDefs::getHitSetKeyHi(trackerid, layer);
+
+  // get relevant range in map
+  const auto begin = m_clusmap.lower_bound(keylo);
+  const auto end = m_clusmap.upper_bound(keyhi);
+
+  // transform to a vector
+  HitSetKeyList out;
+  out.reserve(m_clusmap.size());
+  std::transform(
+      begin, end, std::back_inserter(out),
+      [](const std::pair<TrkrDefs::hitsetkey, Vector>& pair)
+      { return pair.first; });
+  return out;
+}
+
+//_________________________________________________________________
+unsigned int TrkrClusterContainerv5::size() const
+{
+  unsigned int size = 0;
+  for (const auto& [hitsetkey, clus_vector] : m_clusmap)
+  {
+    size += std::count_if(clus_vector.begin(), clus_vector.end(), [](TrkrCluster* cluster)
+                          { return cluster; });
+  }
+  return size;
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::Streamer(TBuffer& buffer)
+{
+  if (buffer.IsReading())
+  {
+    buffer.ReadClassBuffer(TrkrClusterContainerv5::Class(), this);
+    unpack();
+  }
+  else
+  {
+    pack();
+    buffer.WriteClassBuffer(TrkrClusterContainerv5::Class(), this);
+    clear_columns();
+  }
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::pack()
+{
+  clear_columns();
+  const auto nclusters = size();
+  m_hitsetkeys.reserve(m_clusmap.size());
+  m_nclusters.reserve(m_clusmap.size());
+  m_localx.reserve(nclusters);
+  m_localy.reserve(nclusters);
+  m_phierr.reserve(nclusters);
+  m_zerr.reserve(nclusters);
+  m_subsurfkey.reserve(nclusters);
+  m_adc.reserve(nclusters);
+  m_maxadc.reserve(nclusters);
+  m_phisize.reserve(nclusters);
+  m_zsize.reserve(nclusters);
+  m_overlap.reserve(nclusters);
+  m_edge.reserve(nclusters);
+
+  for (const auto& [hitsetkey, clus_vector] : m_clusmap)
+  {
+    m_hitsetkeys.push_back(hitsetkey);
+    m_nclusters.push_back(clus_vector.size());
+    for (const auto& cluster : clus_vector)
+    {
+      m_valid.push_back(cluster != nullptr);
+      if (!cluster)
+      {
+        continue;
+      }
+
+      if (!is_supported(cluster))
+      {
+        std::cout << "TrkrClusterContainerv5::pack: hitsetkey: " << hitsetkey
+                  << " unsupported cluster type " << cluster->ClassName() << ", exiting now" << std::endl;
+        exit(1);
+      }
+
+      m_localx.push_back(quantize(cluster->getLocalX(), m_position_step));
+      m_localy.push_back(quantize(cluster->getLocalY(), m_position_step));
+      m_phierr.push_back(quantize_error(cluster->getRPhiError(), m_error_step));
+      m_zerr.push_back(quantize_error(cluster->getZError(), m_error_step));
+      m_subsurfkey.push_back(cluster->getSubSurfKey());
+      m_adc.push_back(static_cast<unsigned short>(cluster->getAdc()));
+      m_maxadc.push_back(static_cast<unsigned short>(cluster->getMaxAdc()));
+      m_phisize.push_back(static_cast<char>(cluster->getPhiSize()));
+      m_zsize.push_back(static_cast<char>(cluster->getZSize()));
+      m_overlap.push_back(cluster->getOverlap());
+      m_edge.push_back(cluster->getEdge());
+    }
+  }
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::unpack()
+{
+  // delete existing clusters
+  for (auto&& [key, clus_vector] : m_clusmap)
+  {
+    for (auto&& cluster : clus_vector)
+    {
+      delete cluster;
+    }
+  }
+  m_clusmap.clear();
+  m_tmpmap.clear();
+
+  unsigned int islot = 0;
+  unsigned int icluster = 0;
+  for (size_t ihitset = 0; ihitset < m_hitsetkeys.size(); ++ihitset)
+  {
+    auto& clus_vector = m_clusmap.insert(m_clusmap.end(), std::make_pair(m_hitsetkeys[ihitset], Vector()))->second;
+    clus_vector.resize(m_nclusters[ihitset], nullptr);
+    for (auto& cluster : clus_vector)
+    {
+      if (!m_valid[islot++])
+      {
+        continue;
+      }
+
+      auto newclus = new TrkrClusterv5;
+      newclus->setLocalX(unquantize(m_localx[icluster], m_position_step));
+      newclus->setLocalY(unquantize(m_localy[icluster], m_position_step));
+      newclus->setPhiError(unquantize(m_phierr[icluster], m_error_step));
+      newclus->setZError(unquantize(m_zerr[icluster], m_error_step));
+      newclus->setSubSurfKey(m_subsurfkey[icluster]);
+      newclus->setAdc(m_adc[icluster]);
+      newclus->setMaxAdc(m_maxadc[icluster]);
+      newclus->setPhiSize(m_phisize[icluster]);
+      newclus->setZSize(m_zsize[icluster]);
+      newclus->setOverlap(m_overlap[icluster]);
+      newclus->setEdge(m_edge[icluster]);
+      cluster = newclus;
+      ++icluster;
+    }
+  }
+
+  clear_columns();
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::clear_columns()
+{
+  // using swap ensures that the memory is properly de-allocated
+  std::vector<TrkrDefs::hitsetkey>().swap(m_hitsetkeys);
+  std::vector<unsigned int>().swap(m_nclusters);
+  std::vector<unsigned char>().swap(m_valid);
+  std::vector<int>().swap(m_localx);
+  std::vector<int>().swap(m_localy);
+  std::vector<int>().swap(m_phierr);
+  std::vector<int>().swap(m_zerr);
+  std::vector<unsigned short>().swap(m_subsurfkey);
+  std::vector<unsigned short>().swap(m_adc);
+  std::vector<unsigned short>().swap(m_maxadc);
+  std::vector<char>().swap(m_phisize);
+  std::vector<char>().swap(m_zsize);
+  std::vector<char>().swap(m_overlap);
+  std::vector<char>().swap(m_edge);
+}
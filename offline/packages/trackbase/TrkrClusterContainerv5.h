@@ -0,0 +1,114 @@
+#ifndef TRACKBASE_TRKRCLUSTERCONTAINERV5_H
+#define TRACKBASE_TRKRCLUSTERCONTAINERV5_H
+
+/**
+ * @file trackbase/TrkrClusterContainerv5.h
+ * @brief Cluster container object with column wise storage
+ */
+
+#include "TrkrClusterContainer.h"
+
+#include <phool/PHObject.h>
+
+#include <map>
+#include <vector>
+
+class TBuffer;
+class TrkrCluster;
+
+/**
+ * @brief Cluster container object with column wise storage
+ *
+ * In memory this is the same as TrkrClusterContainerv4: one vector of clusters per hitset,
+ * which are accessed with findCluster and getClusters.
+ * On output the clusters are not written as individual objects. Their TrkrClusterv5 content
+ * is copied into one array per quantity, ordered by hitset and cluster index. The local positions
+ * and the errors are stored as integer multiples of a configurable step, which compresses well.
+ * A step of zero (the default) stores the float values unchanged (lossless).
+ * On input the clusters are rebuilt as TrkrClusterv5 from these arrays.
+ * Only TrkrClusterv5 clusters can be added, any other type is rejected.
+ * A non zero error is never stored as zero, whatever the error step.
+ */
+class TrkrClusterContainerv5 : public TrkrClusterContainer
+{
+ public:
+  TrkrClusterContainerv5() = default;
+
+  //! destructor
+  ~TrkrClusterContainerv5() override;
+
+  void Reset() override;
+
+  void identify(std::ostream& os = std::cout) const override;
+
+  void addClusterSpecifyKey(const TrkrDefs::cluskey, TrkrCluster*) override;
+
+  void removeCluster(TrkrDefs::cluskey) override;
+
+  ConstRange getClusters() const override;  // deprecated
+
+  ConstRange getClusters(TrkrDefs::hitsetkey) override;
+
+  TrkrCluster* findCluster(TrkrDefs::cluskey) const override;
+
+  HitSetKeyList getHitSetKeys() const override;
+
+  HitSetKeyList getHitSetKeys(const TrkrDefs::TrkrId) const override;
+
+  HitSetKeyList getHitSetKeys(const TrkrDefs::TrkrId, const uint8_t /* layer */) const override;
+
+  unsigned int size(void) const override;
+
+  //! step [cm] in which cluster local positions are stored, 0 for full float precision
+  void setPositionStep(float value) { m_position_step = value; }
+  float getPositionStep() const { return m_position_step; }
+
+  //! step [cm] in which cluster errors are stored, 0 for full float precision
+  void setErrorStep(float value) { m_error_step = value; }
+  float getErrorStep() const { return m_error_step; }
+
+ private:
+  //! copy the clusters into the column arrays
+  void pack();
+
+  //! rebuild the clusters from the column arrays, which are cleared afterwards
+  void unpack();
+
+  //! clear the column arrays
+  void clear_columns();
+
+  /// convenient alias
+  using Vector = std::vector<TrkrCluster*>;
+
+  /// the actual container, rebuilt from the columns on input
+  std::map<TrkrDefs::hitsetkey, Vector> m_clusmap;  //!
+
+  /// temporary map
+  Map m_tmpmap;  //! transient. The temporary map does not get written to the output
+
+  /// quantization steps, 0 means lossless
+  float m_position_step = 0;
+  float m_error_step = 0;
+
+  ///@name column storage, only filled while writing or reading
+  //@{
+  std::vector<TrkrDefs::hitsetkey> m_hitsetkeys;
+  std::vector<unsigned int> m_nclusters;  //< size of the cluster vector of each hitset, including empty slots
+  std::vector<unsigned char> m_valid;     //< false for empty slots, one per slot
+  std::vector<int> m_localx;              //< one per valid slot from here on
+  std::vector<int> m_localy;
+  std::vector<int> m_phierr;
+  std::vector<int> m_zerr;
+  std::vector<unsigned short> m_subsurfkey;
+  std::vector<unsigned short> m_adc;
+  std::vector<unsigned short> m_maxadc;
+  std::vector<char> m_phisize;
+  std::vector<char> m_zsize;
+  std::vector<char> m_overlap;
+  std::vector<char> m_edge;
+  //@}
+
+  ClassDefOverride(TrkrClusterContainerv5, 1)
+};
+
+#endif  // TRACKBASE_TRKRCLUSTERCONTAINERV5_H
@@ -73,6 +73,12 @@ class TrkrHitTruthAssoc : public PHObject
   {
   }
 
+  /**
+   * @brief Get the full association map, for one pass processing of all associations
+   * @return nullptr if not implemented
+   */
+  virtual const MMap *getMap() const { return nullptr; }
+
  protected:
   //! ctor
   TrkrHitTruthAssoc() = default;
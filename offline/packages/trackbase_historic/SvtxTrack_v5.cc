@@ -0,0 +1,472 @@
+#include "SvtxTrack_v5.h"
+#include "SvtxTrackState.h"
+#include "SvtxTrackState_v2.h"
+
+#include <trackbase/TrkrDefs.h>  // for cluskey
+
+#include <phool/PHObject.h>  // for PHObject
+
+#include <algorithm>
+#include <climits>
+#include <limits>
+#include <map>
+#include <utility>  // for swap
+#include <vector>   // for vector
+
+namespace
+{
+  // number of position and momentum entries per state
+  constexpr unsigned int npar = 6;
+
+  // number of packed covariance entries per state
+  constexpr unsigned int ncovar = 21;
+
+  // square convenience function
+  template <class T>
+  inline constexpr T square(const T& x)
+  {
+    return x * x;
+  }
+
+  // get unique index in cov. matrix array from i and j
+  inline unsigned int covar_index(unsigned int i, unsigned int j)
+  {
+    if (i > j)
+    {
+      std::swap(i, j);
+    }
+    return i + 1 + (j + 1) * (j) / 2 - 1;
+  }
+
+}  // namespace
+
+class SvtxTrack_v5::StateProxy : public SvtxTrackState
+{
+ public:
+  StateProxy(SvtxTrack_v5* track, unsigned int index)
+    : _track(track)
+    , _index(index)
+  {
+  }
+  ~StateProxy() override = default;
+
+  void identify(std::ostream& os = std::cout) const override
+  {
+    os << "---SvtxTrack_v5 state------------" << std::endl;
+    os << "pathlength: " << get_pathlength() << std::endl;
+    os << "(px,py,pz) = ("
+       << get_px() << ","
+       << get_py() << ","
+       << get_pz() << ")" << std::endl;
+
+    os << "(x,y,z) = (" << get_x() << "," << get_y() << "," << get_z() << ")" << std::endl;
+    os << "---------------------------------" << std::endl;
+  }
+
+  int isValid() const override { return 1; }
+
+  //! copies are standalone states
+  PHObject* CloneMe() const override
+  {
+    auto copy = new SvtxTrackState_v2(get_pathlength());
+    copy->set_x(get_x());
+    copy->set_y(get_y());
+    copy->set_z(get_z());
+    copy->set_px(get_px());
+    copy->set_py(get_py());
+    copy->set_pz(get_pz());
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+      for (unsigned int j = i; j < 6; ++j)
+      {
+        copy->set_error(i, j, get_error(i, j));
+      }
+    }
+    copy->set_cluskey(get_cluskey());
+    copy->set_name(get_name());
+    return copy;
+  }
+
+  float get_pathlength() const override { return _track->_state_pathlength[_index]; }
+
+  float get_x() const override { return par(0); }
+  void set_x(float x) override { par(0) = x; }
+
+  float get_y() const override { return par(1); }
+  void set_y(float y) override { par(1) = y; }
+
+  float get_z() const override { return par(2); }
+  void set_z(float z) override { par(2) = z; }
+
+  float get_pos(unsigned int i) const override { return par(i); }
+
+  float get_px() const override { return par(3); }
+  void set_px(float px) override { par(3) = px; }
+
+  float get_py() const override { return par(4); }
+  void set_py(float py) override { par(4) = py; }
+
+  float get_pz() const override { return par(5); }
+  void set_pz(float pz) override { par(5) = pz; }
+
+  float get_mom(unsigned int i) const override { return par(i + 3); }
+
+  float get_p() const override { return sqrt(pow(get_px(), 2) + pow(get_py(), 2) + pow(get_pz(), 2)); }
+  float get_pt() const override { return sqrt(pow(get_px(), 2) + pow(get_py(), 2)); }
+  float get_eta() const override { return asinh(get_pz() / get_pt()); }
+  float get_phi() const override { return atan2(get_py(), get_px()); }
+
+  float get_error(unsigned int i, unsigned int j) const override
+  {
+    return _track->_state_covar[_index * ncovar + covar_index(i, j)];
+  }
+  void set_error(unsigned int i, unsigned int j, float value) override
+  {
+    _track->_state_covar[_index * ncovar + covar_index(i, j)] = value;
+  }
+
+  TrkrDefs::cluskey get_cluskey() const override { return _track->_state_cluskey[_index]; }
+  void set_cluskey(TrkrDefs::cluskey ckey) override { _track->_state_cluskey[_index] = ckey; }
+
+  std::string get_name() const override { return _track->_state_names[_track->_state_name_index[_index]]; }
+  void set_name(const std::string& name) override { _track->_state_name_index[_index] = _track->intern_name(name); }
+
+  float get_rphi_error() const override
+  {
+    const auto phi = -std::atan2(get_y(), get_x());
+    const auto cosphi = std::cos(phi);
+    const auto sinphi = std::sin(phi);
+    return std::sqrt(
+        square(sinphi) * get_error(0, 0) +
+        square(cosphi) * get_error(1, 1) +
+        2. * cosphi * sinphi * get_error(0, 1));
+  }
+
+  float get_phi_error() const override
+  {
+    const float r = std::sqrt(square(get_x()) + square(get_y()));
+    if (r > 0)
+    {
+      return get_rphi_error() / r;
+    }
+    return 0;
+  }
+
+  float get_z_error() const override { return std::sqrt(get_error(2, 2)); }
+
+  //! states are inserted or erased in front of this one
+  void set_index(unsigned int index) { _index = index; }
+  unsigned int get_index() const { return _index; }
+
+ private:
+  float& par(unsigned int i) { return _track->_state_par[_index * npar + i]; }
+  float par(unsigned int i) const { return _track->_state_par[_index * npar + i]; }
+
+  SvtxTrack_v5* _track = nullptr;
+  unsigned int _index = 0;
+};
+
+SvtxTrack_v5::SvtxTrack_v5()
+{
+  // always include the pca point
+  insert_index(0);
+}
+
+SvtxTrack_v5::SvtxTrack_v5(const SvtxTrack& source)
+{
+  SvtxTrack_v5::CopyFrom(source);
+}
+
+// have to suppress missingMemberCopy from cppcheck, it does not
+// go down to the CopyFrom method where things are done correctly
+// cppcheck-suppress missingMemberCopy
+SvtxTrack_v5::SvtxTrack_v5(const SvtxTrack_v5& source)
+  : SvtxTrack(source)
+{
+  SvtxTrack_v5::CopyFrom(source);
+}
+
+SvtxTrack_v5& SvtxTrack_v5::operator=(const SvtxTrack_v5& source)
+{
+  CopyFrom(source);
+  return *this;
+}
+
+SvtxTrack_v5::~SvtxTrack_v5()
+{
+  clear_proxies();
+}
+
+void SvtxTrack_v5::CopyFrom(const SvtxTrack& source)
+{
+  // do nothing if copying onto oneself
+  if (this == &source)
+  {
+    return;
+  }
+
+  // parent class method
+  SvtxTrack::CopyFrom(source);
+
+  _tpc_seed = source.get_tpc_seed();
+  _silicon_seed = source.get_silicon_seed();
+  _vertex_id = source.get_vertex_id();
+  _is_positive_charge = source.get_positive_charge();
+  _chisq = source.get_chisq();
+  _ndf = source.get_ndf();
+  _track_crossing = source.get_crossing();
+
+  clear_states();
+
+  // same storage, copy the arrays
+  const auto compact = dynamic_cast<const SvtxTrack_v5*>(&source);
+  if (compact)
+  {
+    _state_pathlength = compact->_state_pathlength;
+    _state_par = compact->_state_par;
+    _state_covar = compact->_state_covar;
+    _state_cluskey = compact->_state_cluskey;
+    _state_name_index = compact->_state_name_index;
+    _state_names = compact->_state_names;
+    return;
+  }
+
+  // copy the states over into the arrays
+  for (auto iter = source.begin_states(); iter != source.end_states(); ++iter)
+  {
+    copy_state(iter->second);
+  }
+}
+
+void SvtxTrack_v5::identify(std::ostream& os) const
+{
+  os << "SvtxTrack_v5 Object ";
+  os << "id: " << get_id() << " ";
+  os << "vertex id: " << get_vertex_id() << " ";
+  os << "charge: " << get_charge() << " ";
+  os << "chisq: " << get_chisq() << " ndf:" << get_ndf() << " ";
+  os << "nstates: " << _state_pathlength.size() << " ";
+  os << std::endl;
+
+  os << "(px,py,pz) = ("
+     << get_px() << ","
+     << get_py() << ","
+     << get_pz() << ")" << std::endl;
+
+  os << "(x,y,z) = (" << get_x() << "," << get_y() << "," << get_z() << ")" << std::endl;
+
+  os << "Silicon clusters " << std::endl;
+  if (_silicon_seed)
+  {
+    for (auto iter = _silicon_seed->begin_cluster_keys();
+         iter != _silicon_seed->end_cluster_keys();
+         ++iter)
+    {
+      std::cout << *iter << ", ";
+    }
+  }
+  os << std::endl
+     << "Tpc + TPOT clusters " << std::endl;
+  if (_tpc_seed)
+  {
+    for (auto iter = _tpc_seed->begin_cluster_keys();
+         iter != _tpc_seed->end_cluster_keys();
+         ++iter)
+    {
+      std::cout << *iter << ", ";
+    }
+  }
+  os << std::endl;
+
+  return;
+}
+
+void SvtxTrack_v5::clear_states()
+{
+  clear_proxies();
+  _state_pathlength.clear();
+  _state_par.clear();
+  _state_covar.clear();
+  _state_cluskey.clear();
+  _state_name_index.clear();
+  _state_names.clear();
+}
+
+int SvtxTrack_v5::isValid() const
+{
+  return 1;
+}
+
+float SvtxTrack_v5::get_error(int i, int j) const
+{
+  const auto index = find_index(0);
+  return (index < _state_pathlength.size()) ? _state_covar[index * ncovar + covar_index(i, j)] : NAN;
+}
+
+void SvtxTrack_v5::set_error(int i, int j, float value)
+{
+  _state_covar[insert_index(0) * ncovar + covar_index(i, j)] = value;
+}
+
+const SvtxTrackState* SvtxTrack_v5::get_state(float pathlength) const
+{
+  const auto& states = materialize_states();
+  const auto iter = states.find(pathlength);
+  return (iter == states.end()) ? nullptr : iter->second;
+}
+
+SvtxTrackState* SvtxTrack_v5::get_state(float pathlength)
+{
+  auto& states = materialize_states();
+  const auto iter = states.find(pathlength);
+  return (iter == states.end()) ? nullptr : iter->second;
+}
+
+SvtxTrackState* SvtxTrack_v5::insert_state(const SvtxTrackState* state)
+{
+  copy_state(state);
+
+  // return matching state
+  return materialize_states().find(state->get_pathlength())->second;
+}
+
+size_t SvtxTrack_v5::erase_state(float pathlength)
+{
+  const auto index = find_index(pathlength);
+  if (index == _state_pathlength.size())
+  {
+    return _state_pathlength.size();
+  }
+
+  _state_pathlength.erase(_state_pathlength.begin() + index);
+  _state_par.erase(_state_par.begin() + index * npar, _state_par.begin() + (index + 1) * npar);
+  _state_covar.erase(_state_covar.begin() + index * ncovar, _state_covar.begin() + (index + 1) * ncovar);
+  _state_cluskey.erase(_state_cluskey.begin() + index);
+  _state_name_index.erase(_state_name_index.begin() + index);
+
+  if (_states_materialized)
+  {
+    auto iter = _states.find(pathlength);
+    delete iter->second;
+    iter = _states.erase(iter);
+    for (; iter != _states.end(); ++iter)
+    {
+      auto proxy = static_cast<StateProxy*>(iter->second);
+      proxy->set_index(proxy->get_index() - 1);
+    }
+  }
+
+  return _state_pathlength.size();
+}
+
+void SvtxTrack_v5::copy_state(const SvtxTrackState* state)
+{
+  const auto nstates = _state_pathlength.size();
+  const auto index = insert_index(state->get_pathlength());
+  if (_state_pathlength.size() == nstates)
+  {
+    // pathlength already there, keep the existing state
+    return;
+  }
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    _state_par[index * npar + i] = state->get_pos(i);
+    _state_par[index * npar + i + 3] = state->get_mom(i);
+  }
+  for (unsigned int i = 0; i < 6; ++i)
+  {
+    for (unsigned int j = i; j < 6; ++j)
+    {
+      _state_covar[index * ncovar + covar_index(i, j)] = state->get_error(i, j);
+    }
+  }
+  _state_cluskey[index] = state->get_cluskey();
+  _state_name_index[index] = intern_name(state->get_name());
+}
+
+unsigned int SvtxTrack_v5::find_index(float pathlength) const
+{
+  const auto iter = std::lower_bound(_state_pathlength.begin(), _state_pathlength.end(), pathlength);
+  if (iter == _state_pathlength.end() || pathlength < *iter)
+  {
+    return _state_pathlength.size();
+  }
+  return iter - _state_pathlength.begin();
+}
+
+unsigned int SvtxTrack_v5::insert_index(float pathlength)
+{
+  const auto iter = std::lower_bound(_state_pathlength.begin(), _state_pathlength.end(), pathlength);
+  const unsigned int index = iter - _state_pathlength.begin();
+  if (iter != _state_pathlength.end() && !(pathlength < *iter))
+  {
+    return index;
+  }
+
+  // same defaults as SvtxTrackState_v1
+  _state_pathlength.insert(iter, pathlength);
+  _state_par.insert(_state_par.begin() + index * npar, {0, 0, 0, NAN, NAN, NAN});
+  _state_covar.insert(_state_covar.begin() + index * ncovar, ncovar, 0.);
+  _state_cluskey.insert(_state_cluskey.begin() + index, std::numeric_limits<TrkrDefs::cluskey>::max());
+  _state_name_index.insert(_state_name_index.begin() + index, intern_name("UNKNOWN"));
+
+  if (_states_materialized)
+  {
+    for (auto proxy_iter = _states.upper_bound(pathlength); proxy_iter != _states.end(); ++proxy_iter)
+    {
+      auto proxy = static_cast<StateProxy*>(proxy_iter->second);
+      proxy->set_index(proxy->get_index() + 1);
+    }
+    _states.insert(std::make_pair(pathlength, new StateProxy(this, index)));
+  }
+
+  return index;
+}
+
+unsigned short SvtxTrack_v5::intern_name(const std::string& name)
+{
+  const auto iter = std::find(_state_names.begin(), _state_names.end(), name);
+  if (iter != _state_names.end())
+  {
+    return iter - _state_names.begin();
+  }
+  _state_names.push_back(name);
+  return _state_names.size() - 1;
+}
+
+float SvtxTrack_v5::get_pca_par(unsigned int i) const
+{
+  const auto index = find_index(0);
+  return (index < _state_pathlength.size()) ? _state_par[index * npar + i] : NAN;
+}
+
+void SvtxTrack_v5::set_pca_par(unsigned int i, float value)
+{
+  _state_par[insert_index(0) * npar + i] = value;
+}
+
+SvtxTrack::StateMap& SvtxTrack_v5::materialize_states() const
+{
+  if (!_states_materialized)
+  {
+    // the proxies modify the arrays of this track
+    auto track = const_cast<SvtxTrack_v5*>(this);
+    for (unsigned int index = 0; index < _state_pathlength.size(); ++index)
+    {
+      _states.insert(_states.end(), std::make_pair(_state_pathlength[index], new StateProxy(track, index)));
+    }
+    _states_materialized = true;
+  }
+  return _states;
+}
+
+void SvtxTrack_v5::clear_proxies()
+{
+  for (const auto& pair : _states)
+  {
+    delete pair.second;
+  }
+  _states.clear();
+  _states_materialized = false;
+}
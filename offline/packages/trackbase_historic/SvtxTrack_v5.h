@@ -0,0 +1,204 @@
+#ifndef TRACKBASEHISTORIC_SVTXTRACKV5_H
+#define TRACKBASEHISTORIC_SVTXTRACKV5_H
+
+#include "SvtxTrack.h"
+#include "SvtxTrackState.h"
+#include "TrackSeed.h"
+
+#include <trackbase/TrkrDefs.h>
+
+#include <Rtypes.h>  // for Float16_t
+
+#include <cmath>
+#include <cstddef>  // for size_t
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+class PHObject;
+
+/*!
+  \brief SvtxTrack with compact track state storage
+
+  Same content as SvtxTrack_v4, but the track states are not stored as individual
+  SvtxTrackState objects. Each state quantity is kept in its own array,
+  ordered by path length:
+  - position and momentum as 6 floats per state
+  - the 21 elements of the packed covariance matrix as Float16_t, which are written with
+    a 12 bit mantissa (relative precision 2.4e-4)
+  - the state names as index into a per track table of unique names
+  - the cluster key
+  The track parameters (pathlength = 0 state) are read straight from these arrays.
+  The SvtxTrackState interface (get_state, begin_states, ...) is only built on first use,
+  the states it returns are light weight proxies which read and write the arrays
+*/
+class SvtxTrack_v5 : public SvtxTrack
+{
+ public:
+  SvtxTrack_v5();
+
+  //* base class copy constructor
+  SvtxTrack_v5(const SvtxTrack&);
+
+  //* copy constructor
+  SvtxTrack_v5(const SvtxTrack_v5&);
+
+  //* assignment operator
+  SvtxTrack_v5& operator=(const SvtxTrack_v5& track);
+
+  //* destructor
+  ~SvtxTrack_v5() override;
+
+  // The "standard PHObject response" functions...
+  void identify(std::ostream& os = std::cout) const override;
+  void Reset() override { *this = SvtxTrack_v5(); }
+  int isValid() const override;
+  PHObject* CloneMe() const override { return new SvtxTrack_v5(*this); }
+
+  //! import PHObject CopyFrom, in order to avoid clang warning
+  using PHObject::CopyFrom;
+  // copy content from base class
+  void CopyFrom(const SvtxTrack&) override;
+  void CopyFrom(SvtxTrack* source) override
+  {
+    CopyFrom(*source);
+  }
+
+  //
+  // basic track information ---------------------------------------------------
+  //
+
+  unsigned int get_id() const override { return _track_id; }
+  void set_id(unsigned int id) override { _track_id = id; }
+
+  TrackSeed* get_tpc_seed() const override { return _tpc_seed; }
+  void set_tpc_seed(TrackSeed* seed) override { _tpc_seed = seed; }
+
+  TrackSeed* get_silicon_seed() const override { return _silicon_seed; }
+  void set_silicon_seed(TrackSeed* seed) override { _silicon_seed = seed; }
+
+  short int get_crossing() const override { return _track_crossing; }
+  void set_crossing(short int cross) override { _track_crossing = cross; }
+
+  unsigned int get_vertex_id() const override { return _vertex_id; }
+  void set_vertex_id(unsigned int id) override { _vertex_id = id; }
+
+  bool get_positive_charge() const override { return _is_positive_charge; }
+  void set_positive_charge(bool ispos) override { _is_positive_charge = ispos; }
+
+  int get_charge() const override { return (get_positive_charge()) ? 1 : -1; }
+  void set_charge(int charge) override { (charge > 0) ? set_positive_charge(true) : set_positive_charge(false); }
+
+  float get_chisq() const override { return _chisq; }
+  void set_chisq(float chisq) override { _chisq = chisq; }
+
+  unsigned int get_ndf() const override { return _ndf; }
+  void set_ndf(int ndf) override { _ndf = ndf; }
+
+  float get_quality() const override { return (_ndf != 0) ? _chisq / _ndf : NAN; }
+
+  float get_x() const override { return get_pca_par(0); }
+  void set_x(float x) override { set_pca_par(0, x); }
+
+  float get_y() const override { return get_pca_par(1); }
+  void set_y(float y) override { set_pca_par(1, y); }
+
+  float get_z() const override { return get_pca_par(2); }
+  void set_z(float z) override { set_pca_par(2, z); }
+
+  float get_pos(unsigned int i) const override { return get_pca_par(i); }
+
+  float get_px() const override { return get_pca_par(3); }
+  void set_px(float px) override { set_pca_par(3, px); }
+
+  float get_py() const override { return get_pca_par(4); }
+  void set_py(float py) override { set_pca_par(4, py); }
+
+  float get_pz() const override { return get_pca_par(5); }
+  void set_pz(float pz) override { set_pca_par(5, pz); }
+
+  float get_mom(unsigned int i) const override { return get_pca_par(i + 3); }
+
+  float get_p() const override { return sqrt(pow(get_px(), 2) + pow(get_py(), 2) + pow(get_pz(), 2)); }
+  float get_pt() const override { return sqrt(pow(get_px(), 2) + pow(get_py(), 2)); }
+  float get_eta() const override { return asinh(get_pz() / get_pt()); }
+  float get_phi() const override { return atan2(get_py(), get_px()); }
+
+  float get_error(int i, int j) const override;
+  void set_error(int i, int j, float value) override;
+
+  //
+  // state methods -------------------------------------------------------------
+  //
+  bool empty_states() const override { return _state_pathlength.empty(); }
+  size_t size_states() const override { return _state_pathlength.size(); }
+  size_t count_states(float pathlength) const override { return (find_index(pathlength) < _state_pathlength.size()) ? 1 : 0; }
+  // cppcheck-suppress virtualCallInConstructor
+  void clear_states() override;
+
+  const SvtxTrackState* get_state(float pathlength) const override;
+  SvtxTrackState* get_state(float pathlength) override;
+  SvtxTrackState* insert_state(const SvtxTrackState* state) override;
+  size_t erase_state(float pathlength) override;
+
+  ConstStateIter begin_states() const override { return materialize_states().begin(); }
+  ConstStateIter find_state(float pathlength) const override { return materialize_states().find(pathlength); }
+  ConstStateIter end_states() const override { return materialize_states().end(); }
+
+  StateIter begin_states() override { return materialize_states().begin(); }
+  StateIter find_state(float pathlength) override { return materialize_states().find(pathlength); }
+  StateIter end_states() override { return materialize_states().end(); }
+
+ private:
+  //! SvtxTrackState which reads and writes the state arrays of its track
+  class StateProxy;
+
+  //! index of the state at this path length, size_states() if there is none
+  unsigned int find_index(float pathlength) const;
+
+  //! index of the state at this path length, a default state is inserted if there is none
+  unsigned int insert_index(float pathlength);
+
+  //! copy the content of a state into the arrays, unless there is already a state at its path length
+  void copy_state(const SvtxTrackState* state);
+
+  //! index of a state name in the name table, the name is added if needed
+  unsigned short intern_name(const std::string& name);
+
+  //! position (0-2) or momentum (3-5) of the pathlength = 0 state
+  float get_pca_par(unsigned int i) const;
+  void set_pca_par(unsigned int i, float value);
+
+  //! build the proxy states for the SvtxTrackState interface
+  StateMap& materialize_states() const;
+
+  //! delete the proxy states
+  void clear_proxies();
+
+  // track information
+  TrackSeed* _tpc_seed = nullptr;
+  TrackSeed* _silicon_seed = nullptr;
+  unsigned int _track_id = UINT_MAX;
+  unsigned int _vertex_id = UINT_MAX;
+  bool _is_positive_charge = false;
+  float _chisq = NAN;
+  unsigned int _ndf = 0;
+  short int _track_crossing = SHRT_MAX;
+
+  // track state information, one entry per state, ordered by path length
+  std::vector<float> _state_pathlength;
+  std::vector<float> _state_par;  //< x, y, z, px, py, pz
+  std::vector<Float16_t> _state_covar;  //< 6x6 triangular packed storage, 21 per state
+  std::vector<TrkrDefs::cluskey> _state_cluskey;
+  std::vector<unsigned short> _state_name_index;  //< index in _state_names
+  std::vector<std::string> _state_names;  //< unique state names
+
+  // SvtxTrackState interface, built on demand
+  mutable StateMap _states;  //!
+  mutable bool _states_materialized = false;  //!
+
+  ClassDefOverride(SvtxTrack_v5, 1)
+};
+
+#endif
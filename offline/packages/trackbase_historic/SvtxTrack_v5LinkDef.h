@@ -0,0 +1,5 @@
+#ifdef __CINT__
+
+#pragma link C++ class SvtxTrack_v5 + ;
+
+#endif /* __CINT__ */
@@ -24,6 +24,7 @@
 #include <trackbase_historic/SvtxTrackMap_v2.h>
 #include <trackbase_historic/SvtxTrackState_v1.h>
 #include <trackbase_historic/SvtxTrack_v4.h>
+#include <trackbase_historic/SvtxTrack_v5.h>
 #include <trackbase_historic/TrackSeed.h>
 #include <trackbase_historic/TrackSeedContainer.h>
 
@@ -694,7 +695,7 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
           unsigned int trid = m_trackMap->size();
           svtx_vec[best_ivary].set_id(trid);
 
-          m_trackMap->insertWithKey(&svtx_vec[best_ivary], trid);
+          insertTrack(m_trackMap, &svtx_vec[best_ivary], trid);
         }
         else  // case where INTT crossing is known
         {
@@ -710,7 +711,7 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
 
             if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
             {
-              m_directedTrackMap->insertWithKey(&newTrack, trid);
+              insertTrack(m_directedTrackMap, &newTrack, trid);
             }
           }  // end insert track for SC calib fit
           else
@@ -720,7 +721,7 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
 
             if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
             {
-              m_trackMap->insertWithKey(&newTrack, trid);
+              insertTrack(m_trackMap, &newTrack, trid);
             }
           }  // end insert track for normal fit
         }    // end case where INTT crossing is known
@@ -1050,6 +1051,19 @@ void PHActsTrkFitter::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::I
   return;
 }
 
+void PHActsTrkFitter::insertTrack(SvtxTrackMap* trackMap, const SvtxTrack* track, unsigned int trid) const
+{
+  if (m_compactTrackStates)
+  {
+    const SvtxTrack_v5 compactTrack(*track);
+    trackMap->insertWithKey(&compactTrack, trid);
+  }
+  else
+  {
+    trackMap->insertWithKey(track, trid);
+  }
+}
+
 Acts::BoundSquareMatrix PHActsTrkFitter::setDefaultCovariance() const
 {
   Acts::BoundSquareMatrix cov = Acts::BoundSquareMatrix::Zero();
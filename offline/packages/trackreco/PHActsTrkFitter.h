@@ -91,6 +91,12 @@ class PHActsTrkFitter : public SubsysReco
     m_fillSvtxTrackStates = fillSvtxTrackStates;
   }
 
+  /// store the fitted tracks as SvtxTrack_v5, with compact track state storage
+  void setCompactTrackStates(bool value)
+  {
+    m_compactTrackStates = value;
+  }
+
   void useActsEvaluator(bool actsEvaluator)
   {
     m_actsEvaluator = actsEvaluator;
@@ -159,6 +165,9 @@ class PHActsTrkFitter : public SubsysReco
                          ActsTrackFittingAlgorithm::TrackContainer& tracks,
                          const ActsTrackFittingAlgorithm::MeasurementContainer& measurements);
 
+  /// insert a fitted track into the track map, converted to SvtxTrack_v5 if requested
+  void insertTrack(SvtxTrackMap* trackMap, const SvtxTrack* track, unsigned int trid) const;
+
   Acts::BoundSquareMatrix setDefaultCovariance() const;
   void printTrackSeed(const ActsTrackFittingAlgorithm::TrackParameters& seed) const;
 
@@ -196,6 +205,9 @@ class PHActsTrkFitter : public SubsysReco
   /// A bool to update the SvtxTrackState information (or not)
   bool m_fillSvtxTrackStates = true;
 
+  /// store tracks as SvtxTrack_v5
+  bool m_compactTrackStates = false;
+
   /// bool to ignore the silicon clusters in the fit
   bool m_ignoreSilicon = false;
 
@@ -323,3 +323,9 @@ void BeamLineMagnetSteppingAction::SetHitNodeName(const std::string& type, const
   gSystem->Exit(1);
   return;
 }
+
+//____________________________________________________________________________..
+bool BeamLineMagnetSteppingAction::IsInDetector(G4VPhysicalVolume* volume) const
+{
+  return m_Detector->IsInBeamLineMagnet(volume) != 0;
+}
@@ -27,6 +27,9 @@ class BeamLineMagnetSteppingAction : public PHG4SteppingAction
   //! stepping action
   bool UserSteppingAction(const G4Step*, bool) override;
 
+  //! true for volumes handled by this stepping action
+  bool IsInDetector(G4VPhysicalVolume*) const override;
+
   //! reimplemented from base class
   void SetInterfacePointers(PHCompositeNode*) override;
 
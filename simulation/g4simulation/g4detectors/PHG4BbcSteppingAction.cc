@@ -366,3 +366,9 @@ void PHG4BbcSteppingAction::SetHitNodeName(const std::string& type, const std::s
   gSystem->Exit(1);
   return;
 }
+
+//____________________________________________________________________________..
+bool PHG4BbcSteppingAction::IsInDetector(G4VPhysicalVolume* volume) const
+{
+  return m_Detector->IsInBbc(volume) != 0;
+}
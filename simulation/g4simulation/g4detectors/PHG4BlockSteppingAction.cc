@@ -290,3 +290,9 @@ void PHG4BlockSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
     std::cout << "PHG4BlockSteppingAction::SetTopNode - unable to find " << hitnodename << std::endl;
   }
 }
+
+//____________________________________________________________________________..
+bool PHG4BlockSteppingAction::IsInDetector(G4VPhysicalVolume *volume) const
+{
+  return m_Detector->IsInBlock(volume);
+}
@@ -211,3 +211,9 @@ void PHG4CEmcTestBeamSteppingAction::SetInterfacePointers(PHCompositeNode* topNo
     }
   }
 }
+
+//____________________________________________________________________________..
+bool PHG4CEmcTestBeamSteppingAction::IsInDetector(G4VPhysicalVolume* volume) const
+{
+  return detector_->IsInCEmcTestBeam(volume) != 0;
+}
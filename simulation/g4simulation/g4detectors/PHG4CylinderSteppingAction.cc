@@ -351,3 +351,9 @@ bool PHG4CylinderSteppingAction::hasMotherSubsystem() const
   }
   return false;
 }
+
+//____________________________________________________________________________..
+bool PHG4CylinderSteppingAction::IsInDetector(G4VPhysicalVolume *volume) const
+{
+  return m_Detector->IsInCylinder(volume);
+}
@@ -29,6 +29,9 @@ class PHG4CylinderSteppingAction : public PHG4SteppingAction
   //! stepping action
   bool UserSteppingAction(const G4Step *, bool) override;
 
+  //! true for volumes handled by this stepping action
+  bool IsInDetector(G4VPhysicalVolume *) const override;
+
   //! reimplemented from base class
   void SetInterfacePointers(PHCompositeNode *) override;
 
@@ -202,3 +202,9 @@ void PHG4EnvelopeSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
     std::cout << "PHG4CrystalCalorimeterSteppingAction::SetTopNode - unable to find " << hitnodename << std::endl;
   }
 }
+
+//______________________________________________________________
+bool PHG4EnvelopeSteppingAction::IsInDetector(G4VPhysicalVolume* volume) const
+{
+  return detector_->IsInEnvelope(volume);
+}
@@ -582,4 +582,10 @@ void PHG4InnerHcalSteppingAction::CreateNodeTree(PHCompositeNode* topNode)
   m_CaloInfoContainer = new TowerInfoContainerv1(TowerInfoContainer::DETECTOR::HCAL);
   PHIODataNode<PHObject>* towerNode = new PHIODataNode<PHObject>(m_CaloInfoContainer, "TOWERINFO_SIM_" + m_Detector->SuperDetector(), "PHObject");
   DetNode->addNode(towerNode);
-}
\ No newline at end of file
+}
+
+//____________________________________________________________________________..
+bool PHG4InnerHcalSteppingAction::IsInDetector(G4VPhysicalVolume *volume) const
+{
+  return m_Detector->IsInInnerHcal(volume) != 0;
+}
@@ -28,6 +28,9 @@ class PHG4InnerHcalSteppingAction : public PHG4SteppingAction
   //! stepping action
   bool UserSteppingAction(const G4Step *, bool) override;
 
+  //! true for volumes handled by this stepping action
+  bool IsInDetector(G4VPhysicalVolume *) const override;
+
   int InitWithNode(PHCompositeNode *topNode) override;
 
   //! reimplemented from base class
@@ -697,3 +697,9 @@ void PHG4OuterHcalSteppingAction::CreateNodeTree(PHCompositeNode* topNode)
   PHIODataNode<PHObject>* towerNode = new PHIODataNode<PHObject>(m_CaloInfoContainer, "TOWERINFO_SIM_" + m_Detector->SuperDetector(), "PHObject");
   DetNode->addNode(towerNode);
 }
+
+//____________________________________________________________________________..
+bool PHG4OuterHcalSteppingAction::IsInDetector(G4VPhysicalVolume *volume) const
+{
+  return m_Detector->IsInOuterHcal(volume) != 0;
+}
@@ -299,3 +299,9 @@ void PHG4PSTOFSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
     std::cout << "PHG4PSTOFSteppingAction::SetTopNode - unable to find " << hitnodename << std::endl;
   }
 }
+
+//____________________________________________________________________________..
+bool PHG4PSTOFSteppingAction::IsInDetector(G4VPhysicalVolume* volume) const
+{
+  return detector_->IsInPSTOF(volume) != 0;
+}
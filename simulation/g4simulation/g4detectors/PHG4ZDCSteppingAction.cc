@@ -544,3 +544,9 @@ double PHG4ZDCSteppingAction::ZDCEResponse(double E, double angle)
   std::cout << "out of range" << std::endl;
   return 0;
 }
+
+//____________________________________________________________________________..
+bool PHG4ZDCSteppingAction::IsInDetector(G4VPhysicalVolume* volume) const
+{
+  return m_Detector->IsInZDC(volume) != 0;
+}
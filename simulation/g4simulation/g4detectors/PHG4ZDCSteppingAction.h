@@ -13,6 +13,7 @@
 #include <string>
 
 class G4Step;
+class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4ZDCDetector;
 class PHG4Hit;
@@ -32,6 +33,9 @@ class PHG4ZDCSteppingAction : public PHG4SteppingAction
   //! stepping action
   bool UserSteppingAction(const G4Step*, bool) override;
 
+  //! true for volumes handled by this stepping action
+  bool IsInDetector(G4VPhysicalVolume*) const override;
+
   //! reimplemented from base class
   void SetInterfacePointers(PHCompositeNode*) override;
 
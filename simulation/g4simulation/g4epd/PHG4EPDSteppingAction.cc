@@ -220,3 +220,9 @@ void PHG4EPDSteppingAction::SetHitNodeName(const std::string& type, const std::s
   gSystem->Exit(1);
   return;
 }
+
+//____________________________________________________________________________..
+bool PHG4EPDSteppingAction::IsInDetector(G4VPhysicalVolume* volume) const
+{
+  return m_Detector->IsInDetector(volume) != 0;
+}
@@ -12,6 +12,7 @@
 #include <string>
 
 class G4Step;
+class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4EPDDetector;
 class PHG4Hit;
@@ -26,6 +27,9 @@ class PHG4EPDSteppingAction : public PHG4SteppingAction
 
   bool UserSteppingAction(const G4Step*, bool) override;
 
+  //! true for volumes handled by this stepping action
+  bool IsInDetector(G4VPhysicalVolume*) const override;
+
   void SetInterfacePointers(PHCompositeNode*) override;
 
   void SetHitNodeName(const std::string& type, const std::string& name) override;
@@ -2,6 +2,7 @@
 
 #include "SvtxHitEval.h"
 #include "SvtxTruthEval.h"
+#include "SvtxTruthRecoIndex.h"
 
 #include <trackbase/TrkrCluster.h>
 #include <trackbase/TrkrClusterContainer.h>
@@ -353,55 +354,16 @@ std::set<PHG4Hit*> SvtxClusterEval::all_truth_hits(TrkrDefs::cluskey cluster_key
     }
   }
 
+  // get all truth hits for this cluster from the event index
   std::set<PHG4Hit*> truth_hits;
-
-  // get all truth hits for this cluster
-  //_cluster_hit_map->identify();
-  std::pair<std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator, std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator>
-      hitrange = _cluster_hit_map->getHits(cluster_key);  // returns range of pairs {cluster key, hit key} for this cluskey
-
-  for (std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator
-           clushititer = hitrange.first;
-       clushititer != hitrange.second; ++clushititer)
+  if (_truthrecoindex)
   {
-    TrkrDefs::hitkey hitkey = clushititer->second;
-    // TrkrHitTruthAssoc uses a map with (hitsetkey, std::pair(hitkey, g4hitkey)) - get the hitsetkey from the cluskey
-    TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(cluster_key);
-
-    // get all of the g4hits for this hitkey
-    std::multimap<TrkrDefs::hitsetkey, std::pair<TrkrDefs::hitkey, PHG4HitDefs::keytype>> temp_map;
-    _hit_truth_map->getG4Hits(hitsetkey, hitkey, temp_map);
-    // returns pairs (hitsetkey, std::pair(hitkey, g4hitkey)) for this hitkey only
-
-    for (auto& htiter : temp_map)
+    const auto range = _truthrecoindex->g4hits_from_cluster(cluster_key);
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
-      // extract the g4 hit key here and add the hits to the set
-      PHG4HitDefs::keytype g4hitkey = htiter.second.second;
-      PHG4Hit* g4hit = nullptr;
-      unsigned int trkrid = TrkrDefs::getTrkrId(hitsetkey);
-      switch (trkrid)
-      {
-      case TrkrDefs::tpcId:
-        g4hit = _g4hits_tpc->findHit(g4hitkey);
-        break;
-      case TrkrDefs::inttId:
-        g4hit = _g4hits_intt->findHit(g4hitkey);
-        break;
-      case TrkrDefs::mvtxId:
-        g4hit = _g4hits_mvtx->findHit(g4hitkey);
-        break;
-      case TrkrDefs::micromegasId:
-        g4hit = _g4hits_mms->findHit(g4hitkey);
-        break;
-      default:
-        break;
-      }
-      if (g4hit)
-      {
-        truth_hits.insert(g4hit);
-      }
-    }  // end loop over g4hits associated with hitsetkey and hitkey
-  }    // end loop over hits associated with cluskey
+      truth_hits.insert(iter->second);
+    }
+  }
 
   if (_do_cache)
   {
@@ -962,23 +924,11 @@ void SvtxClusterEval::FillRecoClusterFromG4HitCache()
   Mytimer->stop();
   Mytimer->restart();
 
-  std::multimap<PHG4Particle*, TrkrDefs::cluskey> temp_clusters_from_particles;
-  // loop over all the clusters
-  for (const auto& hitsetkey : _clustermap->getHitSetKeys())
+  if (!_truthrecoindex)
   {
-    auto range = _clustermap->getClusters(hitsetkey);
-    for (auto iter = range.first; iter != range.second; ++iter)
-    {
-      TrkrDefs::cluskey cluster_key = iter->first;
-
-      // loop over all truth particles connected to this cluster
-      std::set<PHG4Particle*> particles = all_truth_particles(cluster_key);
-      for (auto candidate : particles)
-      {
-        temp_clusters_from_particles.insert(std::make_pair(candidate, cluster_key));
-      }
-    }
+    return;
   }
+
   // Loop over particles and fill cache
   PHG4TruthInfoContainer::ConstRange range = _truthinfo->GetParticleRange();
   for (PHG4TruthInfoContainer::ConstIterator iter = range.first;
@@ -986,13 +936,10 @@ void SvtxClusterEval::FillRecoClusterFromG4HitCache()
   {
     PHG4Particle* g4particle = iter->second;
     std::set<TrkrDefs::cluskey> clusters;
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator lower_bound = temp_clusters_from_particles.lower_bound(g4particle);
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator upper_bound = temp_clusters_from_particles.upper_bound(g4particle);
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator cfp_iter;
-    for (cfp_iter = lower_bound; cfp_iter != upper_bound; ++cfp_iter)
+    const auto cluster_range = _truthrecoindex->clusters_from_particle(g4particle->get_track_id());
+    for (auto cfp_iter = cluster_range.first; cfp_iter != cluster_range.second; ++cfp_iter)
     {
-      TrkrDefs::cluskey cluster_key = cfp_iter->second;
-      clusters.insert(cluster_key);
+      clusters.insert(cfp_iter->second);
     }
     _cache_all_clusters_from_particle.insert(std::make_pair(g4particle, clusters));
   }
@@ -1018,110 +965,37 @@ std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Hit* truthhit
     return std::set<TrkrDefs::cluskey>();
   }
 
-  // one time, fill cache of g4hit/cluster pairs
-  if (_cache_all_clusters_from_g4hit.size() == 0)
+  if (_do_cache)
   {
-    // make a map of truthhit, cluster_key inside this loop
-    std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey> truth_cluster_map;
-    std::set<PHG4HitDefs::keytype> all_g4hits_set;
-    std::map<PHG4HitDefs::keytype, PHG4Hit*> all_g4hits_map;
-
-    // get all reco clusters
-    if (_verbosity > 1)
+    std::map<PHG4Hit*, std::set<TrkrDefs::cluskey>>::iterator iter =
+        _cache_all_clusters_from_g4hit.find(truthhit);
+    if (iter != _cache_all_clusters_from_g4hit.end())
     {
-      std::cout << "all_clusters_from_g4hit: list all reco clusters " << std::endl;
-    }
-
-    for (const auto& hitsetkey : _clustermap->getHitSetKeys())
-    {
-      auto range = _clustermap->getClusters(hitsetkey);
-      for (auto iter = range.first; iter != range.second; ++iter)
-      {
-        TrkrDefs::cluskey cluster_key = iter->first;
-        int layer = TrkrDefs::getLayer(cluster_key);
-        TrkrCluster* clus = iter->second;
-        if (_verbosity > 1)
-        {
-          std::cout << " layer " << layer << " cluster_key " << cluster_key << " adc " << clus->getAdc()
-                    << " localx " << clus->getLocalX()
-                    << " localy " << clus->getLocalY()
-                    << std::endl;
-          std::cout << "  associated hits:";
-          std::pair<std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator, std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator>
-              hitrange = _cluster_hit_map->getHits(cluster_key);  // returns range of pairs {cluster key, hit key} for this cluskey
-          for (std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator
-                   clushititer = hitrange.first;
-               clushititer != hitrange.second; ++clushititer)
-          {
-            TrkrDefs::hitkey hitkey = clushititer->second;
-            std::cout << " " << hitkey;
-          }
-          std::cout << std::endl;
-        }
-
-        // the returned truth hits were obtained from TrkrAssoc maps
-        std::set<PHG4Hit*> hits = all_truth_hits(cluster_key);
-        for (auto candidate : hits)
-        {
-          PHG4HitDefs::keytype g4hit_key = candidate->get_hit_id();
-
-          if (_verbosity > 5)
-          {
-            int gtrackID = candidate->get_trkid();
-            std::cout << "   adding cluster with cluster_key " << cluster_key << " g4hit with g4hit_key " << g4hit_key
-                      << " gtrackID " << gtrackID
-                      << std::endl;
-          }
-
-          all_g4hits_set.insert(g4hit_key);
-          all_g4hits_map.insert(std::make_pair(g4hit_key, candidate));
-
-          truth_cluster_map.insert(std::make_pair(g4hit_key, cluster_key));
-        }
-      }
+      return iter->second;
     }
+  }
 
-    // now fill the cache
-    // loop over all entries in all_g4hits
-    for (unsigned long long g4hit_key : all_g4hits_set)
+  // get the clusters from the event index
+  std::set<TrkrDefs::cluskey> clusters;
+  if (_truthrecoindex)
+  {
+    const auto range = _truthrecoindex->clusters_from_g4hit(truthhit);
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
       if (_verbosity > 5)
       {
-        std::cout << " associations for g4hit_key " << g4hit_key << std::endl;
+        std::cout << "             g4hit_key " << truthhit->get_hit_id() << " associated with cluster_key " << iter->second << std::endl;
       }
-
-      std::map<PHG4HitDefs::keytype, PHG4Hit*>::iterator it = all_g4hits_map.find(g4hit_key);
-      PHG4Hit* g4hit = it->second;
-
-      std::set<TrkrDefs::cluskey> assoc_clusters;
-
-      std::pair<std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator,
-                std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator>
-          ret = truth_cluster_map.equal_range(g4hit_key);
-      for (std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator jter = ret.first; jter != ret.second; ++jter)
-      {
-        assoc_clusters.insert(jter->second);
-
-        if (_verbosity > 5)
-        {
-          std::cout << "             g4hit_key " << g4hit_key << " associated with cluster_key " << jter->second << std::endl;
-        }
-      }
-      // done with this g4hit
-      _cache_all_clusters_from_g4hit.insert(std::make_pair(g4hit, assoc_clusters));
+      clusters.insert(iter->second);
     }
   }
 
-  // get the clusters
-  std::set<TrkrDefs::cluskey> clusters;
-  std::map<PHG4Hit*, std::set<TrkrDefs::cluskey>>::iterator iter =
-      _cache_all_clusters_from_g4hit.find(truthhit);
-  if (iter != _cache_all_clusters_from_g4hit.end())
+  if (_do_cache)
   {
-    return iter->second;
+    _cache_all_clusters_from_g4hit.insert(std::make_pair(truthhit, clusters));
   }
 
-  if (_clusters_per_layer.size() == 0)
+  if (clusters.empty() && _clusters_per_layer.size() == 0)
   {
     fill_cluster_layer_map();
   }
@@ -1287,14 +1161,11 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     }
   }
 
+  // summed g4hit energy of this particle in the cluster, from the event index
   float energy = 0.0;
-  std::set<PHG4Hit*> hits = all_truth_hits(cluster_key);
-  for (auto hit : hits)
+  if (_truthrecoindex)
   {
-    if (get_truth_eval()->is_g4hit_from_particle(hit, particle))
-    {
-      energy += hit->get_edep();
-    }
+    energy = _truthrecoindex->get_energy_contribution(cluster_key, particle->get_track_id());
   }
 
   if (_do_cache)
@@ -1382,6 +1253,8 @@ void SvtxClusterEval::get_node_pointers(PHCompositeNode* topNode)
   _g4hits_mms = findNode::getClass<PHG4HitContainer>(topNode, "G4HIT_MICROMEGAS");
   _tgeometry = findNode::getClass<ActsGeometry>(topNode, "ActsGeometry");
 
+  _truthrecoindex = SvtxTruthRecoIndex::GetIndex(topNode);
+
   return;
 }
 
@@ -23,6 +23,7 @@ class TrkrClusterContainer;
 class TrkrClusterHitAssoc;
 class TrkrHitTruthAssoc;
 class SvtxTruthEval;
+class SvtxTruthRecoIndex;
 
 typedef std::multimap<float, TrkrDefs::cluskey> innerMap;
 
@@ -106,6 +107,9 @@ class SvtxClusterEval
   PHG4HitContainer* _g4hits_mms = nullptr;
   ActsGeometry* _tgeometry = nullptr;
 
+  //! shared event level truth <-> reco index
+  SvtxTruthRecoIndex* _truthrecoindex = nullptr;
+
   bool _strict = false;
   int _verbosity = 0;
   unsigned int _errors = 0;
@@ -1,6 +1,7 @@
 #include "SvtxTruthEval.h"
 
 #include "BaseTruthEval.h"
+#include "SvtxTruthRecoIndex.h"
 
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
@@ -165,11 +166,6 @@ std::set<PHG4Hit*> SvtxTruthEval::all_truth_hits(PHG4Particle* particle)
     ++_errors;
     return std::set<PHG4Hit*>();
   }
-  //  if( _cache_all_truth_hits_g4particle.count(particle)==0){
-  if (_cache_all_truth_hits_g4particle.empty())
-  {
-    FillTruthHitsFromParticleCache();
-  }
 
   if (_do_cache)
   {
@@ -180,61 +176,31 @@ std::set<PHG4Hit*> SvtxTruthEval::all_truth_hits(PHG4Particle* particle)
       return iter->second;
     }
   }
-  // return empty if we dont find anything int he cache
 
+  // get the g4hits of this particle from the event index
   std::set<PHG4Hit*> truth_hits;
-  return truth_hits;
-}
-
-void SvtxTruthEval::FillTruthHitsFromParticleCache()
-{
-  std::multimap<const int, PHG4Hit*> temp_clusters_from_particles;
-  // loop over all the g4hits in the cylinder layers
-  if (_g4hits_svtx)
+  if (_truthrecoindex)
   {
-    for (PHG4HitContainer::ConstIterator g4iter = _g4hits_svtx->getHits().first;
-         g4iter != _g4hits_svtx->getHits().second;
-         ++g4iter)
+    const auto range = _truthrecoindex->g4hits_from_particle(particle->get_track_id());
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
-      PHG4Hit* g4hit = g4iter->second;
-      temp_clusters_from_particles.insert(std::make_pair(g4hit->get_trkid(), g4hit));
+      truth_hits.insert(iter->second);
     }
   }
 
-  // loop over all the g4hits in the ladder layers
-  if (_g4hits_tracker)
+  if (_do_cache)
   {
-    for (PHG4HitContainer::ConstIterator g4iter = _g4hits_tracker->getHits().first;
-         g4iter != _g4hits_tracker->getHits().second;
-         ++g4iter)
-    {
-      PHG4Hit* g4hit = g4iter->second;
-      temp_clusters_from_particles.insert(std::make_pair(g4hit->get_trkid(), g4hit));
-    }
+    _cache_all_truth_hits_g4particle.insert(std::make_pair(particle, truth_hits));
   }
 
-  // loop over all the g4hits in the maps ladder layers
-  if (_g4hits_maps)
-  {
-    for (PHG4HitContainer::ConstIterator g4iter = _g4hits_maps->getHits().first;
-         g4iter != _g4hits_maps->getHits().second;
-         ++g4iter)
-    {
-      PHG4Hit* g4hit = g4iter->second;
-      temp_clusters_from_particles.insert(std::make_pair(g4hit->get_trkid(), g4hit));
-    }
-  }
+  return truth_hits;
+}
 
-  // loop over all the g4hits in the micromegas layers
-  if (_g4hits_mms)
+void SvtxTruthEval::FillTruthHitsFromParticleCache()
+{
+  if (!_truthrecoindex)
   {
-    for (PHG4HitContainer::ConstIterator g4iter = _g4hits_mms->getHits().first;
-         g4iter != _g4hits_mms->getHits().second;
-         ++g4iter)
-    {
-      PHG4Hit* g4hit = g4iter->second;
-      temp_clusters_from_particles.insert(std::make_pair(g4hit->get_trkid(), g4hit));
-    }
+    return;
   }
 
   PHG4TruthInfoContainer::ConstRange range = _truthinfo->GetParticleRange();
@@ -243,13 +209,10 @@ void SvtxTruthEval::FillTruthHitsFromParticleCache()
   {
     PHG4Particle* g4particle = iter->second;
     std::set<PHG4Hit*> truth_hits;
-    std::multimap<const int, PHG4Hit*>::const_iterator lower_bound = temp_clusters_from_particles.lower_bound(g4particle->get_track_id());
-    std::multimap<const int, PHG4Hit*>::const_iterator upper_bound = temp_clusters_from_particles.upper_bound(g4particle->get_track_id());
-    std::multimap<const int, PHG4Hit*>::const_iterator cfp_iter;
-    for (cfp_iter = lower_bound; cfp_iter != upper_bound; ++cfp_iter)
+    const auto g4hitrange = _truthrecoindex->g4hits_from_particle(g4particle->get_track_id());
+    for (auto g4iter = g4hitrange.first; g4iter != g4hitrange.second; ++g4iter)
     {
-      PHG4Hit* g4hit = cfp_iter->second;
-      truth_hits.insert(g4hit);
+      truth_hits.insert(g4iter->second);
     }
     _cache_all_truth_hits_g4particle.insert(std::make_pair(g4particle, truth_hits));
   }
@@ -1132,6 +1095,8 @@ void SvtxTruthEval::get_node_pointers(PHCompositeNode* topNode)
   _g4hits_tracker = findNode::getClass<PHG4HitContainer>(topNode, "G4HIT_INTT");
   _g4hits_maps = findNode::getClass<PHG4HitContainer>(topNode, "G4HIT_MVTX");
 
+  _truthrecoindex = SvtxTruthRecoIndex::GetIndex(topNode);
+
   _mms_geom_container = findNode::getClass<PHG4CylinderGeomContainer>(topNode, "CYLINDERGEOM_MICROMEGAS_FULL");
   _tpc_geom_container = findNode::getClass<PHG4TpcCylinderGeomContainer>(topNode, "CYLINDERCELLGEOM_SVTX");
   _intt_geom_container = findNode::getClass<PHG4CylinderGeomContainer>(topNode, "CYLINDERGEOM_INTT");
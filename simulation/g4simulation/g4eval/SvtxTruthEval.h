@@ -14,6 +14,7 @@ class PHG4TruthInfoContainer;
 class PHG4CylinderGeomContainer;
 class PHG4TpcCylinderGeomContainer;
 class PHG4VtxPoint;
+class SvtxTruthRecoIndex;
 class TrkrCluster;
 class ActsGeometry;
 
@@ -85,6 +86,9 @@ class SvtxTruthEval
   PHG4HitContainer* _g4hits_tracker = nullptr;
   PHG4HitContainer* _g4hits_maps = nullptr;
 
+  //! shared event level truth <-> reco index
+  SvtxTruthRecoIndex* _truthrecoindex = nullptr;
+
   PHG4TpcCylinderGeomContainer* _tpc_geom_container{};
   PHG4CylinderGeomContainer* _intt_geom_container{};
   PHG4CylinderGeomContainer* _mvtx_geom_container{};
@@ -0,0 +1,281 @@
+#include "SvtxTruthRecoIndex.h"
+
+#include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrClusterHitAssoc.h>
+#include <trackbase/TrkrDefs.h>
+#include <trackbase/TrkrHitTruthAssoc.h>
+
+#include <g4main/PHG4Hit.h>
+#include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4HitDefs.h>
+
+#include <fun4all/Fun4AllServer.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace
+{
+  //! hit (hitset key, hit key) to g4hit
+  using HitKey = std::pair<TrkrDefs::hitsetkey, TrkrDefs::hitkey>;
+  using HitG4Hit = std::pair<HitKey, PHG4Hit*>;
+
+  const std::string indexnodename = "SVTX_TRUTHRECO_INDEX";
+
+  //! sort by key and remove duplicated (key, value) pairs
+  template <class T>
+  void sort_unique(std::vector<T>& table)
+  {
+    std::sort(table.begin(), table.end());
+    table.erase(std::unique(table.begin(), table.end()), table.end());
+  }
+}  // namespace
+
+SvtxTruthRecoIndex* SvtxTruthRecoIndex::GetIndex(PHCompositeNode* topNode)
+{
+  SvtxTruthRecoIndex* index = findNode::getClass<SvtxTruthRecoIndex>(topNode, indexnodename);
+  if (!index)
+  {
+    PHNodeIterator iter(topNode);
+    PHCompositeNode* runNode = dynamic_cast<PHCompositeNode*>(iter.findFirst("PHCompositeNode", "RUN"));
+    if (!runNode)
+    {
+      std::cout << PHWHERE << " RUN node missing, cannot store " << indexnodename << std::endl;
+      return nullptr;
+    }
+    index = new SvtxTruthRecoIndex;
+    runNode->addNode(new PHDataNode<SvtxTruthRecoIndex>(index, indexnodename));
+  }
+  index->m_TopNode = topNode;
+  return index;
+}
+
+void SvtxTruthRecoIndex::update()
+{
+  const Fun4AllServer* se = Fun4AllServer::instance();
+  if (se->RunNumber() != m_RunNumber || se->EventCounter() != m_EventCounter)
+  {
+    build();
+  }
+}
+
+void SvtxTruthRecoIndex::build()
+{
+  const Fun4AllServer* se = Fun4AllServer::instance();
+  m_RunNumber = se->RunNumber();
+  m_EventCounter = se->EventCounter();
+
+  m_ParticleG4Hits.clear();
+  m_ClusterG4Hits.clear();
+  m_G4HitClusters.clear();
+  m_ClusterParticles.clear();
+  m_ParticleClusters.clear();
+
+  if (!m_TopNode)
+  {
+    return;
+  }
+
+  // g4hit containers, per tracker id
+  std::map<unsigned int, PHG4HitContainer*> g4hitcontainers;
+  g4hitcontainers[TrkrDefs::mvtxId] = findNode::getClass<PHG4HitContainer>(m_TopNode, "G4HIT_MVTX");
+  g4hitcontainers[TrkrDefs::inttId] = findNode::getClass<PHG4HitContainer>(m_TopNode, "G4HIT_INTT");
+  g4hitcontainers[TrkrDefs::tpcId] = findNode::getClass<PHG4HitContainer>(m_TopNode, "G4HIT_TPC");
+  g4hitcontainers[TrkrDefs::micromegasId] = findNode::getClass<PHG4HitContainer>(m_TopNode, "G4HIT_MICROMEGAS");
+
+  auto find_g4hit = [&g4hitcontainers](const TrkrDefs::hitsetkey hitsetkey, const PHG4HitDefs::keytype g4hitkey) -> PHG4Hit*
+  {
+    const auto iter = g4hitcontainers.find(TrkrDefs::getTrkrId(hitsetkey));
+    return (iter == g4hitcontainers.end() || !iter->second) ? nullptr : iter->second->findHit(g4hitkey);
+  };
+
+  // particle -> g4hits
+  for (const auto& [trkrid, container] : g4hitcontainers)
+  {
+    if (!container)
+    {
+      continue;
+    }
+    const auto range = container->getHits();
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      m_ParticleG4Hits.emplace_back(iter->second->get_trkid(), iter->second);
+    }
+  }
+  sort_unique(m_ParticleG4Hits);
+
+  // reco side
+  TrkrClusterContainer* clustermap = findNode::getClass<TrkrClusterContainer>(m_TopNode, "CORRECTED_TRKR_CLUSTER");
+  if (!clustermap || clustermap->size() == 0)
+  {
+    clustermap = findNode::getClass<TrkrClusterContainer>(m_TopNode, "TRKR_CLUSTER");
+  }
+  TrkrClusterHitAssoc* cluster_hit_map = findNode::getClass<TrkrClusterHitAssoc>(m_TopNode, "TRKR_CLUSTERHITASSOC");
+  TrkrHitTruthAssoc* hit_truth_map = findNode::getClass<TrkrHitTruthAssoc>(m_TopNode, "TRKR_HITTRUTHASSOC");
+  if (!clustermap || !cluster_hit_map || !hit_truth_map)
+  {
+    if (m_Verbosity)
+    {
+      std::cout << PHWHERE << " reco or association nodes missing, only particle -> g4hits is filled" << std::endl;
+    }
+    return;
+  }
+
+  // hit -> g4hits, in one pass over the association map when available
+  std::vector<HitG4Hit> hit_g4hits;
+  const TrkrHitTruthAssoc::MMap* hit_truth_mmap = hit_truth_map->getMap();
+  if (hit_truth_mmap)
+  {
+    hit_g4hits.reserve(hit_truth_mmap->size());
+    for (const auto& [hitsetkey, assoc] : *hit_truth_mmap)
+    {
+      PHG4Hit* g4hit = find_g4hit(hitsetkey, assoc.second);
+      if (g4hit)
+      {
+        hit_g4hits.emplace_back(HitKey(hitsetkey, assoc.first), g4hit);
+      }
+      else if (m_Verbosity)
+      {
+        std::cout << "SvtxTruthRecoIndex::build - g4hit not found " << assoc.second << std::endl;
+      }
+    }
+    sort_unique(hit_g4hits);
+  }
+
+  // cluster -> g4hits
+  for (const auto& hitsetkey : clustermap->getHitSetKeys())
+  {
+    const auto range = clustermap->getClusters(hitsetkey);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      const TrkrDefs::cluskey ckey = iter->first;
+      const auto hitrange = cluster_hit_map->getHits(ckey);
+      for (auto hititer = hitrange.first; hititer != hitrange.second; ++hititer)
+      {
+        const TrkrDefs::hitkey hitkey = hititer->second;
+        if (hit_truth_mmap)
+        {
+          const auto g4range = equal_range(hit_g4hits, HitKey(hitsetkey, hitkey));
+          for (auto g4iter = g4range.first; g4iter != g4range.second; ++g4iter)
+          {
+            m_ClusterG4Hits.emplace_back(ckey, g4iter->second);
+          }
+        }
+        else
+        {
+          TrkrHitTruthAssoc::MMap temp_map;
+          hit_truth_map->getG4Hits(hitsetkey, hitkey, temp_map);
+          for (const auto& [key, assoc] : temp_map)
+          {
+            PHG4Hit* g4hit = find_g4hit(hitsetkey, assoc.second);
+            if (g4hit)
+            {
+              m_ClusterG4Hits.emplace_back(ckey, g4hit);
+            }
+          }
+        }
+      }
+    }
+  }
+  sort_unique(m_ClusterG4Hits);
+
+  // inverted tables
+  m_G4HitClusters.reserve(m_ClusterG4Hits.size());
+  m_ParticleClusters.reserve(m_ClusterG4Hits.size());
+  for (const auto& [ckey, g4hit] : m_ClusterG4Hits)
+  {
+    m_G4HitClusters.emplace_back(g4hit, ckey);
+    m_ParticleClusters.emplace_back(g4hit->get_trkid(), ckey);
+
+    // energy weights, the g4hits of a cluster are contiguous
+    const int trkid = g4hit->get_trkid();
+    auto contrib = std::find_if(m_ClusterParticles.rbegin(), m_ClusterParticles.rend(),
+                                [ckey, trkid](const std::pair<TrkrDefs::cluskey, Contribution>& entry)
+                                { return entry.first != ckey || entry.second.trkid == trkid; });
+    if (contrib != m_ClusterParticles.rend() && contrib->first == ckey)
+    {
+      contrib->second.edep += g4hit->get_edep();
+    }
+    else
+    {
+      m_ClusterParticles.emplace_back(ckey, Contribution{trkid, static_cast<float>(g4hit->get_edep())});
+    }
+  }
+  sort_unique(m_G4HitClusters);
+  sort_unique(m_ParticleClusters);
+  std::stable_sort(m_ClusterParticles.begin(), m_ClusterParticles.end(),
+                   [](const std::pair<TrkrDefs::cluskey, Contribution>& lhs, const std::pair<TrkrDefs::cluskey, Contribution>& rhs)
+                   { return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.second.trkid < rhs.second.trkid); });
+
+  if (m_Verbosity)
+  {
+    std::cout << "SvtxTruthRecoIndex::build -"
+              << " particle g4hits: " << m_ParticleG4Hits.size()
+              << " cluster g4hits: " << m_ClusterG4Hits.size()
+              << " cluster particles: " << m_ClusterParticles.size()
+              << std::endl;
+  }
+}
+
+template <class K, class V>
+SvtxTruthRecoIndex::Range<std::pair<K, V>> SvtxTruthRecoIndex::equal_range(const std::vector<std::pair<K, V>>& table, const K& key)
+{
+  const auto lower = std::lower_bound(table.begin(), table.end(), key,
+                                      [](const std::pair<K, V>& entry, const K& value)
+                                      { return entry.first < value; });
+  const auto upper = std::upper_bound(lower, table.end(), key,
+                                      [](const K& value, const std::pair<K, V>& entry)
+                                      { return value < entry.first; });
+  return std::make_pair(lower, upper);
+}
+
+SvtxTruthRecoIndex::Range<std::pair<int, PHG4Hit*>> SvtxTruthRecoIndex::g4hits_from_particle(const int trkid)
+{
+  update();
+  return equal_range(m_ParticleG4Hits, trkid);
+}
+
+SvtxTruthRecoIndex::Range<std::pair<TrkrDefs::cluskey, PHG4Hit*>> SvtxTruthRecoIndex::g4hits_from_cluster(const TrkrDefs::cluskey ckey)
+{
+  update();
+  return equal_range(m_ClusterG4Hits, ckey);
+}
+
+SvtxTruthRecoIndex::Range<std::pair<PHG4Hit*, TrkrDefs::cluskey>> SvtxTruthRecoIndex::clusters_from_g4hit(PHG4Hit* g4hit)
+{
+  update();
+  return equal_range(m_G4HitClusters, g4hit);
+}
+
+SvtxTruthRecoIndex::Range<std::pair<TrkrDefs::cluskey, SvtxTruthRecoIndex::Contribution>> SvtxTruthRecoIndex::particles_from_cluster(const TrkrDefs::cluskey ckey)
+{
+  update();
+  return equal_range(m_ClusterParticles, ckey);
+}
+
+SvtxTruthRecoIndex::Range<std::pair<int, TrkrDefs::cluskey>> SvtxTruthRecoIndex::clusters_from_particle(const int trkid)
+{
+  update();
+  return equal_range(m_ParticleClusters, trkid);
+}
+
+float SvtxTruthRecoIndex::get_energy_contribution(const TrkrDefs::cluskey ckey, const int trkid)
+{
+  const auto range = particles_from_cluster(ckey);
+  for (auto iter = range.first; iter != range.second; ++iter)
+  {
+    if (iter->second.trkid == trkid)
+    {
+      return iter->second.edep;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,92 @@
+#ifndef G4EVAL_SVTXTRUTHRECOINDEX_H
+#define G4EVAL_SVTXTRUTHRECOINDEX_H
+
+#include <trackbase/TrkrDefs.h>
+
+#include <utility>
+#include <vector>
+
+class PHCompositeNode;
+class PHG4Hit;
+
+/*! \class SvtxTruthRecoIndex
+    \brief event level truth <-> reco lookup tables for the tracking evaluators
+
+    All associations between truth particles (g4 track ids), g4hits and reco clusters
+    are built in one pass over the g4hit containers, TRKR_HITTRUTHASSOC and
+    TRKR_CLUSTERHITASSOC, and stored as flat vectors of (key, value) pairs sorted by key:
+    - particle -> g4hits
+    - cluster -> g4hits (unique, sorted by pointer like std::set<PHG4Hit*>)
+    - g4hit -> clusters
+    - cluster -> particles, with the energy deposited by each particle
+    - particle -> clusters
+    The index lives in a (transient) PHDataNode on the RUN node, so all evaluators
+    (SvtxTruthEval, SvtxClusterEval, TrackEvaluation) share it. Use GetIndex() to access it,
+    the tables are rebuilt on first access in every event.
+*/
+class SvtxTruthRecoIndex
+{
+ public:
+  //! particle energy deposit in a cluster
+  struct Contribution
+  {
+    int trkid = 0;
+    float edep = 0;
+  };
+
+  //! range of values in one of the tables
+  template <class T>
+  using Range = std::pair<typename std::vector<T>::const_iterator, typename std::vector<T>::const_iterator>;
+
+  SvtxTruthRecoIndex() = default;
+  virtual ~SvtxTruthRecoIndex() = default;
+
+  //! get the index for this topNode, it is created if needed.
+  //! Returns nullptr if the RUN node is missing
+  static SvtxTruthRecoIndex* GetIndex(PHCompositeNode* topNode);
+
+  //! g4hits from particle with this g4 track id
+  Range<std::pair<int, PHG4Hit*>> g4hits_from_particle(const int trkid);
+
+  //! g4hits contributing to a cluster
+  Range<std::pair<TrkrDefs::cluskey, PHG4Hit*>> g4hits_from_cluster(const TrkrDefs::cluskey ckey);
+
+  //! clusters a g4hit contributes to
+  Range<std::pair<PHG4Hit*, TrkrDefs::cluskey>> clusters_from_g4hit(PHG4Hit* g4hit);
+
+  //! particles contributing to a cluster, with their energy deposit, sorted by track id
+  Range<std::pair<TrkrDefs::cluskey, Contribution>> particles_from_cluster(const TrkrDefs::cluskey ckey);
+
+  //! clusters a particle contributes to
+  Range<std::pair<int, TrkrDefs::cluskey>> clusters_from_particle(const int trkid);
+
+  //! energy deposited by particle trkid in a cluster
+  float get_energy_contribution(const TrkrDefs::cluskey ckey, const int trkid);
+
+  //! rebuild the tables now
+  void build();
+
+  void Verbosity(const int verbosity) { m_Verbosity = verbosity; }
+
+ private:
+  //! rebuild the tables if this is a new event
+  void update();
+
+  template <class K, class V>
+  static Range<std::pair<K, V>> equal_range(const std::vector<std::pair<K, V>>& table, const K& key);
+
+  PHCompositeNode* m_TopNode = nullptr;
+  int m_Verbosity = 0;
+
+  //! run and event counter the tables were built for
+  int m_RunNumber = 0;
+  int m_EventCounter = -1;
+
+  std::vector<std::pair<int, PHG4Hit*>> m_ParticleG4Hits;
+  std::vector<std::pair<TrkrDefs::cluskey, PHG4Hit*>> m_ClusterG4Hits;
+  std::vector<std::pair<PHG4Hit*, TrkrDefs::cluskey>> m_G4HitClusters;
+  std::vector<std::pair<TrkrDefs::cluskey, Contribution>> m_ClusterParticles;
+  std::vector<std::pair<int, TrkrDefs::cluskey>> m_ParticleClusters;
+};
+
+#endif  // G4EVAL_SVTXTRUTHRECOINDEX_H
@@ -5,6 +5,8 @@
 
 #include "TrackEvaluation.h"
 
+#include "SvtxTruthRecoIndex.h"
+
 #include <g4detectors/PHG4CylinderGeomContainer.h>
 #include <g4detectors/PHG4TpcCylinderGeom.h>
 #include <g4detectors/PHG4TpcCylinderGeomContainer.h>
@@ -476,6 +478,9 @@ int TrackEvaluation::load_nodes(PHCompositeNode* topNode)
   // g4 truth info
   m_g4truthinfo = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
 
+  // shared truth <-> reco index
+  m_truthrecoindex = SvtxTruthRecoIndex::GetIndex(topNode);
+
   // tpc geometry
   m_tpc_geom_container = findNode::getClass<PHG4TpcCylinderGeomContainer>(topNode, "CYLINDERCELLGEOM_SVTX");
   assert(m_tpc_geom_container);
@@ -675,63 +680,14 @@ TrackEvaluation::G4HitSet TrackEvaluation::find_g4hits(TrkrDefs::cluskey cluster
     return map_iter->second;
   }
 
-  // find hitset associated to cluster
+  // get g4hits associated to cluster from the event index
   G4HitSet out;
-  const auto hitset_key = TrkrDefs::getHitSetKeyFromClusKey(cluster_key);
-  for (const auto& [first, hit_key] : range_adaptor(m_cluster_hit_map->getHits(cluster_key)))
+  if (m_truthrecoindex)
   {
-    // store hits to g4hit associations
-    TrkrHitTruthAssoc::MMap g4hit_map;
-    m_hit_truth_map->getG4Hits(hitset_key, hit_key, g4hit_map);
-
-    // find corresponding g4 hist
-    for (auto& truth_iter : g4hit_map)
+    const auto range = m_truthrecoindex->g4hits_from_cluster(cluster_key);
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
-      const auto g4hit_key = truth_iter.second.second;
-      PHG4Hit* g4hit = nullptr;
-
-      switch (TrkrDefs::getTrkrId(hitset_key))
-      {
-      case TrkrDefs::mvtxId:
-        if (m_g4hits_mvtx)
-        {
-          g4hit = m_g4hits_mvtx->findHit(g4hit_key);
-        }
-        break;
-
-      case TrkrDefs::inttId:
-        if (m_g4hits_intt)
-        {
-          g4hit = m_g4hits_intt->findHit(g4hit_key);
-        }
-        break;
-
-      case TrkrDefs::tpcId:
-        if (m_g4hits_tpc)
-        {
-          g4hit = m_g4hits_tpc->findHit(g4hit_key);
-        }
-        break;
-
-      case TrkrDefs::micromegasId:
-        if (m_g4hits_micromegas)
-        {
-          g4hit = m_g4hits_micromegas->findHit(g4hit_key);
-        }
-        break;
-
-      default:
-        break;
-      }
-
-      if (g4hit)
-      {
-        out.insert(g4hit);
-      }
-      else
-      {
-        std::cout << "TrackEvaluation::find_g4hits - g4hit not found " << g4hit_key << std::endl;
-      }
+      out.insert(iter->second);
     }
   }
 
@@ -29,6 +29,7 @@ class PHG4Particle;
 class PHG4TruthInfoContainer;
 class SvtxTrack;
 class SvtxTrackMap;
+class SvtxTruthRecoIndex;
 class TrkrCluster;
 class TrkrClusterContainer;
 class TrkrClusterHitAssoc;
@@ -148,6 +149,9 @@ class TrackEvaluation : public SubsysReco
   //! truth information
   PHG4TruthInfoContainer* m_g4truthinfo = nullptr;
 
+  //! shared truth <-> reco index
+  SvtxTruthRecoIndex* m_truthrecoindex = nullptr;
+
   //! tpc geometry
   PHG4TpcCylinderGeomContainer* m_tpc_geom_container = nullptr;
 
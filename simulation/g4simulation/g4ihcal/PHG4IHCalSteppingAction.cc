@@ -615,3 +615,9 @@ void PHG4IHCalSteppingAction::CreateNodeTree(PHCompositeNode* topNode)
   PHIODataNode<PHObject>* towerNode = new PHIODataNode<PHObject>(m_CaloInfoContainer, "TOWERINFO_SIM_" + m_Detector->SuperDetector(), "PHObject");
   DetNode->addNode(towerNode);
 }
+
+//____________________________________________________________________________..
+bool PHG4IHCalSteppingAction::IsInDetector(G4VPhysicalVolume *volume) const
+{
+  return m_Detector->IsInIHCal(volume) != 0;
+}
@@ -391,3 +391,9 @@ void PHG4InttSteppingAction::SetHitNodeName(const std::string& type, const std::
   gSystem->Exit(1);
   return;
 }
+
+//____________________________________________________________________________..
+bool PHG4InttSteppingAction::IsInDetector(G4VPhysicalVolume *volume) const
+{
+  return m_Detector->IsInIntt(volume) != 0;
+}
@@ -11,6 +11,7 @@
 #include <vector>
 
 class G4Step;
+class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4InttDetector;
 class PHG4Hit;
@@ -27,6 +28,9 @@ class PHG4InttSteppingAction : public PHG4SteppingAction
 
   bool UserSteppingAction(const G4Step *, bool) override;
 
+  //! true for volumes handled by this stepping action
+  bool IsInDetector(G4VPhysicalVolume *) const override;
+
   void SetInterfacePointers(PHCompositeNode *) override;
 
   void SetHitNodeName(const std::string &type, const std::string &name) override;
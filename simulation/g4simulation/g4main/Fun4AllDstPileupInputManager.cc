@@ -22,6 +22,8 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE, PHReadOnly, PHRunTree
 
+#include <TROOT.h>
+
 #include <gsl/gsl_randist.h>
 
 #include <cassert>
@@ -38,6 +40,12 @@ Fun4AllDstPileupInputManager::Fun4AllDstPileupInputManager(const std::string &na
   gsl_rng_set(m_rng.get(), seed);
 }
 
+//_____________________________________________________________________________
+Fun4AllDstPileupInputManager::~Fun4AllDstPileupInputManager()
+{
+  stopReader(false);
+}
+
 //_____________________________________________________________________________
 int Fun4AllDstPileupInputManager::fileopen(const std::string &filenam)
 {
@@ -171,6 +179,8 @@ int Fun4AllDstPileupInputManager::run(const int nevents)
   // create merger node
   Fun4AllDstPileupMerger merger;
   merger.copyDetectorActiveCrossings(m_DetectorTiming);
+  merger.set_bulk_merge(m_bulk_merge);
+  merger.set_nthreads(m_merge_nthreads);
   merger.load_nodes(m_dstNode);
 
   // generate background collisions
@@ -184,11 +194,23 @@ int Fun4AllDstPileupInputManager::run(const int nevents)
     const int ncollisions = gsl_ran_poisson(m_rng.get(), mu);
     for (int icollision = 0; icollision < ncollisions; ++icollision)
     {
-      // read one event
-      const auto result = runOne(1);
-      if (result != 0)
+      // read one event, or get it from the pool
+      PHCompositeNode *background = m_dstNodeInternal.get();
+      if (m_pool_size > 0)
+      {
+        background = nextPoolEvent();
+        if (!background)
+        {
+          return -1;
+        }
+      }
+      else
       {
-        return result;
+        const auto result = runOne(1);
+        if (result != 0)
+        {
+          return result;
+        }
       }
 
       // merge
@@ -196,7 +218,7 @@ int Fun4AllDstPileupInputManager::run(const int nevents)
       {
         std::cout << "Fun4AllDstPileupInputManager::run - merged background event " << m_ievent_thisfile << " time: " << crossing_time << std::endl;
       }
-      merger.copy_background_event(m_dstNodeInternal.get(), crossing_time);
+      merger.copy_background_event(background, crossing_time);
     }
   }
 
@@ -211,6 +233,7 @@ int Fun4AllDstPileupInputManager::fileclose()
     std::cout << Name() << ": fileclose: No Input file open" << std::endl;
     return -1;
   }
+  stopReader(false);
   m_IManager.reset();
   IsOpen(0);
   UpdateFileList();
@@ -322,6 +345,8 @@ void Fun4AllDstPileupInputManager::Print(const std::string &what) const
 //_____________________________________________________________________________
 int Fun4AllDstPileupInputManager::PushBackEvents(const int i)
 {
+  // events read ahead of time go back to the file first
+  stopReader(true);
   if (m_IManager)
   {
     unsigned EventOnDst = m_IManager->getEventNumber();
@@ -339,6 +364,9 @@ int Fun4AllDstPileupInputManager::PushBackEvents(const int i)
 //_____________________________________________________________________________
 int Fun4AllDstPileupInputManager::runOne(const int nevents)
 {
+  // events read ahead of time go back to the file first
+  stopReader(true);
+
   if (!IsOpen())
   {
     if (FileListEmpty())
@@ -410,3 +438,199 @@ void Fun4AllDstPileupInputManager::setDetectorActiveCrossings(const std::string
   m_DetectorTiming.insert(std::make_pair(nodename, std::make_pair(m_time_between_crossings * (min + 1), m_time_between_crossings * (max - 1))));
   return;
 }
+
+//_____________________________________________________________________________
+PHCompositeNode *Fun4AllDstPileupInputManager::nextPoolEvent()
+{
+  if (m_pool_reuse)
+  {
+    if (!m_pool_filled)
+    {
+      // fill the pool, moving to the next files if needed
+      while (IsOpen() || (!FileListEmpty() && !OpenNextFile()))
+      {
+        startReader();
+        {
+          std::unique_lock<std::mutex> lock(m_pool_mutex);
+          m_pool_cv.wait(lock, [this]
+                         { return m_reader_done; });
+        }
+        const bool eof = m_reader_eof;
+        stopReader(false);
+        if (!eof || m_pool.size() >= m_pool_size)
+        {
+          break;
+        }
+        fileclose();
+      }
+      m_pool_filled = true;
+
+      if (Verbosity() > 0)
+      {
+        std::cout << "Fun4AllDstPileupInputManager::nextPoolEvent - " << m_pool.size() << " background events in pool" << std::endl;
+      }
+    }
+
+    if (m_pool.empty())
+    {
+      std::cout << Name() << ": no background event in pool" << std::endl;
+      return nullptr;
+    }
+    return m_pool[gsl_rng_uniform_int(m_rng.get(), m_pool.size())].node.get();
+  }
+
+  while (true)
+  {
+    if (!IsOpen())
+    {
+      if (FileListEmpty())
+      {
+        if (Verbosity() > 0)
+        {
+          std::cout << Name() << ": No Input file open" << std::endl;
+        }
+        return nullptr;
+      }
+      if (OpenNextFile())
+      {
+        std::cout << Name() << ": No Input file from filelist opened" << std::endl;
+        return nullptr;
+      }
+    }
+
+    startReader();
+
+    // take the next event, waiting for the reader if needed
+    m_pool_current = PoolEvent();
+    {
+      std::unique_lock<std::mutex> lock(m_pool_mutex);
+      m_pool_cv.wait(lock, [this]
+                     { return !m_pool.empty() || m_reader_done; });
+      if (!m_pool.empty())
+      {
+        m_pool_current = std::move(m_pool.front());
+        m_pool.pop_front();
+      }
+    }
+    m_pool_cv.notify_all();
+
+    if (!m_pool_current.node)
+    {
+      // end of file
+      fileclose();
+      continue;
+    }
+
+    ++m_ievent_total;
+    ++m_ievent_thisfile;
+
+    // check if the local SubsysReco discards this event
+    if (RejectEvent() != Fun4AllReturnCodes::EVENT_OK)
+    {
+      continue;
+    }
+    return m_pool_current.node.get();
+  }
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupInputManager::startReader()
+{
+  if (m_reader.joinable() || !m_IManager)
+  {
+    return;
+  }
+
+  // the reader uses ROOT I/O concurrently with the rest of the job
+  ROOT::EnableThreadSafety();
+
+  m_reader_stop = false;
+  m_reader_done = false;
+  m_reader_eof = false;
+  m_reader = std::thread(&Fun4AllDstPileupInputManager::readerLoop, this);
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupInputManager::stopReader(bool rewind)
+{
+  if (m_reader.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_pool_mutex);
+      m_reader_stop = true;
+    }
+    m_pool_cv.notify_all();
+    m_reader.join();
+  }
+
+  if (!m_pool_reuse)
+  {
+    if (rewind && m_IManager)
+    {
+      if (!m_pool.empty())
+      {
+        m_IManager->setEventNumber(m_pool.front().position);
+      }
+      else if (m_reader_eof)
+      {
+        m_IManager->setEventNumber(m_reader_eof_position);
+      }
+    }
+    m_pool.clear();
+  }
+
+  m_reader_stop = false;
+  m_reader_done = false;
+  m_reader_eof = false;
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupInputManager::readerLoop()
+{
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_pool_mutex);
+      if (!m_pool_reuse)
+      {
+        // wait for room in the pool
+        m_pool_cv.wait(lock, [this]
+                       { return m_reader_stop || m_pool.size() < m_pool_size; });
+      }
+
+      // in reuse mode the reader stops once the pool is full
+      if (m_reader_stop || m_pool.size() >= m_pool_size)
+      {
+        m_reader_done = true;
+        break;
+      }
+    }
+
+    // read next event on internal node
+    const size_t position = m_IManager->getEventNumber();
+    if (!m_IManager->read(m_dstNodeInternal.get()))
+    {
+      std::lock_guard<std::mutex> lock(m_pool_mutex);
+      m_reader_eof = true;
+      m_reader_eof_position = position;
+      m_reader_done = true;
+      break;
+    }
+
+    /*
+     * copy to a new node. Vertex, track and hit ids are renumbered,
+     * but in the same order as in the source, which is all the merger relies on
+     */
+    PoolEvent event;
+    event.position = position;
+    event.node.reset(new PHCompositeNode("DST_POOL"));
+    Fun4AllDstPileupMerger merger;
+    merger.create_nodes(event.node.get(), m_dstNodeInternal.get());
+    merger.copy_background_event(m_dstNodeInternal.get(), 0);
+
+    std::lock_guard<std::mutex> lock(m_pool_mutex);
+    m_pool.push_back(std::move(event));
+    m_pool_cv.notify_all();
+  }
+  m_pool_cv.notify_all();
+}
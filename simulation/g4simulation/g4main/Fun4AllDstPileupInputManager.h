@@ -16,9 +16,14 @@
 
 #include <gsl/gsl_rng.h>
 
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>  // for pair
 
 class SyncObject;
@@ -31,6 +36,7 @@ class Fun4AllDstPileupInputManager : public Fun4AllInputManager
 {
  public:
   Fun4AllDstPileupInputManager(const std::string &name = "DUMMY", const std::string &nodename = "DST", const std::string &topnodename = "TOP");
+  ~Fun4AllDstPileupInputManager() override;
   int fileopen(const std::string &filenam) override;
   int fileclose() override;
   int run(const int nevents = 0) override;
@@ -62,15 +68,73 @@ class Fun4AllDstPileupInputManager : public Fun4AllInputManager
     m_tmin = tmin;
     m_tmax = tmax;
   }
+
+  //! merge the background g4hits in bulk, on nthreads threads (0 for all cores). See Fun4AllDstPileupMerger::set_bulk_merge
+  void setBulkMerge(bool value, unsigned int nthreads = 1)
+  {
+    m_bulk_merge = value;
+    m_merge_nthreads = nthreads;
+  }
   //! for symmetric windows
   void setDetectorActiveCrossings(const std::string &name, const int nbcross);
 
   void setDetectorActiveCrossings(const std::string &name, const int min, const int max);
 
+  /*!
+   * number of background events read ahead of time by a reader thread and kept in memory.
+   * 0 (default) reads the background events when needed.
+   * Events are used in the same order as without the pool, unless reuse is enabled
+   */
+  void setBackgroundPoolSize(unsigned int value)
+  {
+    m_pool_size = value;
+  }
+
+  /*!
+   * reuse the background events of the pool.
+   * the pool is filled once, then each collision uses one of its events, chosen at random.
+   * The choice uses the same random generator as the number of collisions,
+   * so that it is reproducible for a given seed
+   */
+  void setBackgroundPoolReuse(bool value)
+  {
+    m_pool_reuse = value;
+  }
+
  private:
   //! loads one event on internal DST node
   int runOne(const int nevents = 0);
 
+  //!@name background event pool
+  //@{
+
+  //! one background event, copied from the internal DST node
+  struct PoolEvent
+  {
+    //! event number in the file
+    size_t position = 0;
+
+    //! event content
+    std::unique_ptr<PHCompositeNode> node;
+  };
+
+  //! get next background event from the pool. Returns nullptr if there is no more input
+  PHCompositeNode *nextPoolEvent();
+
+  //! start reader thread
+  void startReader();
+
+  /*!
+   * stop reader thread.
+   * unless reuse is enabled, the events not used yet are dropped, and if rewind is true
+   * the file is moved back to the first of them, so that they are read again
+   */
+  void stopReader(bool rewind);
+
+  //! reader thread
+  void readerLoop();
+  //@}
+
   //!@name event counters
   //@{
   bool m_ReadRunTTree = true;
@@ -123,6 +187,41 @@ class Fun4AllDstPileupInputManager : public Fun4AllInputManager
   std::unique_ptr<gsl_rng, Deleter> m_rng;
 
   std::map<std::string, std::pair<double, double>> m_DetectorTiming;
+
+  //! bulk merge of the background g4hits
+  bool m_bulk_merge = false;
+
+  //! number of threads for bulk merge
+  unsigned int m_merge_nthreads = 1;
+
+  //!@name background event pool
+  //@{
+  unsigned int m_pool_size = 0;
+  bool m_pool_reuse = false;
+
+  //! true once the pool has been filled, in reuse mode
+  bool m_pool_filled = false;
+
+  //! events read and not used yet, or all events in reuse mode
+  std::deque<PoolEvent> m_pool;
+
+  //! event being merged, in non reuse mode
+  PoolEvent m_pool_current;
+
+  std::thread m_reader;
+  std::mutex m_pool_mutex;
+  std::condition_variable m_pool_cv;
+
+  //! set by the main thread to stop the reader
+  bool m_reader_stop = false;
+
+  //! set by the reader when it exits
+  bool m_reader_done = false;
+
+  //! set by the reader at end of file, with the event number of the failed read
+  bool m_reader_eof = false;
+  size_t m_reader_eof_position = 0;
+  //@}
 };
 
 #endif /* __Fun4AllDstPileupInputManager_H__ */
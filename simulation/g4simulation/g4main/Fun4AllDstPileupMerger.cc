@@ -26,16 +26,21 @@
 #include <phool/getClass.h>
 
 #include <TObject.h>
+#include <TROOT.h>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #include <HepMC/GenEvent.h>
 #pragma GCC diagnostic pop
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <thread>
 #include <utility>
+#include <vector>
 
 // convenient aliases for deep copying nodes
 namespace
@@ -81,8 +86,113 @@ namespace
     ContainerMap m_containers;
   };
 
+  //! number of hits cloned per task in bulk merge mode
+  constexpr size_t hit_chunk_size = 4096;
+
+  //! run f(i) for i in [0, n) on up to nthreads threads, including the calling one, and wait for completion
+  template <class F>
+  void run_parallel(unsigned int nthreads, size_t n, F &&f)
+  {
+    std::atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+      for (size_t i = next++; i < n; i = next++)
+      {
+        f(i);
+      }
+    };
+
+    nthreads = std::max<size_t>(1, std::min<size_t>(nthreads, n));
+    std::vector<std::thread> threads;
+    threads.reserve(nthreads - 1);
+    for (unsigned int ithread = 1; ithread < nthreads; ++ithread)
+    {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+  }
+
 }  // namespace
 
+/*!
+ * source to destination id conversion, for vertices or tracks.
+ * destination ids are consecutive in the order of the source ids, both for primaries and secondaries,
+ * so that when the source ids have no gap, which is the normal case, the conversion is a constant shift.
+ * Otherwise it falls back to a binary search in the sorted source ids
+ */
+class Fun4AllDstPileupMerger::IdMap
+{
+ public:
+  //! source, destination id pairs
+  using IdList = std::vector<std::pair<int, int>>;
+
+  void set_primary(IdList &&ids) { m_primary.set(std::move(ids)); }
+  void set_secondary(IdList &&ids) { m_secondary.set(std::move(ids)); }
+
+  //! pairs sorted by source id
+  const IdList &primary_ids() const { return m_primary.ids; }
+  const IdList &secondary_ids() const { return m_secondary.ids; }
+
+  //! convert source id. Returns false if not found
+  bool find(int source, int &dest) const
+  {
+    return m_primary.find(source, dest) || m_secondary.find(source, dest);
+  }
+
+ private:
+  class Block
+  {
+   public:
+    void set(IdList &&values)
+    {
+      ids = std::move(values);
+      std::stable_sort(ids.begin(), ids.end(), [](const IdList::value_type &first, const IdList::value_type &second)
+                       { return first.first < second.first; });
+
+      contiguous = true;
+      shift = ids.empty() ? 0 : ids.front().second - ids.front().first;
+      for (size_t i = 0; i < ids.size() && contiguous; ++i)
+      {
+        contiguous = (ids[i].first == ids.front().first + int(i)) && (ids[i].second == ids[i].first + shift);
+      }
+    }
+
+    bool find(int source, int &dest) const
+    {
+      if (ids.empty() || source < ids.front().first || source > ids.back().first)
+      {
+        return false;
+      }
+
+      if (contiguous)
+      {
+        dest = source + shift;
+        return true;
+      }
+
+      const auto iter = std::lower_bound(ids.begin(), ids.end(), source, [](const IdList::value_type &pair, int value)
+                                         { return pair.first < value; });
+      if (iter == ids.end() || iter->first != source)
+      {
+        return false;
+      }
+      dest = iter->second;
+      return true;
+    }
+
+    IdList ids;
+    bool contiguous = true;
+    int shift = 0;
+  };
+
+  Block m_primary;
+  Block m_secondary;
+};
+
 //_____________________________________________________________________________
 void Fun4AllDstPileupMerger::load_nodes(PHCompositeNode *dstNode)
 {
@@ -110,6 +220,42 @@ void Fun4AllDstPileupMerger::load_nodes(PHCompositeNode *dstNode)
   }
 }
 
+//_____________________________________________________________________________
+void Fun4AllDstPileupMerger::create_nodes(PHCompositeNode *dstNode, PHCompositeNode *sourceNode)
+{
+  // hepmc and truth info, only if present in the source, since copy_background_event skips them otherwise
+  if (findNode::getClass<PHHepMCGenEventMap>(sourceNode, "PHHepMCGenEventMap") &&
+      !findNode::getClass<PHHepMCGenEventMap>(dstNode, "PHHepMCGenEventMap"))
+  {
+    dstNode->addNode(new PHIODataNode<PHObject>(new PHHepMCGenEventMap(), "PHHepMCGenEventMap", "PHObject"));
+  }
+
+  if (findNode::getClass<PHG4TruthInfoContainer>(sourceNode, "G4TruthInfo") &&
+      !findNode::getClass<PHG4TruthInfoContainer>(dstNode, "G4TruthInfo"))
+  {
+    dstNode->addNode(new PHIODataNode<PHObject>(new PHG4TruthInfoContainer(), "G4TruthInfo", "PHObject"));
+  }
+
+  // one empty G4Hit container per source container
+  FindG4HitContainer nodeFinder;
+  PHNodeIterator(sourceNode).forEach(nodeFinder);
+  for (const auto &pair : nodeFinder.containers())
+  {
+    if (!findNode::getClass<PHG4HitContainer>(dstNode, pair.first))
+    {
+      dstNode->addNode(new PHIODataNode<PHObject>(new PHG4HitContainer(pair.first), pair.first, "PHObject"));
+    }
+  }
+
+  // load, without creating the nodes missing from the source
+  m_geneventmap = findNode::getClass<PHHepMCGenEventMap>(dstNode, "PHHepMCGenEventMap");
+  m_g4truthinfo = findNode::getClass<PHG4TruthInfoContainer>(dstNode, "G4TruthInfo");
+
+  FindG4HitContainer dstFinder;
+  PHNodeIterator(dstNode).forEach(dstFinder);
+  m_g4hitscontainers = dstFinder.containers();
+}
+
 //_____________________________________________________________________________
 void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, double delta_t) const
 {
@@ -144,10 +290,9 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
   }
 
   // copy truth container
-  // keep track of the correspondance between source index and destination index for vertices, tracks and showers
-  using ConversionMap = std::map<int, int>;
-  ConversionMap vtxid_map;
-  ConversionMap trkid_map;
+  // keep track of the correspondance between source index and destination index for vertices and tracks
+  IdMap vtxid_map;
+  IdMap trkid_map;
 
   const auto container_truth = findNode::getClass<PHG4TruthInfoContainer>(dstNode, "G4TruthInfo");
   if (container_truth && m_g4truthinfo)
@@ -156,6 +301,8 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
       // primary vertices
       auto key = m_g4truthinfo->maxvtxindex();
       const auto range = container_truth->GetPrimaryVtxRange();
+      IdMap::IdList ids;
+      ids.reserve(std::distance(range.first, range.second));
       for (auto iter = range.first; iter != range.second; ++iter)
       {
         // clone vertex, insert in map, and add index conversion
@@ -163,14 +310,17 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
         auto newVertex = new PHG4VtxPoint_t(sourceVertex);
         newVertex->set_t(sourceVertex->get_t() + delta_t);
         m_g4truthinfo->AddVertex(++key, newVertex);
-        vtxid_map.insert(std::make_pair(sourceVertex->get_id(), key));
+        ids.emplace_back(sourceVertex->get_id(), key);
       }
+      vtxid_map.set_primary(std::move(ids));
     }
 
     {
       // secondary vertices
       auto key = m_g4truthinfo->minvtxindex();
       const auto range = container_truth->GetSecondaryVtxRange();
+      IdMap::IdList ids;
+      ids.reserve(std::distance(range.first, range.second));
 
       // loop from last to first to preserve order with respect to the original event
       for (
@@ -183,14 +333,17 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
         auto newVertex = new PHG4VtxPoint_t(sourceVertex);
         newVertex->set_t(sourceVertex->get_t() + delta_t);
         m_g4truthinfo->AddVertex(--key, newVertex);
-        vtxid_map.insert(std::make_pair(sourceVertex->get_id(), key));
+        ids.emplace_back(sourceVertex->get_id(), key);
       }
+      vtxid_map.set_secondary(std::move(ids));
     }
 
     {
       // primary particles
       auto key = m_g4truthinfo->maxtrkindex();
       const auto range = container_truth->GetPrimaryParticleRange();
+      IdMap::IdList ids;
+      ids.reserve(std::distance(range.first, range.second));
       for (auto iter = range.first; iter != range.second; ++iter)
       {
         const auto &source = iter->second;
@@ -205,10 +358,10 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
         dest->set_primary_id(dest->get_track_id());
 
         // update vertex
-        const auto keyiter = vtxid_map.find(source->get_vtx_id());
-        if (keyiter != vtxid_map.end())
+        int vtxid = 0;
+        if (vtxid_map.find(source->get_vtx_id(), vtxid))
         {
-          dest->set_vtx_id(keyiter->second);
+          dest->set_vtx_id(vtxid);
         }
         else
         {
@@ -216,8 +369,9 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
         }
 
         // insert in map
-        trkid_map.insert(std::make_pair(source->get_track_id(), dest->get_track_id()));
+        ids.emplace_back(source->get_track_id(), dest->get_track_id());
       }
+      trkid_map.set_primary(std::move(ids));
     }
 
     {
@@ -225,9 +379,27 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
       auto key = m_g4truthinfo->mintrkindex();
       const auto range = container_truth->GetSecondaryParticleRange();
 
+      /*
+       * the destination ids only depend on the loop order. They are assigned first
+       * so that the parent conversion below does not need to update the map while looping
+       */
+      {
+        IdMap::IdList ids;
+        ids.reserve(std::distance(range.first, range.second));
+        auto newkey = key;
+        for (
+            auto iter = std::reverse_iterator<PHG4TruthInfoContainer::ConstIterator>(range.second);
+            iter != std::reverse_iterator<PHG4TruthInfoContainer::ConstIterator>(range.first);
+            ++iter)
+        {
+          ids.emplace_back(iter->second->get_track_id(), --newkey);
+        }
+        trkid_map.set_secondary(std::move(ids));
+      }
+
       /*
        * loop from last to first to preserve order with respect to the original event
-       * also this ensures that for a given particle its parent has already been converted and thus found in the map
+       * also this ensures that for a given particle its parent has already been converted
        */
       for (
           auto iter = std::reverse_iterator<PHG4TruthInfoContainer::ConstIterator>(range.second);
@@ -240,10 +412,10 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
         dest->set_track_id(key);
 
         // update parent id
-        auto keyiter = trkid_map.find(source->get_parent_id());
-        if (keyiter != trkid_map.end())
+        int trkid = 0;
+        if (trkid_map.find(source->get_parent_id(), trkid))
         {
-          dest->set_parent_id(keyiter->second);
+          dest->set_parent_id(trkid);
         }
         else
         {
@@ -251,10 +423,9 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
         }
 
         // update primary id
-        keyiter = trkid_map.find(source->get_primary_id());
-        if (keyiter != trkid_map.end())
+        if (trkid_map.find(source->get_primary_id(), trkid))
         {
-          dest->set_primary_id(keyiter->second);
+          dest->set_primary_id(trkid);
         }
         else
         {
@@ -262,69 +433,69 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
         }
 
         // update vertex
-        keyiter = vtxid_map.find(source->get_vtx_id());
-        if (keyiter != vtxid_map.end())
+        int vtxid = 0;
+        if (vtxid_map.find(source->get_vtx_id(), vtxid))
         {
-          dest->set_vtx_id(keyiter->second);
+          dest->set_vtx_id(vtxid);
         }
         else
         {
           std::cout << "Fun4AllDstPileupMerger::copy_background_event - vertex id " << source->get_vtx_id() << " not found in map" << std::endl;
         }
-
-        // insert in map
-        trkid_map.insert(std::make_pair(source->get_track_id(), dest->get_track_id()));
       }
     }
 
     // vertex embed flags
     /* embed flag is stored only for primary vertices, consistently with PHG4TruthEventAction */
-    for (const auto &pair : vtxid_map)
+    for (const auto *ids : {&vtxid_map.primary_ids(), &vtxid_map.secondary_ids()})
     {
-      if (pair.first > 0)
+      for (const auto &pair : *ids)
       {
-        m_g4truthinfo->AddEmbededVtxId(pair.second, new_embed_id);
+        if (pair.first > 0)
+        {
+          m_g4truthinfo->AddEmbededVtxId(pair.second, new_embed_id);
+        }
       }
     }
 
     // track embed flags
     /* embed flag is stored only for primary tracks, consistently with PHG4TruthEventAction */
-    for (const auto &pair : trkid_map)
+    for (const auto *ids : {&trkid_map.primary_ids(), &trkid_map.secondary_ids()})
     {
-      if (pair.first > 0)
+      for (const auto &pair : *ids)
       {
-        m_g4truthinfo->AddEmbededTrkId(pair.second, new_embed_id);
+        if (pair.first > 0)
+        {
+          m_g4truthinfo->AddEmbededTrkId(pair.second, new_embed_id);
+        }
       }
     }
   }
 
   // copy g4hits
+  if (m_bulk_merge)
+  {
+    copy_hits_bulk(dstNode, delta_t, trkid_map);
+  }
+  else
+  {
+    copy_hits(dstNode, delta_t, trkid_map);
+  }
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupMerger::copy_hits(PHCompositeNode *dstNode, double delta_t, const IdMap &trkid_map) const
+{
   // loop over registered maps
   for (const auto &pair : m_g4hitscontainers)
   {
-    // check destination node
-    if (!pair.second)
-    {
-      std::cout << "Fun4AllDstPileupMerger::copy_background_event - invalid destination container " << pair.first << std::endl;
-      continue;
-    }
-
     // find source node
-    auto container_hit = findNode::getClass<PHG4HitContainer>(dstNode, pair.first);
+    auto container_hit = source_container(dstNode, pair.first, pair.second, delta_t);
     if (!container_hit)
     {
-      std::cout << "Fun4AllDstPileupMerger::copy_background_event - invalid source container " << pair.first << std::endl;
       continue;
     }
-    auto detiter = m_DetectorTiming.find(pair.first);
-    // apply special  cuts for selected detectors
-    if (detiter != m_DetectorTiming.end())
-    {
-      if (delta_t < detiter->second.first || delta_t > detiter->second.second)
-      {
-        continue;
-      }
-    }
+
     {
       // hits
       const auto range = container_hit->getHits();
@@ -332,29 +503,7 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
       {
         // clone hit
         const auto &sourceHit = iter->second;
-        auto newHit = new PHG4Hit_t(sourceHit);
-
-        // shift time
-        newHit->set_t(0, sourceHit->get_t(0) + delta_t);
-        newHit->set_t(1, sourceHit->get_t(1) + delta_t);
-
-        // update track id
-        const auto keyiter = trkid_map.find(sourceHit->get_trkid());
-        if (keyiter != trkid_map.end())
-        {
-          newHit->set_trkid(keyiter->second);
-        }
-        else
-        {
-          std::cout << "Fun4AllDstPileupMerger::copy_background_event - track id " << sourceHit->get_trkid() << " not found in map" << std::endl;
-        }
-
-        /*
-         * reset shower ids
-         * it was decided that showers from the background events will not be copied to the merged event
-         * as such we just reset the hits shower id
-         */
-        newHit->set_shower_id(std::numeric_limits<int>::min());
+        auto newHit = clone_hit(sourceHit, delta_t, trkid_map);
 
         /*
          * this will generate a new key for the hit and assign it to the hit
@@ -374,3 +523,178 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
     }
   }
 }
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupMerger::copy_hits_bulk(PHCompositeNode *dstNode, double delta_t, const IdMap &trkid_map) const
+{
+  // source and destination hits for one container
+  struct HitBlock
+  {
+    const PHG4HitContainer *source = nullptr;
+    PHG4HitContainer *destination = nullptr;
+    std::vector<const PHG4Hit *> sourceHits;
+    std::vector<PHG4Hit *> newHits;
+  };
+
+  // collect the containers to copy
+  std::vector<HitBlock> blocks;
+  blocks.reserve(m_g4hitscontainers.size());
+  size_t nchunks = 0;
+  for (const auto &pair : m_g4hitscontainers)
+  {
+    auto container_hit = source_container(dstNode, pair.first, pair.second, delta_t);
+    if (!container_hit)
+    {
+      continue;
+    }
+
+    HitBlock block;
+    block.source = container_hit;
+    block.destination = pair.second;
+    block.sourceHits.reserve(container_hit->size());
+    const auto range = container_hit->getHits();
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      block.sourceHits.push_back(iter->second);
+    }
+    block.newHits.resize(block.sourceHits.size(), nullptr);
+    nchunks += (block.sourceHits.size() + hit_chunk_size - 1) / hit_chunk_size;
+    blocks.push_back(std::move(block));
+  }
+
+  unsigned int nthreads = m_nthreads;
+  if (nthreads == 0)
+  {
+    nthreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  if (nthreads > 1)
+  {
+    // hits are created concurrently
+    ROOT::EnableThreadSafety();
+  }
+
+  // clone hits, in chunks of fixed size. Each chunk writes to its own slots of newHits
+  std::vector<std::pair<size_t, size_t>> chunks;
+  chunks.reserve(nchunks);
+  for (size_t iblock = 0; iblock < blocks.size(); ++iblock)
+  {
+    for (size_t first = 0; first < blocks[iblock].sourceHits.size(); first += hit_chunk_size)
+    {
+      chunks.emplace_back(iblock, first);
+    }
+  }
+
+  auto clone_chunk = [&](size_t ichunk)
+  {
+    auto &block = blocks[chunks[ichunk].first];
+    const size_t first = chunks[ichunk].second;
+    const size_t last = std::min(first + hit_chunk_size, block.sourceHits.size());
+    for (size_t i = first; i < last; ++i)
+    {
+      block.newHits[i] = clone_hit(block.sourceHits[i], delta_t, trkid_map, false);
+    }
+  };
+  run_parallel(nthreads, chunks.size(), clone_chunk);
+
+  // assign keys and insert, one destination container per task
+  auto insert_block = [&](size_t iblock)
+  {
+    auto &block = blocks[iblock];
+
+    /*
+     * the serial merge gives each hit the largest key of its detid in the destination container, plus one.
+     * only the first hit of a given detid needs a lookup, the next ones follow
+     */
+    std::map<unsigned int, PHG4HitDefs::keytype> next_keys;
+    for (auto newHit : block.newHits)
+    {
+      const unsigned int detid = newHit->get_detid();
+      auto iter = next_keys.find(detid);
+      if (iter == next_keys.end())
+      {
+        iter = next_keys.insert(std::make_pair(detid, block.destination->genkey(detid))).first;
+      }
+      newHit->set_hit_id(iter->second++);
+    }
+    block.destination->AddHits(block.newHits);
+  };
+  run_parallel(nthreads, blocks.size(), insert_block);
+
+  // messages and layers, in the same order as the serial merge
+  for (const auto &block : blocks)
+  {
+    for (const auto &sourceHit : block.sourceHits)
+    {
+      int trkid = 0;
+      if (!trkid_map.find(sourceHit->get_trkid(), trkid))
+      {
+        std::cout << "Fun4AllDstPileupMerger::copy_background_event - track id " << sourceHit->get_trkid() << " not found in map" << std::endl;
+      }
+    }
+
+    const auto range = block.source->getLayers();
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      block.destination->AddLayer(*iter);
+    }
+  }
+}
+
+//_____________________________________________________________________________
+PHG4HitContainer *Fun4AllDstPileupMerger::source_container(PHCompositeNode *dstNode, const std::string &name, PHG4HitContainer *destination, double delta_t) const
+{
+  // check destination node
+  if (!destination)
+  {
+    std::cout << "Fun4AllDstPileupMerger::copy_background_event - invalid destination container " << name << std::endl;
+    return nullptr;
+  }
+
+  // find source node
+  auto container_hit = findNode::getClass<PHG4HitContainer>(dstNode, name);
+  if (!container_hit)
+  {
+    std::cout << "Fun4AllDstPileupMerger::copy_background_event - invalid source container " << name << std::endl;
+    return nullptr;
+  }
+  auto detiter = m_DetectorTiming.find(name);
+  // apply special  cuts for selected detectors
+  if (detiter != m_DetectorTiming.end())
+  {
+    if (delta_t < detiter->second.first || delta_t > detiter->second.second)
+    {
+      return nullptr;
+    }
+  }
+  return container_hit;
+}
+
+//_____________________________________________________________________________
+PHG4Hit *Fun4AllDstPileupMerger::clone_hit(const PHG4Hit *sourceHit, double delta_t, const IdMap &trkid_map, bool verbose)
+{
+  // clone hit
+  auto newHit = new PHG4Hit_t(sourceHit);
+
+  // shift time
+  newHit->set_t(0, sourceHit->get_t(0) + delta_t);
+  newHit->set_t(1, sourceHit->get_t(1) + delta_t);
+
+  // update track id
+  int trkid = 0;
+  if (trkid_map.find(sourceHit->get_trkid(), trkid))
+  {
+    newHit->set_trkid(trkid);
+  }
+  else if (verbose)
+  {
+    std::cout << "Fun4AllDstPileupMerger::copy_background_event - track id " << sourceHit->get_trkid() << " not found in map" << std::endl;
+  }
+
+  /*
+   * reset shower ids
+   * it was decided that showers from the background events will not be copied to the merged event
+   * as such we just reset the hits shower id
+   */
+  newHit->set_shower_id(std::numeric_limits<int>::min());
+  return newHit;
+}
@@ -13,6 +13,7 @@
 #include <utility>  // for pair
 
 class PHCompositeNode;
+class PHG4Hit;
 class PHG4HitContainer;
 class PHG4TruthInfoContainer;
 class PHHepMCGenEventMap;
@@ -34,12 +35,40 @@ class Fun4AllDstPileupMerger final
   //! load destination nodes from composite
   void load_nodes(PHCompositeNode *);
 
+  //! create destination nodes matching the content of source, then load them. Used to keep copies of background events in memory
+  void create_nodes(PHCompositeNode *, PHCompositeNode *source);
+
   //! time-shift and copy content of source nodes to destination
   void copy_background_event(PHCompositeNode *, double delta_t) const;
 
   void copyDetectorActiveCrossings(const std::map<std::string, std::pair<double, double>> &dmap) { m_DetectorTiming = dmap; }
 
+  /*!
+   * bulk merge mode for the g4hits.
+   * the hits of all containers are cloned in parallel blocks, then inserted with pre-computed keys,
+   * one thread per destination container. The result is identical to the default, hit by hit, merge
+   */
+  void set_bulk_merge(bool value) { m_bulk_merge = value; }
+
+  //! number of threads used in bulk merge mode. 0 means all available cores
+  void set_nthreads(unsigned int value) { m_nthreads = value; }
+
  private:
+  //! source to destination vertex and track id conversion
+  class IdMap;
+
+  //! source hit container matching a destination container. nullptr if missing or outside the detector active crossings
+  PHG4HitContainer *source_container(PHCompositeNode *, const std::string &name, PHG4HitContainer *destination, double delta_t) const;
+
+  //! clone hit, shift time and convert track id
+  static PHG4Hit *clone_hit(const PHG4Hit *, double delta_t, const IdMap &trkid_map, bool verbose = true);
+
+  //! copy hits hit by hit
+  void copy_hits(PHCompositeNode *, double delta_t, const IdMap &trkid_map) const;
+
+  //! copy hits in bulk mode
+  void copy_hits_bulk(PHCompositeNode *, double delta_t, const IdMap &trkid_map) const;
+
   //! hepmc
   PHHepMCGenEventMap *m_geneventmap = nullptr;
 
@@ -50,6 +79,12 @@ class Fun4AllDstPileupMerger final
   PHG4TruthInfoContainer *m_g4truthinfo = nullptr;
 
   std::map<std::string, std::pair<double, double>> m_DetectorTiming;
+
+  //! bulk merge mode
+  bool m_bulk_merge = false;
+
+  //! number of threads in bulk merge mode
+  unsigned int m_nthreads = 1;
 };
 
 #endif
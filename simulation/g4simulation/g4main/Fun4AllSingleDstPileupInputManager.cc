@@ -225,6 +225,8 @@ readagain:
   }
 
   Fun4AllDstPileupMerger merger;
+  merger.set_bulk_merge(m_bulk_merge);
+  merger.set_nthreads(m_merge_nthreads);
   merger.load_nodes(m_dstNode);
 
   // generate background collisions
@@ -62,6 +62,13 @@ class Fun4AllSingleDstPileupInputManager : public Fun4AllInputManager
     m_tmax = tmax;
   }
 
+  //! merge the background g4hits in bulk, on nthreads threads (0 for all cores). See Fun4AllDstPileupMerger::set_bulk_merge
+  void setBulkMerge(bool value, unsigned int nthreads = 1)
+  {
+    m_bulk_merge = value;
+    m_merge_nthreads = nthreads;
+  }
+
  private:
   //!@name event counters
   //@{
@@ -117,6 +124,12 @@ class Fun4AllSingleDstPileupInputManager : public Fun4AllInputManager
   };
 
   std::unique_ptr<gsl_rng, Deleter> m_rng;
+
+  //! bulk merge of the background g4hits
+  bool m_bulk_merge = false;
+
+  //! number of threads for bulk merge
+  unsigned int m_merge_nthreads = 1;
 };
 
 #endif /* __Fun4AllSingleDstPileupInputManager_H__ */
@@ -129,6 +129,25 @@ PHG4HitContainer::AddHit(const unsigned int detid, PHG4Hit *newhit)
   return hitmap.insert(std::make_pair(key, newhit)).first;
 }
 
+void PHG4HitContainer::AddHits(const std::vector<PHG4Hit *> &newhits)
+{
+  Iterator hint = hitmap.end();
+  for (auto newhit : newhits)
+  {
+    PHG4HitDefs::keytype key = newhit->get_hit_id();
+    Iterator it = hitmap.emplace_hint(hint, key, newhit);
+    if (it->second != newhit)
+    {
+      cout << "hit with id  0x" << hex << key << dec << " exists already" << endl;
+      continue;
+    }
+    PHG4HitDefs::keytype detidlong = key >> PHG4HitDefs::hit_idbits;
+    unsigned int detid = detidlong;
+    layers.insert(detid);
+    hint = ++it;
+  }
+}
+
 PHG4HitContainer::ConstRange PHG4HitContainer::getHits(const unsigned int detid) const
 {
   PHG4HitDefs::keytype detidlong = detid;
@@ -12,6 +12,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 class PHG4Hit;
 
@@ -42,6 +43,10 @@ class PHG4HitContainer : public PHObject
 
   ConstIterator AddHit(const unsigned int detid, PHG4Hit *newhit);
 
+  //! add hits whose id is already set, e.g. from genkey.
+  /*! hits are inserted after each other, which is fast when the ids are increasing within a detid */
+  void AddHits(const std::vector<PHG4Hit *> &newhits);
+
   Iterator findOrAddHit(PHG4HitDefs::keytype key);
 
   PHG4Hit *findHit(PHG4HitDefs::keytype key);
@@ -1,6 +1,13 @@
 #include "PHG4PhenixSteppingAction.h"
 #include "PHG4SteppingAction.h"
 
+#include <Geant4/G4PhysicalVolumeStore.hh>
+#include <Geant4/G4Step.hh>
+#include <Geant4/G4StepPoint.hh>
+#include <Geant4/G4TouchableHandle.hh>
+#include <Geant4/G4VPhysicalVolume.hh>
+#include <Geant4/G4VTouchable.hh>
+
 PHG4PhenixSteppingAction::~PHG4PhenixSteppingAction()
 {
   while (actions_.begin() != actions_.end())
@@ -10,16 +17,57 @@ PHG4PhenixSteppingAction::~PHG4PhenixSteppingAction()
   }
 }
 
+//_________________________________________________________________
+void PHG4PhenixSteppingAction::BuildDispatchTable()
+{
+  m_VolumeActions.clear();
+  for (G4VPhysicalVolume* volume : *G4PhysicalVolumeStore::GetInstance())
+  {
+    GetActions(volume);
+  }
+}
+
+//_________________________________________________________________
+const std::vector<PHG4SteppingAction*>& PHG4PhenixSteppingAction::GetActions(G4VPhysicalVolume* volume)
+{
+  auto iter = m_VolumeActions.find(volume);
+  if (iter != m_VolumeActions.end())
+  {
+    return iter->second;
+  }
+
+  // actions which do not know about this volume return false without touching the step, so they can be skipped
+  std::vector<PHG4SteppingAction*>& actions = m_VolumeActions[volume];
+  for (PHG4SteppingAction* action : actions_)
+  {
+    if (action && (!volume || action->IsInDetector(volume)))
+    {
+      actions.push_back(action);
+    }
+  }
+  return actions;
+}
+
 //_________________________________________________________________
 void PHG4PhenixSteppingAction::UserSteppingAction(const G4Step* aStep)
 {
-  // loop over registered actions, and process
+  ++m_StepCount;
   bool hit_was_used = false;
-  for (ActionList::const_iterator iter = actions_.begin(); iter != actions_.end(); ++iter)
+  if (!m_UseDispatchTable)
   {
-    if (*iter)
+    for (PHG4SteppingAction* action : actions_)
     {
-      hit_was_used |= (*iter)->UserSteppingAction(aStep, hit_was_used);
+      if (action)
+      {
+        hit_was_used |= action->UserSteppingAction(aStep, hit_was_used);
+      }
     }
+    return;
+  }
+
+  // loop over the actions registered for the volume of this step, and process
+  for (PHG4SteppingAction* action : GetActions(aStep->GetPreStepPoint()->GetTouchableHandle()->GetVolume()))
+  {
+    hit_was_used |= action->UserSteppingAction(aStep, hit_was_used);
   }
 }
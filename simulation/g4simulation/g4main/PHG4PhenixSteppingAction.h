@@ -4,9 +4,13 @@
 #define G4MAIN_PHG4PHENIXSTEPPINGACTION_H
 
 #include <Geant4/G4UserSteppingAction.hh>
+
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 class G4Step;
+class G4VPhysicalVolume;
 class PHG4SteppingAction;
 
 class PHG4PhenixSteppingAction : public G4UserSteppingAction
@@ -24,15 +28,34 @@ class PHG4PhenixSteppingAction : public G4UserSteppingAction
     if (action)
     {
       actions_.push_back(action);
+      m_VolumeActions.clear();
     }
   }
 
+  //! build the volume to stepping actions table for all volumes in the geometry. Called in PHG4Reco::InitRun once the geometry is constructed
+  void BuildDispatchTable();
+
+  //! false calls every action on every step, as before the dispatch table existed. Used to benchmark the dispatch
+  void UseDispatchTable(const bool b) { m_UseDispatchTable = b; }
+
+  //! number of steps processed so far
+  unsigned long StepCount() const { return m_StepCount; }
+
   void UserSteppingAction(const G4Step*) override;
 
  private:
+  //! stepping actions which want steps in this volume, in registration order. Volumes not found in the table are added on first use
+  const std::vector<PHG4SteppingAction*>& GetActions(G4VPhysicalVolume* volume);
+
   //! list of subsystem specific stepping actions
   typedef std::list<PHG4SteppingAction*> ActionList;
   ActionList actions_;
+
+  //! stepping actions for each physical volume
+  std::unordered_map<G4VPhysicalVolume*, std::vector<PHG4SteppingAction*>> m_VolumeActions;
+
+  bool m_UseDispatchTable = true;
+  unsigned long m_StepCount = 0;
 };
 
 #endif
@@ -444,6 +444,7 @@ int PHG4Reco::InitRun(PHCompositeNode *topNode)
 
   // create main stepping action, add subsystems and register to GEANT
   m_SteppingAction = new PHG4PhenixSteppingAction();
+  m_SteppingAction->UseDispatchTable(m_UseSteppingDispatchTable);
   for (PHG4Subsystem *g4sub : m_SubsystemList)
   {
     PHG4SteppingAction *action = g4sub->GetSteppingAction();
@@ -488,6 +489,9 @@ int PHG4Reco::InitRun(PHCompositeNode *topNode)
   // initialize
   m_RunManager->Initialize();
 
+  // geometry is constructed, map each volume to the stepping actions which handle it
+  m_SteppingAction->BuildDispatchTable();
+
 #if G4VERSION_NUMBER >= 1033
   G4EmSaturation *emSaturation = G4LossTableManager::Instance()->EmSaturation();
   if (!emSaturation)
@@ -717,6 +721,11 @@ int PHG4Reco::process_event(PHCompositeNode *topNode)
   return 0;
 }
 
+unsigned long PHG4Reco::StepCount() const
+{
+  return m_SteppingAction ? m_SteppingAction->StepCount() : 0;
+}
+
 int PHG4Reco::ResetEvent(PHCompositeNode *topNode)
 {
   for (SubsysReco *reco : m_SubsystemList)
@@ -138,6 +138,12 @@ class PHG4Reco : public SubsysReco
 
   //! disable event/track/stepping actions to reduce resource consumption for G4 running only. E.g. dose analysis
   void setDisableUserActions(bool b = true) { m_disableUserActions = b; }
+
+  //! false calls every stepping action on every step instead of only the ones of the step volume. For benchmarking
+  void UseSteppingDispatchTable(const bool b) { m_UseSteppingDispatchTable = b; }
+
+  //! number of G4 steps processed so far
+  unsigned long StepCount() const;
   void ApplyDisplayAction();
 
   void CustomizeEvtGenDecay(const std::string &DecayFile)
@@ -220,6 +226,7 @@ class PHG4Reco : public SubsysReco
 
   bool m_SaveDstGeometryFlag = true;
   bool m_disableUserActions = false;
+  bool m_UseSteppingDispatchTable = true;
 };
 
 #endif
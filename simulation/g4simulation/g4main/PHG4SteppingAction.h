@@ -7,6 +7,7 @@
 #include <string>
 
 class G4Step;
+class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4Hit;
 
@@ -26,6 +27,14 @@ class PHG4SteppingAction
   */
   virtual bool UserSteppingAction(const G4Step* step, bool was_used) = 0;
 
+  //! true if this stepping action needs to see steps whose pre-step point is in this volume
+  /*!
+  PHG4PhenixSteppingAction only calls UserSteppingAction for steps in volumes where this returns true.
+  The default is true for all volumes, so that stepping actions which act outside of their own detector keep working.
+  Override it only if UserSteppingAction returns false without doing anything for all other volumes
+  */
+  virtual bool IsInDetector(G4VPhysicalVolume* /*volume*/) const { return true; }
+
   virtual void Verbosity(const int i) { m_Verbosity = i; }
   virtual int Verbosity() const { return m_Verbosity; }
   virtual int Init() { return 0; }
@@ -337,3 +337,9 @@ void PHG4MicromegasSteppingAction::SetHitNodeName(const std::string &type, const
   gSystem->Exit(1);
   return;
 }
+
+//____________________________________________________________________________..
+bool PHG4MicromegasSteppingAction::IsInDetector(G4VPhysicalVolume* volume) const
+{
+  return m_Detector->IsInDetector(volume) != 0;
+}
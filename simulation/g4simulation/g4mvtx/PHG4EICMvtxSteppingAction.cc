@@ -474,3 +474,9 @@ void PHG4EICMvtxSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
     }
   }
 }
+
+//____________________________________________________________________________..
+bool PHG4EICMvtxSteppingAction::IsInDetector(G4VPhysicalVolume *volume) const
+{
+  return m_Detector->IsSensor(volume) != 0;
+}
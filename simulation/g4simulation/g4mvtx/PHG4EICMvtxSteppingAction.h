@@ -6,6 +6,7 @@
 #include <g4main/PHG4SteppingAction.h>
 
 class G4Step;
+class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4EICMvtxDetector;
 class PHG4Hit;
@@ -24,6 +25,9 @@ class PHG4EICMvtxSteppingAction : public PHG4SteppingAction
   //! stepping action
   bool UserSteppingAction(const G4Step *, bool) override;
 
+  //! true for volumes handled by this stepping action
+  bool IsInDetector(G4VPhysicalVolume *) const override;
+
   //! reimplemented from base class
   void SetInterfacePointers(PHCompositeNode *) override;
 
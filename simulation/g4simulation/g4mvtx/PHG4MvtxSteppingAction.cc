@@ -529,3 +529,9 @@ void PHG4MvtxSteppingAction::SetHitNodeName(const std::string& type, const std::
   gSystem->Exit(1);
   return;
 }
+
+//____________________________________________________________________________..
+bool PHG4MvtxSteppingAction::IsInDetector(G4VPhysicalVolume *volume) const
+{
+  return m_Detector->IsSensor(volume) != 0;
+}
@@ -775,3 +775,9 @@ void PHG4OHCalSteppingAction::CreateNodeTree(PHCompositeNode* topNode)
   PHIODataNode<PHObject>* towerNode = new PHIODataNode<PHObject>(m_CaloInfoContainer, "TOWERINFO_SIM_" + m_Detector->SuperDetector(), "PHObject");
   DetNode->addNode(towerNode);
 }
+
+//____________________________________________________________________________..
+bool PHG4OHCalSteppingAction::IsInDetector(G4VPhysicalVolume *volume) const
+{
+  return m_Detector->IsInOHCal(volume) != 0;
+}
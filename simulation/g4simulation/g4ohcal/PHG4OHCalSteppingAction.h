@@ -30,6 +30,9 @@ class PHG4OHCalSteppingAction : public PHG4SteppingAction
   //! stepping action
   bool UserSteppingAction(const G4Step *, bool) override;
 
+  //! true for volumes handled by this stepping action
+  bool IsInDetector(G4VPhysicalVolume *) const override;
+
   int InitWithNode(PHCompositeNode *topNode) override;
 
   //! reimplemented from base class
@@ -339,3 +339,9 @@ void PHG4TpcEndCapSteppingAction::SetHitNodeName(const std::string &type, const
   gSystem->Exit(1);
   return;
 }
+
+//____________________________________________________________________________..
+bool PHG4TpcEndCapSteppingAction::IsInDetector(G4VPhysicalVolume* volume) const
+{
+  return m_Detector->IsInDetector(volume) != 0;
+}
@@ -353,3 +353,9 @@ void PHG4TpcSteppingAction::SetHitNodeName(const std::string& type, const std::s
   gSystem->Exit(1);
   return;
 }
+
+//____________________________________________________________________________..
+bool PHG4TpcSteppingAction::IsInDetector(G4VPhysicalVolume *volume) const
+{
+  return m_Detector->IsInTpc(volume) != 0;
+}